@@ -36,19 +36,28 @@
 // clang-format on
 
 #include "src/window/MainWindow.h"
+#include "src/headless/HeadlessRenderer.h"
+#include "src/headless/PngSequenceWriter.h"
+#include "src/headless/Y4mWriter.h"
 #include "src/settings/SettingsManager.h"
 #include "src/window/util/file-operations.h"
 #include <QApplication>
+#include <QCommandLineParser>
 #include <QCoreApplication>
+#include <QGuiApplication>
 #include <QSettings>
 #include <QMessageBox>
 #include <QFileDialog>
 #include <QDir>
 #include <QSurfaceFormat>
+#include <cstring>
+#include <file-parser.h>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <optional>
 #include <project.h>
+#include <trace.h>
 #include <QDebug>
 
 // Signals to Qt that titles beginning with ampersands (&)
@@ -157,7 +166,148 @@ std::optional<QFileInfo> autodetectResourceDir() {
   return {};
 }
 
+/**
+ * Check for the `--headless` flag.
+ * Necessary before the application object is constructed,
+ * since headless runs must not create a QApplication
+ *
+ * @return
+ * True if `--headless` was passed
+ */
+bool isHeadless(int argc, char *argv[]) {
+  for (auto i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--headless") == 0)
+      return true;
+  }
+  return false;
+}
+
+/**
+ * Find the value of the `--trace` option.
+ * Necessary before the application object is constructed,
+ * so the startup may be traced as well
+ *
+ * @return
+ * The path following `--trace`, unset if `--trace` was not passed
+ */
+std::optional<std::string> tracePath(int argc, char *argv[]) {
+  for (auto i = 1; i + 1 < argc; i++) {
+    if (std::strcmp(argv[i], "--trace") == 0)
+      return {argv[i + 1]};
+  }
+  return {};
+}
+
+/**
+ * Render a scenario to a PNG sequence or Y4M video without any windows.
+ * Reports all errors on stderr, never with dialogs
+ *
+ * @param application
+ * The running application, for the command line arguments
+ *
+ * @param settings
+ * The application settings, for the resource directory & default time step
+ *
+ * @return
+ * The exit code for the process
+ */
+int runHeadless(const QCoreApplication &application, netsimulyzer::SettingsManager &settings) {
+  using Key = netsimulyzer::SettingsManager::Key;
+
+  QCommandLineParser arguments;
+  arguments.setApplicationDescription("Render a scenario to images or video without a display");
+  arguments.addHelpOption();
+  arguments.addPositionalArgument("scenario", "The scenario file to render");
+  arguments.addOptions({
+      {"headless", "Render without opening any windows"},
+      {{"o", "output"}, "Directory for PNG frames, or the .y4m file to write", "path"},
+      {"format", "Output format, 'png' or 'y4m'. Default: 'y4m' if the output ends in .y4m, 'png' otherwise",
+       "format"},
+      {"size", "Size of each frame. Default: 1280x720", "WIDTHxHEIGHT", "1280x720"},
+      {"time-step", "Simulation time between frames. Default: the scenario's time step", "milliseconds"},
+      {"fps", "Frame rate recorded in Y4M files. Default: 60", "fps", "60"},
+      {"resources", "The 'resources' directory. Default: the configured directory", "path"},
+      {"trace", "Record where time is spent, and write it as a Chrome trace on exit", "path"},
+  });
+  arguments.process(application);
+
+  const auto positional = arguments.positionalArguments();
+  if (positional.size() != 1 || !arguments.isSet("output")) {
+    std::cerr << "A scenario file & --output are required for --headless\n";
+    return 1;
+  }
+
+  const auto size = arguments.value("size").split('x');
+  const auto width = size.size() == 2 ? size[0].toInt() : 0;
+  const auto height = size.size() == 2 ? size[1].toInt() : 0;
+  if (width <= 0 || height <= 0) {
+    std::cerr << "Invalid --size: " << arguments.value("size").toStdString() << '\n';
+    return 1;
+  }
+
+  QString resourcePath;
+  if (arguments.isSet("resources"))
+    resourcePath = arguments.value("resources");
+  else if (settings.isDefined(Key::ResourcePath) && validateResourceDir(*settings.get<QString>(Key::ResourcePath)))
+    resourcePath = *settings.get<QString>(Key::ResourcePath);
+  else if (const auto detected = autodetectResourceDir())
+    resourcePath = detected->absoluteFilePath();
+
+  if (!validateResourceDir(resourcePath)) {
+    std::cerr << "No valid 'resources' directory found, set one with --resources\n";
+    return 1;
+  }
+
+  parser::FileParser fileParser;
+  const auto parseError = fileParser.parse(positional[0].toStdString().c_str());
+  if (parseError) {
+    std::cerr << "Failed to load: " << positional[0].toStdString() << ": " << parseError->message << " at offset "
+              << parseError->offset << '\n';
+    return 1;
+  }
+
+  auto timeStep = fileParser.getConfiguration().timeStep.value_or(
+      settings.get<parser::nanoseconds>(Key::PlaybackTimeStepPreference).value());
+  if (arguments.isSet("time-step"))
+    timeStep = static_cast<parser::nanoseconds>(arguments.value("time-step").toDouble() * 1'000'000.0);
+
+  if (timeStep <= 0LL) {
+    std::cerr << "The time step must be positive\n";
+    return 1;
+  }
+
+  const auto output = arguments.value("output");
+  auto format = output.endsWith(".y4m", Qt::CaseInsensitive) ? QString{"y4m"} : QString{"png"};
+  if (arguments.isSet("format"))
+    format = arguments.value("format").toLower();
+
+  std::unique_ptr<netsimulyzer::FrameWriter> writer;
+  if (format == "png") {
+    if (!QDir{}.mkpath(output)) {
+      std::cerr << "Failed to create output directory: " << output.toStdString() << '\n';
+      return 1;
+    }
+    writer = std::make_unique<netsimulyzer::PngSequenceWriter>(QDir{output});
+  } else if (format == "y4m")
+    writer = std::make_unique<netsimulyzer::Y4mWriter>(output, width, height, arguments.value("fps").toInt());
+  else {
+    std::cerr << "Unknown --format: " << format.toStdString() << '\n';
+    return 1;
+  }
+
+  netsimulyzer::HeadlessRenderer renderer{width, height, resourcePath};
+  if (!renderer.initialize())
+    return 1;
+
+  renderer.load(fileParser);
+  return renderer.render(timeStep, *writer) ? 0 : 1;
+}
+
 int main(int argc, char *argv[]) {
+  const auto traceFile = tracePath(argc, argv);
+  if (traceFile)
+    trace::setEnabled(true);
+
   // Necessary for QSettings to save information
   // Setting these here will save us
   // rewriting them every time we construct
@@ -210,6 +360,15 @@ int main(int argc, char *argv[]) {
 #endif
   QSurfaceFormat::setDefaultFormat(format);
 
+  if (isHeadless(argc, argv)) {
+    QGuiApplication application(argc, argv);
+    const auto result = runHeadless(application, settings);
+
+    if (traceFile)
+      trace::writeChromeTrace(*traceFile);
+    return result;
+  }
+
   // Default QSurfaceFormat must be set before QApplication
   // on some platforms
   QApplication application(argc, argv);
@@ -266,5 +425,9 @@ int main(int argc, char *argv[]) {
   }
   netsimulyzer::MainWindow mainWindow;
   mainWindow.show();
-  return QApplication::exec();
+  const auto result = QApplication::exec();
+
+  if (traceFile)
+    trace::writeChromeTrace(*traceFile);
+  return result;
 }
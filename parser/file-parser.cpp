@@ -38,10 +38,12 @@
 #include <memory>
 #include <rapidjson/filereadstream.h>
 #include <rapidjson/reader.h>
+#include <trace.h>
 
 namespace parser {
 
 std::optional<ParseError> FileParser::parse(const char *path) {
+  NETSIMULYZER_TRACE_SCOPE("FileParser::parse");
 
   // RapidJSON prefers FILE*, so this is a safe wrapper for that
   // Add a 'b' in the mode flags to keep Windows from stupid handling of newlines
@@ -38,6 +38,7 @@
 #include <cmath>
 #include <exception>
 #include <sstream>
+#include <trace.h>
 
 using int_type = util::json::JsonValue::int_type;
 using unsigned_int_type = util::json::JsonValue::unsigned_int_type;
@@ -246,6 +247,31 @@ constexpr JsonHandler::Section JsonHandler::isSection(std::string_view key) {
     return Section::None;
 }
 
+const char *JsonHandler::sectionName(JsonHandler::Section section) {
+  switch (section) {
+  case Section::Areas:
+    return "JsonHandler: areas";
+  case Section::Buildings:
+    return "JsonHandler: buildings";
+  case Section::Configuration:
+    return "JsonHandler: configuration";
+  case Section::Decorations:
+    return "JsonHandler: decorations";
+  case Section::Events:
+    return "JsonHandler: events";
+  case Section::Links:
+    return "JsonHandler: links";
+  case Section::Nodes:
+    return "JsonHandler: nodes";
+  case Section::Series:
+    return "JsonHandler: series";
+  case Section::Streams:
+    return "JsonHandler: streams";
+  default:
+    return "JsonHandler: unknown";
+  }
+}
+
 void JsonHandler::do_parse(JsonHandler::Section section, const util::json::JsonObject &object) {
   switch (section) {
   case Section::Areas:
@@ -984,6 +1010,7 @@ bool JsonHandler::EndObject(rapidjson::SizeType) {
 
   if (jsonStack.empty()) {
     assert(oldTop.key == "root");
+    sectionScope.reset();
     return true;
   }
 
@@ -1072,9 +1099,15 @@ bool JsonHandler::Key(const char *value, rapidjson::SizeType length, bool) {
   // ----------------
   if (jsonStack.size() != 2u)
     return true;
+
+  // Sections are spread over many callbacks,
+  // so their spans last until the next top level key
+  sectionScope.reset();
+
   auto possibleSection = isSection(value);
   if (possibleSection != Section::None) {
     currentSection = possibleSection;
+    sectionScope.emplace(sectionName(possibleSection));
   }
   return true;
 }
@@ -43,6 +43,7 @@
 #include <rapidjson/reader.h>
 #include <stack>
 #include <string>
+#include <trace.h>
 #include <unordered_map>
 #include <vector>
 
@@ -73,11 +74,28 @@ class JsonHandler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, JsonH
    */
   static constexpr Section isSection(std::string_view key);
 
+  /**
+   * Name of a section, for tracing
+   *
+   * @param section
+   * The section to name
+   *
+   * @return
+   * A string literal with the section's name
+   */
+  static const char *sectionName(Section section);
+
   /**
    * The current section we're in the document.
    */
   Section currentSection = Section::None;
 
+  /**
+   * Times `currentSection`. Recorded as a single complete span once reset,
+   * so toggling tracing while a file loads never leaves a span unbalanced
+   */
+  std::optional<trace::Scope> sectionScope;
+
   /**
    * A frame for the JSON stack
    */
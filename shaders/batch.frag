@@ -0,0 +1,9 @@
+#version 330
+
+in vec3 vertex_color;
+
+out vec4 final_color;
+
+void main() {
+    final_color = vec4(vertex_color, 1.0f); // Our blending method discards alpha
+}
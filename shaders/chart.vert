@@ -0,0 +1,9 @@
+#version 330
+
+layout (location = 0) in vec2 in_position;
+
+uniform mat4 transform;
+
+void main() {
+    gl_Position = transform * vec4(in_position, 0.0, 1.0);
+}
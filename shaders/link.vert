@@ -0,0 +1,13 @@
+#version 330
+
+// Center of every Node, indexed by the link's index buffer
+uniform samplerBuffer node_positions;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+void main() {
+    // For indexed draws `gl_VertexID` is the value from the index buffer
+    vec3 position = texelFetch(node_positions, gl_VertexID).xyz;
+    gl_Position = projection * view * vec4(position, 1.0);
+}
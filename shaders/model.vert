@@ -1,7 +1,9 @@
 #version 330
 
 layout (location = 0) in vec3 in_position;
+// Packed as 10:10:10:2 signed normalized, see `PackedVertex`
 layout (location = 1) in vec3 in_normal;
+// Packed as half floats
 layout (location = 2) in vec2 in_texture;
 
 out vec2 texture_coordinates;
@@ -11,11 +13,13 @@ out vec3 fragment_position;
 uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
+// Scales the packed coordinates, so large repeats (e.g. the floor) need not fit in a half float
+uniform float texture_repeat = 1.0;
 
 void main()
 {
     gl_Position = projection * view * model * vec4(in_position, 1.0);
-    texture_coordinates = in_texture;
+    texture_coordinates = in_texture * texture_repeat;
 
     // Only nessary if we allow non-uniform scaling
     mat3 Nonuniform_scale_model = mat3(transpose(inverse(model)));
@@ -0,0 +1,18 @@
+#version 330
+
+layout (location = 0) in vec3 in_position;
+
+// Per instance
+layout (location = 3) in vec3 instance_center;
+layout (location = 4) in float instance_radius;
+layout (location = 5) in vec3 instance_color;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec3 vertex_color;
+
+void main() {
+    vertex_color = instance_color;
+    gl_Position = projection * view * vec4(instance_center + in_position * instance_radius, 1.0);
+}
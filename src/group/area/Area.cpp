@@ -37,12 +37,21 @@
 
 namespace netsimulyzer {
 
-Area::Area(Area::RenderInfo renderInfo, parser::Area model) : renderInfo(renderInfo), model(std::move(model)) {
-  this->renderInfo.fillColor = toRenderColor(this->model.fillColor);
+Area::Area(parser::Area model)
+    : model(std::move(model)), fillColor(toRenderColor(this->model.fillColor)),
+      borderColor(toRenderColor(this->model.borderColor)) {
 }
 
-const Area::RenderInfo &Area::getRenderInfo() const {
-  return renderInfo;
+const parser::Area &Area::getModel() const {
+  return model;
+}
+
+const glm::vec3 &Area::getFillColor() const {
+  return fillColor;
+}
+
+const glm::vec3 &Area::getBorderColor() const {
+  return borderColor;
 }
 
 } // namespace netsimulyzer
@@ -38,30 +38,22 @@
 
 namespace netsimulyzer {
 
+/**
+ * The geometry for all areas is held in
+ * a shared batch built by the Renderer,
+ * see `Renderer::allocateAreas()`
+ */
 class Area {
-public:
-  struct RenderInfo {
-    bool renderBorder = true;
-    unsigned int borderVao = 0u;
-    unsigned int borderVbo = 0u;
-    unsigned int borderVbo_size = 0u;
-    glm::vec3 borderColor;
-
-    bool renderFill = true;
-    unsigned int fillVao = 0u;
-    unsigned int fillVbo = 0u;
-    unsigned int fillVbo_size = 0u;
-    glm::vec3 fillColor;
-  };
-
-private:
-  RenderInfo renderInfo;
   parser::Area model;
+  glm::vec3 fillColor;
+  glm::vec3 borderColor;
 
 public:
-  Area(RenderInfo renderInfo, parser::Area model);
+  explicit Area(parser::Area model);
 
-  [[nodiscard]] const RenderInfo &getRenderInfo() const;
+  [[nodiscard]] const parser::Area &getModel() const;
+  [[nodiscard]] const glm::vec3 &getFillColor() const;
+  [[nodiscard]] const glm::vec3 &getBorderColor() const;
 };
 
 } // namespace netsimulyzer
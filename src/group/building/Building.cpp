@@ -35,12 +35,11 @@
 
 namespace netsimulyzer {
 
-Building::Building(const Building::RenderInfo &renderInfo, const parser::Building &model)
-    : renderInfo(renderInfo), color(toRenderColor(model.color)), model(model) {
+Building::Building(const parser::Building &model) : color(toRenderColor(model.color)), model(model) {
 }
 
-const Building::RenderInfo &Building::getRenderInfo() const {
-  return renderInfo;
+const parser::Building &Building::getModel() const {
+  return model;
 }
 
 const glm::vec3 &Building::getColor() const {
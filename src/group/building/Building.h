@@ -33,37 +33,24 @@
 
 #pragma once
 
-#include "../../render/shader/Shader.h"
-#include <QOpenGLFunctions_4_5_Core>
-#include <array>
 #include <glm/glm.hpp>
 #include <model.h>
 
 namespace netsimulyzer {
 
+/**
+ * The geometry for all buildings is held in
+ * shared batches built by the Renderer,
+ * see `Renderer::allocateBuildings()`
+ */
 class Building {
-public:
-  struct RenderInfo {
-    unsigned int vao = 0u;
-    unsigned int vbo = 0u;
-    unsigned int ibo = 0u;
-    unsigned int ibo_size = 0u;
-
-    unsigned int lineVao = 0u;
-    unsigned int lineVbo = 0u;
-    unsigned int lineIbo = 0u;
-    unsigned int lineIboSize = 0u;
-  };
-
-private:
-  RenderInfo renderInfo;
   glm::vec3 color;
   parser::Building model;
 
 public:
-  Building(const Building::RenderInfo &renderInfo, const parser::Building &model);
+  explicit Building(const parser::Building &model);
 
-  [[nodiscard]] const Building::RenderInfo &getRenderInfo() const;
+  [[nodiscard]] const parser::Building &getModel() const;
 
   [[nodiscard]] const glm::vec3 &getColor() const;
   void setColor(const glm::vec3 &value);
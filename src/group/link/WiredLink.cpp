@@ -32,58 +32,16 @@
  */
 
 #include "WiredLink.h"
-#include <glm/gtc/type_ptr.hpp>
 #include <utility>
 
-WiredLink::WiredLink(const WiredLink::RenderInfo &renderInfo, parser::WiredLink model)
-    : renderInfo(renderInfo), model(std::move(model)) {
-  initializeOpenGLFunctions();
+WiredLink::WiredLink(parser::WiredLink model, std::vector<int> positionIndices)
+    : model(std::move(model)), positionIndices(std::move(positionIndices)) {
 }
 
-WiredLink::~WiredLink() {
-  glDeleteBuffers(1, &renderInfo.vbo);
-  glDeleteVertexArrays(1, &renderInfo.vao);
+const parser::WiredLink &WiredLink::getModel() const {
+  return model;
 }
 
-void WiredLink::notifyNodeMoved(unsigned int nodeId, glm::vec3 position) {
-  std::size_t nodeIndex = 0u;
-  for (auto i = 0u; i < model.nodes.size(); i++) {
-    if (model.nodes[i] == nodeId)
-      nodeIndex = i;
-  }
-
-  glBindBuffer(GL_ARRAY_BUFFER, renderInfo.vbo);
-  glBufferSubData(GL_ARRAY_BUFFER, sizeof(float) * 3 * nodeIndex, sizeof(float) * 3,
-                  reinterpret_cast<void *>(glm::value_ptr(position)));
-}
-
-WiredLink::WiredLink(WiredLink &&other) noexcept {
-  renderInfo = other.renderInfo;
-  model = other.model;
-
-  // Clear the other RenderInfo so the destructor
-  // doesn't delete the OpenGL buffers
-  other.renderInfo.vao = 0;
-  other.renderInfo.vbo = 0;
-  other.renderInfo.size = 0;
-
-  initializeOpenGLFunctions();
-}
-
-WiredLink &WiredLink::operator=(WiredLink &&other) noexcept {
-  renderInfo = other.renderInfo;
-  model = other.model;
-
-  // Clear the other RenderInfo so the destructor
-  // doesn't delete the OpenGL buffers
-  other.renderInfo.vao = 0;
-  other.renderInfo.vbo = 0;
-  other.renderInfo.size = 0;
-
-  initializeOpenGLFunctions();
-  return *this;
-}
-
-const WiredLink::RenderInfo &WiredLink::getRenderInfo() const {
-  return renderInfo;
+const std::vector<int> &WiredLink::getPositionIndices() const {
+  return positionIndices;
 }
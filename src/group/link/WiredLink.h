@@ -33,29 +33,29 @@
 
 #pragma once
 
-#include <QOpenGLFunctions_3_3_Core>
-#include <glm/vec3.hpp>
 #include <model.h>
+#include <vector>
 
-class WiredLink : protected QOpenGLFunctions_3_3_Core {
-public:
-  struct RenderInfo {
-    unsigned int vao = 0u;
-    unsigned int vbo = 0u;
-    int size = 0;
-  };
-
-private:
-  RenderInfo renderInfo;
+/**
+ * A wire between Nodes.
+ *
+ * Links hold no OpenGL resources of their own,
+ * all links are drawn from a single batch built by
+ * `Renderer::allocateWiredLinks()`, with endpoints
+ * read from the `NodePositionBuffer`
+ */
+class WiredLink {
   parser::WiredLink model;
 
+  /**
+   * Index of each Node in `model.nodes`
+   * in the `NodePositionBuffer`
+   */
+  std::vector<int> positionIndices;
+
 public:
-  WiredLink(const RenderInfo &renderInfo, parser::WiredLink model);
-  ~WiredLink() override;
-  WiredLink(const WiredLink &) = delete;
-  WiredLink(WiredLink &&other) noexcept;
-  WiredLink& operator=(WiredLink &&other) noexcept;
+  WiredLink(parser::WiredLink model, std::vector<int> positionIndices);
 
-  void notifyNodeMoved(unsigned int nodeId, glm::vec3 position);
-  [[nodiscard]] const RenderInfo &getRenderInfo() const;
+  [[nodiscard]] const parser::WiredLink &getModel() const;
+  [[nodiscard]] const std::vector<int> &getPositionIndices() const;
 };
@@ -72,6 +72,7 @@ Node::Node(const Model &model, parser::Node ns3Node, TrailBuffer &&trailBuffer)
     this->model.setHighlightColor(toRenderColor(ns3Node.highlightColor.value()));
 
   trailColor = toRenderColor(ns3Node.trailColor);
+  this->trailBuffer.setColor(trailColor);
 }
 
 const Model &Node::getModel() const {
@@ -100,9 +101,19 @@ const Node::TransmitInfo &Node::getTransmitInfo() const {
   return transmitInfo;
 }
 
-void Node::addWiredLink(WiredLink *link) {
-  wiredLinks.emplace_back(link);
-  link->notifyNodeMoved(ns3Node.id, getCenter());
+void Node::updatePositionBuffer() {
+  if (positionBuffer)
+    positionBuffer->set(positionIndex, getCenter());
+}
+
+void Node::setPositionBuffer(NodePositionBuffer &buffer, int index) {
+  positionBuffer = &buffer;
+  positionIndex = index;
+  updatePositionBuffer();
+}
+
+int Node::getPositionIndex() const {
+  return positionIndex;
 }
 
 undo::MoveEvent Node::handle(const parser::MoveEvent &e) {
@@ -119,9 +130,7 @@ undo::MoveEvent Node::handle(const parser::MoveEvent &e) {
   model.setPosition(target);
   trailBuffer.append(target.x, target.y, target.z);
 
-  for (auto link : wiredLinks) {
-    link->notifyNodeMoved(ns3Node.id, getCenter());
-  }
+  updatePositionBuffer();
 
   return undo;
 }
@@ -165,9 +174,7 @@ void Node::handle(const undo::MoveEvent &e) {
 
   trailBuffer.pop();
 
-  for (auto link : wiredLinks) {
-    link->notifyNodeMoved(ns3Node.id, getCenter());
-  }
+  updatePositionBuffer();
 }
 
 undo::TransmitEvent Node::handle(const parser::TransmitEvent &e) {
@@ -35,7 +35,7 @@
 
 #include "../../render/model/Model.h"
 #include "../../util/undo-events.h"
-#include "src/group/link/WiredLink.h"
+#include "src/group/node/NodePositionBuffer.h"
 #include "src/group/node/TrailBuffer.h"
 #include <QOpenGLFunctions_3_3_Core>
 #include <glm/glm.hpp>
@@ -61,9 +61,15 @@ private:
   glm::vec3 offset;
   TrailBuffer trailBuffer;
   glm::vec3 trailColor;
-  std::vector<WiredLink *> wiredLinks;
+  NodePositionBuffer *positionBuffer{nullptr};
+  int positionIndex{0};
   TransmitInfo transmitInfo;
 
+  /**
+   * Write our current center into the `positionBuffer`, if set
+   */
+  void updatePositionBuffer();
+
 public:
   Node(const Model &model, parser::Node ns3Node, TrailBuffer &&trailBuffer);
   [[nodiscard]] const Model &getModel() const;
@@ -74,7 +80,19 @@ public:
   [[nodiscard]] const TrailBuffer &getTrailBuffer() const;
   [[nodiscard]] const glm::vec3 &getTrailColor() const;
 
-  void addWiredLink(WiredLink *link);
+  /**
+   * Set where this Node should publish its center
+   * for things which follow it (e.g. wired links).
+   * The current center is written immediately
+   *
+   * @param buffer
+   * The buffer to write the center into
+   *
+   * @param index
+   * The index reserved for this Node with `NodePositionBuffer::allocate()`
+   */
+  void setPositionBuffer(NodePositionBuffer &buffer, int index);
+  [[nodiscard]] int getPositionIndex() const;
 
   undo::MoveEvent handle(const parser::MoveEvent &e);
   undo::TransmitEvent handle(const parser::TransmitEvent &e);
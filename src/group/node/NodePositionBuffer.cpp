@@ -0,0 +1,103 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#include "NodePositionBuffer.h"
+#include <algorithm>
+
+namespace netsimulyzer {
+
+NodePositionBuffer::NodePositionBuffer() {
+  initializeOpenGLFunctions();
+
+  glGenBuffers(1, &buffer);
+  glGenTextures(1, &texture);
+}
+
+int NodePositionBuffer::allocate() {
+  const auto index = static_cast<int>(positions.size());
+  positions.emplace_back(0.0f, 0.0f, 0.0f, 1.0f);
+  return index;
+}
+
+void NodePositionBuffer::clear() {
+  positions.clear();
+  dirtyBegin = 0u;
+  dirtyEnd = 0u;
+}
+
+void NodePositionBuffer::set(int index, const glm::vec3 &position) {
+  const auto i = static_cast<std::size_t>(index);
+  positions[i] = {position, 1.0f};
+
+  if (dirtyBegin == dirtyEnd) {
+    dirtyBegin = i;
+    dirtyEnd = i + 1u;
+    return;
+  }
+
+  dirtyBegin = std::min(dirtyBegin, i);
+  dirtyEnd = std::max(dirtyEnd, i + 1u);
+}
+
+void NodePositionBuffer::flush() {
+  glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+
+  // Nodes were added/removed, reupload everything
+  if (positions.size() != bufferSize) {
+    glBufferData(GL_TEXTURE_BUFFER, sizeof(glm::vec4) * positions.size(), positions.data(), GL_DYNAMIC_DRAW);
+    bufferSize = positions.size();
+
+    // Attach the new storage
+    glBindTexture(GL_TEXTURE_BUFFER, texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, buffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0u);
+  } else if (dirtyBegin != dirtyEnd) {
+    glBufferSubData(GL_TEXTURE_BUFFER, sizeof(glm::vec4) * dirtyBegin, sizeof(glm::vec4) * (dirtyEnd - dirtyBegin),
+                    positions.data() + dirtyBegin);
+  }
+
+  glBindBuffer(GL_TEXTURE_BUFFER, 0u);
+  dirtyBegin = 0u;
+  dirtyEnd = 0u;
+}
+
+void NodePositionBuffer::bind() {
+  glBindTexture(GL_TEXTURE_BUFFER, texture);
+}
+
+NodePositionBuffer::~NodePositionBuffer() {
+  glDeleteTextures(1, &texture);
+  glDeleteBuffers(1, &buffer);
+}
+
+} // namespace netsimulyzer
@@ -0,0 +1,125 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+
+#include <QOpenGLFunctions_3_3_Core>
+#include <cstddef>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <vector>
+
+namespace netsimulyzer {
+
+/**
+ * Buffer texture holding the current center of every Node,
+ * so shaders may look up Node positions by index.
+ *
+ * Positions are kept in an application side copy
+ * and changed positions are uploaded on the next `flush()`,
+ * so Nodes may move without a current OpenGL context
+ */
+class NodePositionBuffer : protected QOpenGLFunctions_3_3_Core {
+  unsigned int buffer{0u};
+  unsigned int texture{0u};
+
+  /**
+   * Number of positions allocated in `buffer`
+   */
+  std::size_t bufferSize{0u};
+
+  /**
+   * Application side copy of the buffer.
+   * Padded to four components, since three component
+   * buffer textures are not available in OpenGL 3.3
+   */
+  std::vector<glm::vec4> positions;
+
+  /**
+   * First position changed since the last `flush()`
+   */
+  std::size_t dirtyBegin{0u};
+
+  /**
+   * One past the last position changed since the last `flush()`
+   */
+  std::size_t dirtyEnd{0u};
+
+public:
+  /**
+   * Requires a current OpenGL context
+   */
+  NodePositionBuffer();
+
+  NodePositionBuffer(const NodePositionBuffer &) = delete;
+  NodePositionBuffer &operator=(const NodePositionBuffer &) = delete;
+
+  /**
+   * Reserve a position in the buffer.
+   * Does not require a current OpenGL context
+   *
+   * @return
+   * The index of the new position
+   */
+  int allocate();
+
+  /**
+   * Remove every position from the buffer
+   */
+  void clear();
+
+  /**
+   * Change the position at `index`
+   *
+   * @param index
+   * An index from `allocate()`
+   *
+   * @param position
+   * The new position
+   */
+  void set(int index, const glm::vec3 &position);
+
+  /**
+   * Upload the changed positions.
+   * Requires a current OpenGL context
+   */
+  void flush();
+
+  /**
+   * Bind the buffer texture to the active texture unit
+   */
+  void bind();
+  ~NodePositionBuffer() override;
+};
+
+} // namespace netsimulyzer
@@ -32,79 +32,73 @@
  */
 
 #include "TrailBuffer.h"
-#include <algorithm>
-#include <utility>
+#include "TrailPool.h"
 
 namespace netsimulyzer {
 
-TrailBuffer::TrailBuffer(QOpenGLFunctions_3_3_Core *openGl, unsigned int vao, unsigned int vbo, int initialSize,
-                         int vertexSize) noexcept
-    : openGl{openGl}, vao{vao}, vbo{vbo}, bufferSize{initialSize}, vertexSize{vertexSize}, buffer(bufferSize) {
+TrailBuffer::TrailBuffer(TrailPool *pool, int offset, int capacity) noexcept
+    : pool{pool}, offset{offset}, capacity{capacity} {
 }
 
-TrailBuffer::TrailBuffer(TrailBuffer &&other) noexcept
-    : openGl{other.openGl}, vao{other.vao}, vbo{other.vbo}, bufferSize{other.bufferSize},
-      vertexSize{other.vertexSize}, index{other.index}, _empty{other._empty}, buffer{std::move(other.buffer)} {
-  // Clear these, so the `other` deconstructor doesn't delete our moved buffers
-  other.vao = 0u;
-  other.vbo = 0u;
-}
+void TrailBuffer::write(int position, const glm::vec3 &point) {
+  pool->write(offset + position, {point, color});
 
-TrailBuffer::~TrailBuffer() {
-  openGl->glDeleteBuffers(1, &vbo);
-  openGl->glDeleteVertexArrays(1, &vao);
+  // The extra vertex at the end of the slot is a copy of the first,
+  // so the segment between the end & start of the ring is drawn
+  if (position == 0)
+    pool->write(offset + capacity, {point, color});
 }
 
-void TrailBuffer::bind() const {
-  openGl->glBindVertexArray(vao);
-  openGl->glBindBuffer(GL_ARRAY_BUFFER, vbo);
+void TrailBuffer::append(float x, float y, float z) {
+  if (count == capacity) {
+    // Full, overwrite the oldest point
+    write(head, {x, y, z});
+    head = (head + 1) % capacity;
+    return;
+  }
+
+  write((head + count) % capacity, {x, y, z});
+  count++;
 }
 
-void TrailBuffer::render() const {
-  if (empty())
+void TrailBuffer::pop() {
+  if (count == 0)
     return;
 
-  bind();
-  openGl->glDrawArrays(GL_LINE_STRIP, 0, index);
+  count--;
 }
 
-void TrailBuffer::append(float x, float y, float z) {
-  if (index == bufferSize - 1) {
-    std::rotate(buffer.begin(), buffer.begin() + 1, buffer.end());
-
-    buffer[index].x = x;
-    buffer[index].y = y;
-    buffer[index].z = z;
-
-  } else {
-    if (_empty)
-      _empty = false;
-    else
-      index++;
-
-    buffer[index].x = x;
-    buffer[index].y = y;
-    buffer[index].z = z;
-  }
+bool TrailBuffer::empty() const noexcept {
+  return count == 0;
+}
 
-  openGl->glBindVertexArray(vao);
-  openGl->glBindBuffer(GL_ARRAY_BUFFER, vbo);
-  openGl->glBufferSubData(GL_ARRAY_BUFFER, 0, vertexSize * (index + 1), buffer.data());
+void TrailBuffer::setColor(const glm::vec3 &value) {
+  color = value;
 }
 
-void TrailBuffer::pop() {
-  if (_empty)
+void TrailBuffer::appendDrawRanges(std::vector<int> &first, std::vector<int> &counts) const {
+  // A single point does not make a line
+  if (count < 2)
     return;
 
-  index--;
-  if (index == -1) {
-    _empty = true;
-    index = 0;
+  // Contiguous in the ring
+  if (head + count <= capacity) {
+    first.emplace_back(offset + head);
+    counts.emplace_back(count);
+    return;
   }
-}
 
-bool TrailBuffer::empty() const noexcept {
-  return _empty;
+  // Wrapped, draw from the oldest point through the copy of ring position 0
+  // then from ring position 0 to the newest point
+  const auto tailLength = capacity - head;
+  first.emplace_back(offset + head);
+  counts.emplace_back(tailLength + 1);
+
+  const auto wrappedLength = count - tailLength;
+  if (wrappedLength > 1) {
+    first.emplace_back(offset);
+    counts.emplace_back(wrappedLength);
+  }
 }
 
 } // namespace netsimulyzer
@@ -33,67 +33,94 @@
 
 #pragma once
 
-#include "src/render/shader/Shader.h"
-#include <QOpenGLFunctions_3_3_Core>
+#include <glm/vec3.hpp>
 #include <vector>
 
 namespace netsimulyzer {
 
+class TrailPool;
+
 /**
  * Class that stores the list of locations
  * a Node has visited. Once full, the oldest
  * points 'fall off' the front,
- * first in first out style
+ * first in first out style.
+ *
+ * The points are held in a ring inside a slot
+ * of a shared `TrailPool`, so appending only
+ * writes the newest point
  */
 class TrailBuffer {
-  // Make sure there is no padding is in this struct
-#pragma pack(push, 4)
-  struct TrailVertex {
-    float x;
-    float y;
-    float z;
-  };
-#pragma pack(pop)
-
-  QOpenGLFunctions_3_3_Core *openGl;
-  unsigned int vao{0u};
-  unsigned int vbo{0u};
+  TrailPool *pool;
 
   /**
-   * Total size of the internal buffer
-   * in elements
+   * Index of the first vertex of our slot in the pool
    */
-  int bufferSize{0};
+  int offset;
 
   /**
-   * Size of each vertex in bytes
+   * Maximum number of points in the trail
    */
-  const int vertexSize;
+  int capacity;
 
   /**
-   * The current position in the buffer
+   * Ring position of the oldest point
    */
-  int index{0};
+  int head{0};
 
   /**
-   * FLag indicating that no points are in the buffer
+   * Number of points currently in the trail
    */
-  bool _empty{true};
+  int count{0};
+
+  glm::vec3 color{0.0f};
 
   /**
-   * Application side buffer containing the appended points
+   * Write a point into the ring, mirroring the first
+   * ring position at the end of the slot,
+   * so a wrapped trail stays connected
+   *
+   * @param position
+   * The position in the ring, [0, capacity)
    */
-  std::vector<TrailVertex> buffer;
+  void write(int position, const glm::vec3 &point);
 
 public:
-  explicit TrailBuffer(QOpenGLFunctions_3_3_Core *openGl, unsigned int vao, unsigned int vbo, int initialSize,
-                       int vertexSize) noexcept;
-  TrailBuffer(TrailBuffer &&other) noexcept;
-  ~TrailBuffer();
-  void bind() const;
-  void render() const;
+  /**
+   * Only created by `TrailPool::allocate()`
+   *
+   * @param pool
+   * The pool which owns the slot
+   *
+   * @param offset
+   * The first vertex in the slot.
+   * The slot must hold `capacity + 1` vertices
+   *
+   * @param capacity
+   * The maximum number of points in the trail
+   */
+  TrailBuffer(TrailPool *pool, int offset, int capacity) noexcept;
+
   void append(float x, float y, float z);
   void pop();
   [[nodiscard]] bool empty() const noexcept;
+
+  /**
+   * Set the color for points appended after this call
+   */
+  void setColor(const glm::vec3 &value);
+
+  /**
+   * Add the ranges of the pool to draw for this trail
+   * with `GL_LINE_STRIP`. At most two ranges are added,
+   * one if the trail has not wrapped around the ring.
+   *
+   * @param first
+   * The list to add the first vertex of each range to
+   *
+   * @param counts
+   * The list to add the number of vertices in each range to
+   */
+  void appendDrawRanges(std::vector<int> &first, std::vector<int> &counts) const;
 };
 } // namespace netsimulyzer
@@ -0,0 +1,151 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#include "TrailPool.h"
+#include <algorithm>
+
+namespace netsimulyzer {
+
+void TrailPool::DrawList::clear() {
+  first.clear();
+  counts.clear();
+}
+
+TrailPool::TrailPool() {
+  initializeOpenGLFunctions();
+
+  glGenVertexArrays(1, &vao);
+  glBindVertexArray(vao);
+
+  glGenBuffers(1, &vbo);
+  glBindBuffer(GL_ARRAY_BUFFER, vbo);
+
+  // Location
+  glVertexAttribPointer(0u, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void *>(offsetof(Vertex, position)));
+  glEnableVertexAttribArray(0u);
+
+  // Color
+  glVertexAttribPointer(1u, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void *>(offsetof(Vertex, color)));
+  glEnableVertexAttribArray(1u);
+
+  glBindVertexArray(0u);
+}
+
+TrailBuffer TrailPool::allocate(int capacity) {
+  const auto offset = static_cast<int>(vertices.size());
+
+  // One extra vertex to connect the end of the ring to the start
+  vertices.resize(vertices.size() + capacity + 1u);
+
+  return TrailBuffer{this, offset, capacity};
+}
+
+void TrailPool::clear() {
+  vertices.clear();
+  dirty.clear();
+  allDirty = false;
+}
+
+void TrailPool::write(int index, const Vertex &vertex) {
+  vertices[index] = vertex;
+  if (allDirty)
+    return;
+
+  // Many writes without a flush (e.g. while the scene is not drawn)
+  // would otherwise grow `dirty` without bound
+  if (dirty.size() >= vertices.size()) {
+    allDirty = true;
+    dirty.clear();
+    return;
+  }
+
+  dirty.emplace_back(index);
+}
+
+void TrailPool::flush() {
+  glBindBuffer(GL_ARRAY_BUFFER, vbo);
+
+  // Slots were added/removed, reupload everything
+  if (vertices.size() != bufferSize) {
+    glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * vertices.size(), vertices.data(), GL_DYNAMIC_DRAW);
+    bufferSize = vertices.size();
+    dirty.clear();
+    allDirty = false;
+    return;
+  }
+
+  if (allDirty) {
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(Vertex) * vertices.size(), vertices.data());
+    allDirty = false;
+    return;
+  }
+
+  if (dirty.empty())
+    return;
+
+  std::sort(dirty.begin(), dirty.end());
+  dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+
+  // Upload each contiguous run of changed vertices at once
+  auto runStart = dirty.begin();
+  while (runStart != dirty.end()) {
+    auto runEnd = runStart + 1;
+    while (runEnd != dirty.end() && *runEnd == *(runEnd - 1) + 1)
+      runEnd++;
+
+    const auto first = *runStart;
+    const auto length = runEnd - runStart;
+    glBufferSubData(GL_ARRAY_BUFFER, sizeof(Vertex) * first, sizeof(Vertex) * length, vertices.data() + first);
+
+    runStart = runEnd;
+  }
+
+  dirty.clear();
+}
+
+void TrailPool::render(const DrawList &drawList) {
+  if (drawList.first.empty())
+    return;
+
+  glBindVertexArray(vao);
+  glMultiDrawArrays(GL_LINE_STRIP, drawList.first.data(), drawList.counts.data(),
+                    static_cast<int>(drawList.first.size()));
+  glBindVertexArray(0u);
+}
+
+TrailPool::~TrailPool() {
+  glDeleteBuffers(1, &vbo);
+  glDeleteVertexArrays(1, &vao);
+}
+
+} // namespace netsimulyzer
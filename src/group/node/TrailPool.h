@@ -0,0 +1,157 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+
+#include "TrailBuffer.h"
+#include <QOpenGLFunctions_3_3_Core>
+#include <cstddef>
+#include <glm/vec3.hpp>
+#include <vector>
+
+namespace netsimulyzer {
+
+/**
+ * Single vertex buffer shared by the trails of every Node.
+ *
+ * Each trail is given a fixed slot in the buffer,
+ * which it uses as a ring. Writes are kept in an
+ * application side copy, and only the changed vertices
+ * are uploaded on the next `flush()`,
+ * so trails may be changed without a current OpenGL context
+ */
+class TrailPool : protected QOpenGLFunctions_3_3_Core {
+public:
+  // Same layout as `StaticBatch::Vertex`
+  // so the batch shader may draw the trails
+  struct Vertex {
+    glm::vec3 position;
+    glm::vec3 color;
+  };
+
+  /**
+   * Ranges of the pool to draw,
+   * in the form `glMultiDrawArrays()` expects
+   */
+  struct DrawList {
+    std::vector<int> first;
+    std::vector<int> counts;
+
+    void clear();
+  };
+
+private:
+  unsigned int vao{0u};
+  unsigned int vbo{0u};
+
+  /**
+   * Number of vertices allocated in `vbo`
+   */
+  std::size_t bufferSize{0u};
+
+  /**
+   * Application side copy of the buffer
+   */
+  std::vector<Vertex> vertices;
+
+  /**
+   * Indices of vertices changed since the last `flush()`.
+   * May hold repeats, up to the number of vertices in the pool
+   */
+  std::vector<int> dirty;
+
+  /**
+   * If more writes than there are vertices were made since the last `flush()`.
+   * `dirty` is no longer tracked, and the whole pool is uploaded instead
+   */
+  bool allDirty{false};
+
+public:
+  /**
+   * Requires a current OpenGL context
+   */
+  TrailPool();
+
+  // The trails keep a pointer to the pool
+  // so it should not be moved or copied
+  TrailPool(const TrailPool &) = delete;
+  TrailPool &operator=(const TrailPool &) = delete;
+
+  /**
+   * Reserve a slot for a new trail.
+   * Does not require a current OpenGL context
+   *
+   * @param capacity
+   * The maximum number of points in the trail
+   *
+   * @return
+   * A trail which writes into its slot of this pool
+   */
+  TrailBuffer allocate(int capacity);
+
+  /**
+   * Drop every slot.
+   * Any `TrailBuffer` from this pool must not be used after this call
+   */
+  void clear();
+
+  /**
+   * Change a single vertex in the pool
+   *
+   * @param index
+   * The index of the vertex in the pool
+   *
+   * @param vertex
+   * The new value for the vertex
+   */
+  void write(int index, const Vertex &vertex);
+
+  /**
+   * Upload all vertices changed since the last flush.
+   * Requires a current OpenGL context
+   */
+  void flush();
+
+  /**
+   * Draw the ranges in `drawList` as line strips.
+   * Does not `flush()`
+   *
+   * @param drawList
+   * The ranges to draw
+   */
+  void render(const DrawList &drawList);
+
+  ~TrailPool() override;
+};
+
+} // namespace netsimulyzer
@@ -0,0 +1,171 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#include "HeadlessRenderer.h"
+#include <QOpenGLFramebufferObjectFormat>
+#include <QSurfaceFormat>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace netsimulyzer {
+
+void HeadlessRenderer::beginReadback(std::size_t index) {
+  QOpenGLFramebufferObject::blitFramebuffer(resolveFramebuffer.get(), framebuffer.get());
+  resolveFramebuffer->bind();
+
+  // With a pack buffer bound, `glReadPixels()` returns immediately
+  // and the copy finishes in the background
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, pixelBuffers[index]);
+  glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+QImage HeadlessRenderer::finishReadback(std::size_t index) {
+  QImage frame{width, height, QImage::Format_RGBA8888};
+  const auto rowSize = static_cast<std::size_t>(width) * 4u;
+
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, pixelBuffers[index]);
+  const auto pixels = static_cast<const unsigned char *>(
+      glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(rowSize * height), GL_MAP_READ_BIT));
+
+  if (pixels) {
+    // OpenGL's rows start at the bottom
+    for (auto row = 0; row < height; row++)
+      std::memcpy(frame.scanLine(height - 1 - row), pixels + rowSize * row, rowSize);
+  } else
+    std::cerr << "Failed to map frame pixel buffer\n";
+
+  glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  return frame;
+}
+
+HeadlessRenderer::HeadlessRenderer(int width, int height, const QString &resourcePath)
+    : width(width), height(height) {
+  scene.setResourcePath(resourcePath);
+}
+
+HeadlessRenderer::~HeadlessRenderer() {
+  // The scene & buffers are freed after this,
+  // so keep our context current for them
+  if (!context.isValid())
+    return;
+
+  context.makeCurrent(&surface);
+  if (pixelBuffers[0] != 0u)
+    glDeleteBuffers(static_cast<GLsizei>(pixelBuffers.size()), pixelBuffers.data());
+}
+
+bool HeadlessRenderer::initialize() {
+  surface.setFormat(QSurfaceFormat::defaultFormat());
+  surface.create();
+
+  context.setFormat(QSurfaceFormat::defaultFormat());
+  if (!context.create()) {
+    std::cerr << "Failed to create an OpenGL context\n";
+    return false;
+  }
+
+  if (!context.makeCurrent(&surface)) {
+    std::cerr << "Failed to make the OpenGL context current\n";
+    return false;
+  }
+
+  if (!initializeOpenGLFunctions()) {
+    std::cerr << "Failed to initialize OpenGL 3.3 functions\n";
+    return false;
+  }
+  std::cout << glGetString(GL_VERSION) << '\n';
+
+  QOpenGLFramebufferObjectFormat format;
+  format.setAttachment(QOpenGLFramebufferObject::Depth);
+  format.setSamples(context.format().samples());
+  framebuffer = std::make_unique<QOpenGLFramebufferObject>(width, height, format);
+  resolveFramebuffer = std::make_unique<QOpenGLFramebufferObject>(width, height);
+
+  if (!framebuffer->isValid() || !resolveFramebuffer->isValid()) {
+    std::cerr << "Failed to create a " << width << 'x' << height << " framebuffer\n";
+    return false;
+  }
+
+  glGenBuffers(static_cast<GLsizei>(pixelBuffers.size()), pixelBuffers.data());
+  for (const auto pixelBuffer : pixelBuffers) {
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pixelBuffer);
+    glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(width) * height * 4, nullptr, GL_STREAM_READ);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+  scene.initialize();
+  scene.setPerspective(camera.getFieldOfView(), width, height);
+
+  return true;
+}
+
+void HeadlessRenderer::load(const parser::FileParser &parser) {
+  scene.setConfiguration(parser.getConfiguration());
+  scene.add(parser.getAreas(), parser.getBuildings(), parser.getDecorations(), parser.getLinks(), parser.getNodes());
+  scene.enqueueEvents(parser.getSceneEvents());
+}
+
+bool HeadlessRenderer::render(parser::nanoseconds timeStep, FrameWriter &writer) {
+  const auto endTime = scene.getConfiguration().endTime;
+  // Include both the first (0) & last (`endTime`) frames
+  const auto frameCount = endTime / timeStep + (endTime % timeStep == 0LL ? 1LL : 2LL);
+
+  for (auto frame = 0LL; frame < frameCount; frame++) {
+    scene.setTime(std::min(frame * timeStep, endTime));
+    scene.handleEvents();
+
+    framebuffer->bind();
+    glViewport(0, 0, width, height);
+    scene.render(camera);
+
+    // Read this frame back while the previous one,
+    // which should be finished by now, is handed to the writer
+    const auto current = static_cast<std::size_t>(frame % 2LL);
+    beginReadback(current);
+
+    if (frame > 0LL && !writer.write(finishReadback(1u - current)))
+      return false;
+  }
+
+  if (frameCount > 0LL && !writer.write(finishReadback(static_cast<std::size_t>((frameCount - 1LL) % 2LL))))
+    return false;
+
+  return writer.finish();
+}
+
+} // namespace netsimulyzer
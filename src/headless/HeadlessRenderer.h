@@ -0,0 +1,144 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+
+#include "../render/camera/Camera.h"
+#include "../scene/Scene.h"
+#include "FrameWriter.h"
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+#include <QOpenGLFunctions_3_3_Core>
+#include <QString>
+#include <array>
+#include <file-parser.h>
+#include <memory>
+#include <model.h>
+
+namespace netsimulyzer {
+
+/**
+ * Renders a scenario to a `FrameWriter` without any windows,
+ * for producing videos on machines without a display.
+ *
+ * Frames are read back through a pair of pixel buffers,
+ * so the GPU may draw one frame while the previous one is copied out
+ */
+class HeadlessRenderer : protected QOpenGLFunctions_3_3_Core {
+  int width;
+  int height;
+
+  // Keep the surface & context declared first,
+  // everything after them needs the context to clean up
+  QOffscreenSurface surface;
+  QOpenGLContext context;
+
+  /**
+   * What the scene is drawn into, possibly multisampled
+   */
+  std::unique_ptr<QOpenGLFramebufferObject> framebuffer;
+
+  /**
+   * Single sample copy of `framebuffer`, for reading back
+   */
+  std::unique_ptr<QOpenGLFramebufferObject> resolveFramebuffer;
+
+  /**
+   * Alternating destinations for `glReadPixels()`
+   */
+  std::array<GLuint, 2> pixelBuffers{};
+
+  Scene scene;
+  Camera camera{glm::vec3{0.0f, 2.0f, 0.0f}};
+
+  /**
+   * Start the asynchronous copy of the last rendered frame
+   * into `pixelBuffers[index]`
+   */
+  void beginReadback(std::size_t index);
+
+  /**
+   * Wait for the copy into `pixelBuffers[index]` to finish,
+   * and retrieve the frame
+   */
+  QImage finishReadback(std::size_t index);
+
+public:
+  /**
+   * @param width
+   * The width of the output frames, in pixels
+   *
+   * @param height
+   * The height of the output frames, in pixels
+   *
+   * @param resourcePath
+   * Path to the 'resources' directory, for models & textures
+   */
+  HeadlessRenderer(int width, int height, const QString &resourcePath);
+  ~HeadlessRenderer();
+
+  /**
+   * Create the OpenGL context & framebuffers.
+   * Must be called before anything else
+   *
+   * @return
+   * False if an OpenGL 3.3 context could not be created
+   */
+  bool initialize();
+
+  /**
+   * Add everything from a parsed scenario to the scene
+   *
+   * @param parser
+   * A parser which has successfully parsed a file
+   */
+  void load(const parser::FileParser &parser);
+
+  /**
+   * Play the scenario from the beginning to the end,
+   * outputting one frame per `timeStep`
+   *
+   * @param timeStep
+   * The amount of simulation time between frames. Must be positive
+   *
+   * @param writer
+   * Where to output the frames
+   *
+   * @return
+   * False if writing a frame failed
+   */
+  bool render(parser::nanoseconds timeStep, FrameWriter &writer);
+};
+
+} // namespace netsimulyzer
@@ -0,0 +1,98 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#include "Y4mWriter.h"
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+
+namespace netsimulyzer {
+
+Y4mWriter::Y4mWriter(const QString &path, int width, int height, int frameRate)
+    : out(path.toStdString(), std::ios::binary | std::ios::trunc), width(width), height(height),
+      frameRate(frameRate) {
+  if (!out)
+    std::cerr << "Failed to open: " << path.toStdString() << " for writing\n";
+}
+
+bool Y4mWriter::write(QImage frame) {
+  if (!out)
+    return false;
+
+  if (frame.width() != width || frame.height() != height) {
+    std::cerr << "Frame size: " << frame.width() << 'x' << frame.height() << " does not match the stream size: " << width
+              << 'x' << height << '\n';
+    return false;
+  }
+
+  if (!wroteHeader) {
+    out << "YUV4MPEG2 W" << width << " H" << height << " F" << frameRate << ":1 Ip A1:1 C444\n";
+    wroteHeader = true;
+  }
+
+  if (frame.format() != QImage::Format_RGBA8888)
+    frame = frame.convertToFormat(QImage::Format_RGBA8888);
+
+  const auto planeSize = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+  planes.resize(planeSize * 3u);
+  auto y = planes.data();
+  auto u = y + planeSize;
+  auto v = u + planeSize;
+
+  const auto clamp = [](int value) { return static_cast<char>(std::clamp(value, 0, 255)); };
+
+  for (auto row = 0; row < height; row++) {
+    const auto pixels = frame.constScanLine(row);
+    for (auto column = 0; column < width; column++) {
+      const int r = pixels[column * 4];
+      const int g = pixels[column * 4 + 1];
+      const int b = pixels[column * 4 + 2];
+
+      // BT.601, limited range, in 8 bit fixed point
+      *y++ = clamp(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+      *u++ = clamp(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+      *v++ = clamp(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+    }
+  }
+
+  out << "FRAME\n";
+  out.write(planes.data(), static_cast<std::streamsize>(planes.size()));
+  return static_cast<bool>(out);
+}
+
+bool Y4mWriter::finish() {
+  out.flush();
+  return static_cast<bool>(out);
+}
+
+} // namespace netsimulyzer
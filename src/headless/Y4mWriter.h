@@ -0,0 +1,85 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+
+#include "FrameWriter.h"
+#include <QImage>
+#include <QString>
+#include <fstream>
+#include <vector>
+
+namespace netsimulyzer {
+
+/**
+ * Writes frames as an uncompressed YUV4MPEG2 (.y4m) stream,
+ * which may be piped or fed directly to most video encoders
+ * (e.g. `ffmpeg -i out.y4m out.mp4`).
+ *
+ * Frames are stored as 4:4:4 (no chroma subsampling)
+ * with BT.601 limited range coefficients
+ */
+class Y4mWriter : public FrameWriter {
+  std::ofstream out;
+  int width;
+  int height;
+  int frameRate;
+  bool wroteHeader = false;
+
+  /**
+   * One converted frame, planes in Y, U, V order.
+   * Kept to reuse the allocation
+   */
+  std::vector<char> planes;
+
+public:
+  /**
+   * @param path
+   * The file to write. Overwritten if it exists
+   *
+   * @param width
+   * The width of every frame, in pixels
+   *
+   * @param height
+   * The height of every frame, in pixels
+   *
+   * @param frameRate
+   * The playback rate to record in the header, in frames per second
+   */
+  Y4mWriter(const QString &path, int width, int height, int frameRate);
+
+  bool write(QImage frame) override;
+  bool finish() override;
+};
+
+} // namespace netsimulyzer
@@ -146,6 +146,12 @@ glm::mat4 Camera::view_matrix() const {
   return glm::lookAt(position, position + front, up);
 }
 
+bool Camera::isMoving() const {
+  return active.front_back != active_directions::direction::none ||
+         active.left_right != active_directions::side::none ||
+         active.upDown != active_directions::verticalDirection::none || active.turn != active_directions::side::none;
+}
+
 void Camera::move(float delta_time) {
   auto velocity = move_speed * delta_time;
 
@@ -135,6 +135,15 @@ public:
   [[nodiscard]] move_state getMobility() const;
   void setMobility(move_state state);
 
+  /**
+   * Check if the camera will move on the next call to `move()`,
+   * i.e. any of the movement keys are held
+   *
+   * @return
+   * True if the camera is moving, false otherwise
+   */
+  [[nodiscard]] bool isMoving() const;
+
   void move(float delta_time);
   void mouse_move(float delta_x, float delta_y);
 
@@ -44,7 +44,7 @@
 
 namespace netsimulyzer {
 
-Floor::Floor(Mesh mesh) : mesh(std::move(mesh)) {
+Floor::Floor(Mesh mesh, float textureRepeat) : mesh(std::move(mesh)), textureRepeat(textureRepeat) {
 }
 
 void Floor::setPosition(const glm::vec3 &value) {
@@ -64,6 +64,14 @@ const glm::mat4 &Floor::getModelMatrix() const {
   return model;
 }
 
+void Floor::setTextureRepeat(float value) {
+  textureRepeat = value;
+}
+
+float Floor::getTextureRepeat() const {
+  return textureRepeat;
+}
+
 void Floor::render() {
   mesh.render();
 }
@@ -47,8 +47,22 @@ class Floor {
   glm::vec3 position{0.0f};
   glm::mat4 model{1.0f};
 
+  /**
+   * The number of times the texture repeats across the floor from its center.
+   * Applied in the shader, so the vertices only hold 0.0 & 1.0 texture coordinates
+   */
+  float textureRepeat;
+
 public:
-  explicit Floor(Mesh mesh);
+  /**
+   * @param mesh
+   * The floor mesh, from `Renderer::allocateFloor()`
+   *
+   * @param textureRepeat
+   * The number of times the texture repeats across the floor from its center.
+   * The size the floor was allocated with
+   */
+  Floor(Mesh mesh, float textureRepeat);
 
   // No Moves or copies
   Floor(Floor &&other) = delete;
@@ -61,6 +75,9 @@ public:
 
   [[nodiscard]] const glm::mat4 &getModelMatrix() const;
 
+  void setTextureRepeat(float value);
+  [[nodiscard]] float getTextureRepeat() const;
+
   [[nodiscard]] const Mesh &getMesh() const;
   [[nodiscard]] texture_id getTextureId() const;
 
@@ -0,0 +1,121 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#include "StaticBatch.h"
+#include <cstddef>
+
+namespace netsimulyzer {
+
+void StaticBatch::move(StaticBatch &&other) noexcept {
+  initializeOpenGLFunctions();
+  renderInfo = other.renderInfo;
+
+  // Clear the other one
+  // so it doesn't delete the buffers
+  other.renderInfo.vao = 0u;
+  other.renderInfo.vbo = 0u;
+  other.renderInfo.ibo = 0u;
+  other.renderInfo.indexCount = 0;
+}
+
+StaticBatch::StaticBatch(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices,
+                         unsigned int primitive) {
+  initializeOpenGLFunctions();
+  renderInfo.indexCount = static_cast<int>(indices.size());
+  renderInfo.primitive = primitive;
+
+  glGenVertexArrays(1, &renderInfo.vao);
+  glBindVertexArray(renderInfo.vao);
+
+  glGenBuffers(1, &renderInfo.ibo);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, renderInfo.ibo);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int) * indices.size(), indices.data(), GL_STATIC_DRAW);
+
+  glGenBuffers(1, &renderInfo.vbo);
+  glBindBuffer(GL_ARRAY_BUFFER, renderInfo.vbo);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * vertices.size(), vertices.data(), GL_STATIC_DRAW);
+
+  // Location
+  glVertexAttribPointer(0u, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void *>(offsetof(Vertex, position)));
+  glEnableVertexAttribArray(0u);
+
+  // Color
+  glVertexAttribPointer(1u, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void *>(offsetof(Vertex, color)));
+  glEnableVertexAttribArray(1u);
+
+  glBindVertexArray(0u);
+}
+
+StaticBatch::StaticBatch(const std::vector<unsigned int> &indices, unsigned int primitive) {
+  initializeOpenGLFunctions();
+  renderInfo.indexCount = static_cast<int>(indices.size());
+  renderInfo.primitive = primitive;
+
+  // Core profiles require a VAO, even with no attributes
+  glGenVertexArrays(1, &renderInfo.vao);
+  glBindVertexArray(renderInfo.vao);
+
+  glGenBuffers(1, &renderInfo.ibo);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, renderInfo.ibo);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int) * indices.size(), indices.data(), GL_STATIC_DRAW);
+
+  glBindVertexArray(0u);
+}
+
+const StaticBatch::RenderInfo &StaticBatch::getRenderInfo() const {
+  return renderInfo;
+}
+
+void StaticBatch::render() {
+  if (renderInfo.indexCount == 0)
+    return;
+
+  glBindVertexArray(renderInfo.vao);
+  glDrawElements(renderInfo.primitive, renderInfo.indexCount, GL_UNSIGNED_INT, nullptr);
+  glBindVertexArray(0u);
+}
+
+StaticBatch::~StaticBatch() {
+  glDeleteBuffers(1, &renderInfo.ibo);
+  renderInfo.ibo = 0u;
+
+  glDeleteBuffers(1, &renderInfo.vbo);
+  renderInfo.vbo = 0u;
+
+  glDeleteVertexArrays(1, &renderInfo.vao);
+  renderInfo.vao = 0u;
+
+  renderInfo.indexCount = 0;
+}
+
+} // namespace netsimulyzer
@@ -0,0 +1,123 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+
+#include <QOpenGLFunctions_3_3_Core>
+#include <glm/vec3.hpp>
+#include <utility>
+#include <vector>
+
+namespace netsimulyzer {
+
+/**
+ * Owner of a single vertex/index buffer pair
+ * holding many pieces of static geometry,
+ * so they may be drawn with a single call
+ */
+class StaticBatch : protected QOpenGLFunctions_3_3_Core {
+public:
+  struct Vertex {
+    glm::vec3 position;
+    glm::vec3 color;
+  };
+
+  struct RenderInfo {
+    unsigned int vao = 0u;
+    unsigned int vbo = 0u;
+    unsigned int ibo = 0u;
+    int indexCount = 0;
+
+    /**
+     * The OpenGL primitive the indices describe
+     * (e.g. GL_TRIANGLES, GL_LINES)
+     */
+    unsigned int primitive = GL_TRIANGLES;
+  };
+
+private:
+  RenderInfo renderInfo;
+
+  void move(StaticBatch &&other) noexcept;
+
+public:
+  /**
+   * Upload the geometry for the batch.
+   * Requires a current OpenGL context
+   *
+   * @param vertices
+   * The position & color of every vertex in the batch
+   *
+   * @param indices
+   * Indices into `vertices` describing `primitive`s
+   *
+   * @param primitive
+   * The OpenGL primitive to draw the batch with
+   */
+  StaticBatch(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices, unsigned int primitive);
+
+  /**
+   * Upload an index only batch, for shaders which
+   * generate their vertices from `gl_VertexID`.
+   * Requires a current OpenGL context
+   *
+   * @param indices
+   * The indices describing `primitive`s
+   *
+   * @param primitive
+   * The OpenGL primitive to draw the batch with
+   */
+  StaticBatch(const std::vector<unsigned int> &indices, unsigned int primitive);
+
+  // Allow Moves
+  StaticBatch(StaticBatch &&other) noexcept {
+    move(std::forward<StaticBatch &&>(other));
+  }
+
+  StaticBatch &operator=(StaticBatch &&other) noexcept {
+    move(std::forward<StaticBatch &&>(other));
+    return *this;
+  }
+
+  // Disallow copies
+  StaticBatch(const StaticBatch &) = delete;
+  StaticBatch &operator=(const StaticBatch &) = delete;
+
+  [[nodiscard]] const RenderInfo &getRenderInfo() const;
+
+  void render();
+
+  ~StaticBatch() override;
+};
+
+} // namespace netsimulyzer
@@ -0,0 +1,128 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#include "TransmissionSpheres.h"
+#include "../mesh/Vertex.h"
+#include <algorithm>
+
+namespace netsimulyzer {
+
+TransmissionSpheres::TransmissionSpheres(const std::vector<Mesh> &meshes) {
+  initializeOpenGLFunctions();
+
+  glGenBuffers(1, &instanceVbo);
+
+  bindings.reserve(meshes.size());
+  for (const auto &mesh : meshes) {
+    const auto &renderInfo = mesh.getRenderInfo();
+    MeshBinding binding;
+    binding.indexCount = renderInfo.indexCount;
+    binding.indexType = renderInfo.indexType;
+
+    glGenVertexArrays(1, &binding.vao);
+    glBindVertexArray(binding.vao);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, renderInfo.ibo);
+
+    // Location, only the position of the sphere is needed
+    glBindBuffer(GL_ARRAY_BUFFER, renderInfo.vbo);
+    glVertexAttribPointer(0u, 3, GL_FLOAT, GL_FALSE, sizeof(PackedVertex),
+                          reinterpret_cast<void *>(offsetof(PackedVertex, position)));
+    glEnableVertexAttribArray(0u);
+
+    // Per instance attributes
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+
+    // Center
+    glVertexAttribPointer(3u, 3, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                          reinterpret_cast<void *>(offsetof(Instance, center)));
+    glEnableVertexAttribArray(3u);
+    glVertexAttribDivisor(3u, 1u);
+
+    // Radius
+    glVertexAttribPointer(4u, 1, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                          reinterpret_cast<void *>(offsetof(Instance, radius)));
+    glEnableVertexAttribArray(4u);
+    glVertexAttribDivisor(4u, 1u);
+
+    // Color
+    glVertexAttribPointer(5u, 3, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                          reinterpret_cast<void *>(offsetof(Instance, color)));
+    glEnableVertexAttribArray(5u);
+    glVertexAttribDivisor(5u, 1u);
+
+    glBindVertexArray(0u);
+    bindings.emplace_back(binding);
+  }
+
+  glBindBuffer(GL_ARRAY_BUFFER, 0u);
+}
+
+void TransmissionSpheres::clear() {
+  instances.clear();
+}
+
+void TransmissionSpheres::add(const glm::vec3 &center, float radius, const glm::vec3 &color) {
+  instances.emplace_back(Instance{center, radius, color});
+}
+
+void TransmissionSpheres::render() {
+  if (instances.empty())
+    return;
+
+  glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+  if (instances.size() > instanceCapacity) {
+    // Grow geometrically, so a steady increase in transmissions
+    // does not reallocate every frame
+    instanceCapacity = std::max(instances.size(), instanceCapacity * 2u);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(Instance) * instanceCapacity, nullptr, GL_STREAM_DRAW);
+  }
+  glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(Instance) * instances.size(), instances.data());
+  glBindBuffer(GL_ARRAY_BUFFER, 0u);
+
+  for (const auto &binding : bindings) {
+    glBindVertexArray(binding.vao);
+    glDrawElementsInstanced(GL_TRIANGLES, binding.indexCount, binding.indexType, nullptr,
+                            static_cast<int>(instances.size()));
+  }
+  glBindVertexArray(0u);
+}
+
+TransmissionSpheres::~TransmissionSpheres() {
+  for (auto &binding : bindings) {
+    glDeleteVertexArrays(1, &binding.vao);
+  }
+  glDeleteBuffers(1, &instanceVbo);
+}
+
+} // namespace netsimulyzer
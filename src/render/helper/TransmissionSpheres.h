@@ -0,0 +1,120 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+
+#include "../mesh/Mesh.h"
+#include <QOpenGLFunctions_3_3_Core>
+#include <cstddef>
+#include <glm/vec3.hpp>
+#include <vector>
+
+namespace netsimulyzer {
+
+/**
+ * Draws every active transmission as an instance of the
+ * transmission sphere model, with a single draw per mesh
+ * in that model (normally one).
+ *
+ * The sphere's vertex & index buffers are shared with the
+ * ModelCache, only the per instance buffer is owned here
+ */
+class TransmissionSpheres : protected QOpenGLFunctions_3_3_Core {
+public:
+  struct Instance {
+    glm::vec3 center;
+    float radius;
+    glm::vec3 color;
+  };
+
+private:
+  struct MeshBinding {
+    unsigned int vao = 0u;
+    int indexCount = 0;
+    unsigned int indexType = GL_UNSIGNED_INT;
+  };
+
+  std::vector<MeshBinding> bindings;
+  unsigned int instanceVbo{0u};
+
+  /**
+   * Number of instances allocated in `instanceVbo`
+   */
+  std::size_t instanceCapacity{0u};
+
+  /**
+   * The instances to draw on the next `render()`
+   */
+  std::vector<Instance> instances;
+
+public:
+  /**
+   * Requires a current OpenGL context
+   *
+   * @param meshes
+   * The meshes of the sphere model.
+   * Must outlive this object
+   */
+  explicit TransmissionSpheres(const std::vector<Mesh> &meshes);
+
+  TransmissionSpheres(const TransmissionSpheres &) = delete;
+  TransmissionSpheres &operator=(const TransmissionSpheres &) = delete;
+
+  /**
+   * Remove every instance, should be called at the start of each frame
+   */
+  void clear();
+
+  /**
+   * Add a sphere to draw on the next `render()`
+   *
+   * @param center
+   * The center of the sphere
+   *
+   * @param radius
+   * The scale to apply to the sphere model
+   *
+   * @param color
+   * The color of the sphere
+   */
+  void add(const glm::vec3 &center, float radius, const glm::vec3 &color);
+
+  /**
+   * Upload the instances and draw them
+   */
+  void render();
+
+  ~TransmissionSpheres() override;
+};
+
+} // namespace netsimulyzer
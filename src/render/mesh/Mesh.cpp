@@ -34,6 +34,24 @@
 #include "Mesh.h"
 #include "Vertex.h"
 #include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace {
+
+std::vector<netsimulyzer::PackedVertex> packVertices(const netsimulyzer::Vertex vertices[], unsigned int count) {
+  std::vector<netsimulyzer::PackedVertex> packed;
+  packed.reserve(count);
+
+  for (auto i = 0u; i < count; i++) {
+    packed.emplace_back(netsimulyzer::PackedVertex::pack(vertices[i]));
+  }
+
+  return packed;
+}
+
+} // namespace
 
 namespace netsimulyzer {
 
@@ -59,7 +77,11 @@ void Mesh::setMaterial(const Material &value) {
   material = value;
 }
 
-Mesh::Mesh(const Vertex vertices[], unsigned int indices[], unsigned int vertexCount, int indexCount) {
+Mesh::Mesh(const Vertex vertices[], unsigned int indices[], unsigned int vertexCount, int indexCount)
+    : Mesh(packVertices(vertices, vertexCount).data(), indices, vertexCount, indexCount) {
+}
+
+Mesh::Mesh(const PackedVertex vertices[], const unsigned int indices[], unsigned int vertexCount, int indexCount) {
   initializeOpenGLFunctions();
   renderInfo.indexCount = indexCount;
 
@@ -86,24 +108,35 @@ Mesh::Mesh(const Vertex vertices[], unsigned int indices[], unsigned int vertexC
 
   glGenBuffers(1, &renderInfo.ibo);
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, renderInfo.ibo);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int) * renderInfo.indexCount, indices, GL_STATIC_DRAW);
+
+  // Halve the index buffer when every index fits
+  if (vertexCount <= std::numeric_limits<std::uint16_t>::max() + 1u) {
+    std::vector<std::uint16_t> shortIndices{indices, indices + indexCount};
+    renderInfo.indexType = GL_UNSIGNED_SHORT;
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(std::uint16_t) * renderInfo.indexCount, shortIndices.data(),
+                 GL_STATIC_DRAW);
+  } else {
+    renderInfo.indexType = GL_UNSIGNED_INT;
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int) * renderInfo.indexCount, indices, GL_STATIC_DRAW);
+  }
 
   glGenBuffers(1, &renderInfo.vbo);
   glBindBuffer(GL_ARRAY_BUFFER, renderInfo.vbo);
-  glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * vertexCount, vertices, GL_STATIC_DRAW);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(PackedVertex) * vertexCount, vertices, GL_STATIC_DRAW);
 
   // Location
-  glVertexAttribPointer(0u, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                        reinterpret_cast<void *>(offsetof(Vertex, position)));
+  glVertexAttribPointer(0u, 3, GL_FLOAT, GL_FALSE, sizeof(PackedVertex),
+                        reinterpret_cast<void *>(offsetof(PackedVertex, position)));
   glEnableVertexAttribArray(0u);
 
-  // Normal
-  glVertexAttribPointer(1u, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void *>(offsetof(Vertex, normal)));
+  // Normal, unpacked to [-1.0, 1.0] by the GPU
+  glVertexAttribPointer(1u, 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(PackedVertex),
+                        reinterpret_cast<void *>(offsetof(PackedVertex, normal)));
   glEnableVertexAttribArray(1u);
 
   // Texture
-  glVertexAttribPointer(2u, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                        reinterpret_cast<void *>(offsetof(Vertex, textureCoordinate)));
+  glVertexAttribPointer(2u, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(PackedVertex),
+                        reinterpret_cast<void *>(offsetof(PackedVertex, textureCoordinate)));
   glEnableVertexAttribArray(2u);
 
   glBindVertexArray(0u);
@@ -120,7 +153,7 @@ const Mesh::MeshBounds &Mesh::getBounds() const {
 void Mesh::render() {
   glBindVertexArray(renderInfo.vao);
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, renderInfo.ibo);
-  glDrawElements(GL_TRIANGLES, renderInfo.indexCount, GL_UNSIGNED_INT, nullptr);
+  glDrawElements(GL_TRIANGLES, renderInfo.indexCount, renderInfo.indexType, nullptr);
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
   glBindVertexArray(0);
 }
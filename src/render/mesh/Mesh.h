@@ -48,6 +48,12 @@ public:
     unsigned int vbo = 0u;
     unsigned int ibo = 0u;
     int indexCount = 0;
+
+    /**
+     * `GL_UNSIGNED_SHORT` when every index fits in 16 bits,
+     * `GL_UNSIGNED_INT` otherwise
+     */
+    unsigned int indexType = GL_UNSIGNED_INT;
   };
 
   struct MeshBounds {
@@ -63,8 +69,18 @@ private:
   void move(Mesh &&other) noexcept;
 
 public:
+  /**
+   * Pack & upload a mesh.
+   * See `PackedVertex`
+   */
   Mesh(const Vertex vertices[], unsigned int indices[], unsigned int vertexCount, int indexCount);
 
+  /**
+   * Upload an already packed mesh.
+   * Uses 16 bit indices if there are few enough vertices
+   */
+  Mesh(const PackedVertex vertices[], const unsigned int indices[], unsigned int vertexCount, int indexCount);
+
   // Allow Moves
   Mesh(Mesh &&other) noexcept {
     move(std::forward<Mesh &&>(other));
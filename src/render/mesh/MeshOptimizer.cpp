@@ -0,0 +1,234 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace {
+
+/**
+ * Size of the simulated LRU cache. Larger than most hardware caches,
+ * the scoring favors the most recently used entries anyway
+ */
+constexpr int cacheSize = 32;
+
+constexpr float cacheDecayPower = 1.5f;
+constexpr float lastTriangleScore = 0.75f;
+constexpr float valenceBoostScale = 2.0f;
+constexpr float valenceBoostPower = 0.5f;
+
+struct VertexState {
+  /**
+   * Position in the simulated cache, -1 if the vertex is not in it
+   */
+  int cachePosition = -1;
+
+  /**
+   * Offset into `triangleLists` for this vertex's triangles
+   */
+  std::size_t triangleOffset = 0u;
+
+  /**
+   * Triangles using this vertex which have not been emitted yet.
+   * The first `remaining` entries of this vertex's triangle list
+   */
+  unsigned int remaining = 0u;
+
+  float score = 0.0f;
+};
+
+float vertexScore(const VertexState &vertex) {
+  // Nothing left to draw with this vertex
+  if (vertex.remaining == 0u)
+    return -1.0f;
+
+  auto score = 0.0f;
+  if (vertex.cachePosition >= 0) {
+    if (vertex.cachePosition < 3) {
+      // Used by the last triangle, so a fixed score,
+      // otherwise it would encourage strips over fans
+      score = lastTriangleScore;
+    } else {
+      const auto scale = 1.0f / static_cast<float>(cacheSize - 3);
+      score = std::pow(1.0f - static_cast<float>(vertex.cachePosition - 3) * scale, cacheDecayPower);
+    }
+  }
+
+  // Favor vertices with few triangles left, to finish them off
+  // rather than leave lone triangles for later
+  score += valenceBoostScale * std::pow(static_cast<float>(vertex.remaining), -valenceBoostPower);
+  return score;
+}
+
+} // namespace
+
+namespace netsimulyzer {
+
+void optimizeVertexCache(std::vector<unsigned int> &indices, std::size_t vertexCount) {
+  const auto triangleCount = indices.size() / 3u;
+  if (triangleCount < 2u || vertexCount == 0u)
+    return;
+
+  std::vector<VertexState> vertices(vertexCount);
+  for (auto i = 0u; i < triangleCount * 3u; i++) {
+    // Leave meshes with out of range indices alone
+    if (indices[i] >= vertexCount)
+      return;
+
+    vertices[indices[i]].remaining++;
+  }
+
+  // Every vertex's triangles, flattened into one list
+  std::vector<std::size_t> triangleLists(triangleCount * 3u);
+  std::size_t offset = 0u;
+  for (auto &vertex : vertices) {
+    vertex.triangleOffset = offset;
+    offset += vertex.remaining;
+    vertex.remaining = 0u;
+  }
+  for (std::size_t triangle = 0u; triangle < triangleCount; triangle++) {
+    for (auto corner = 0u; corner < 3u; corner++) {
+      auto &vertex = vertices[indices[triangle * 3u + corner]];
+      triangleLists[vertex.triangleOffset + vertex.remaining++] = triangle;
+    }
+  }
+
+  for (auto &vertex : vertices) {
+    vertex.score = vertexScore(vertex);
+  }
+
+  std::vector<float> triangleScores(triangleCount);
+  for (std::size_t triangle = 0u; triangle < triangleCount; triangle++) {
+    for (auto corner = 0u; corner < 3u; corner++)
+      triangleScores[triangle] += vertices[indices[triangle * 3u + corner]].score;
+  }
+
+  std::vector<bool> emitted(triangleCount, false);
+  std::vector<unsigned int> output;
+  output.reserve(indices.size());
+
+  // Holds room for the three vertices of the new triangle,
+  // pushed in front of the existing entries
+  std::array<int, cacheSize + 3> cache{};
+  cache.fill(-1);
+
+  // Where to resume the linear search when the cache has no candidates.
+  // Only moves forward, so the searches are linear overall
+  std::size_t searchCursor = 0u;
+
+  auto bestTriangle = static_cast<std::size_t>(-1);
+  auto bestScore = -1.0f;
+  for (std::size_t triangle = 0u; triangle < triangleCount; triangle++) {
+    if (triangleScores[triangle] > bestScore) {
+      bestScore = triangleScores[triangle];
+      bestTriangle = triangle;
+    }
+  }
+
+  for (std::size_t emittedCount = 0u; emittedCount < triangleCount; emittedCount++) {
+    if (bestTriangle == static_cast<std::size_t>(-1)) {
+      // Nothing in the cache has triangles left, take the next unemitted triangle
+      while (emitted[searchCursor])
+        searchCursor++;
+
+      bestTriangle = searchCursor;
+    }
+
+    emitted[bestTriangle] = true;
+    std::array<int, cacheSize + 3> newCache{};
+    newCache.fill(-1);
+    auto newCacheSize = 0u;
+
+    for (auto corner = 0u; corner < 3u; corner++) {
+      const auto index = indices[bestTriangle * 3u + corner];
+      output.emplace_back(index);
+      newCache[newCacheSize++] = static_cast<int>(index);
+
+      // Remove the emitted triangle from the vertex's list of remaining triangles
+      auto &vertex = vertices[index];
+      const auto begin = triangleLists.begin() + static_cast<std::ptrdiff_t>(vertex.triangleOffset);
+      const auto end = begin + vertex.remaining;
+      std::iter_swap(std::find(begin, end, bestTriangle), end - 1);
+      vertex.remaining--;
+    }
+
+    // The rest of the old cache follows the new triangle, in LRU order
+    for (const auto entry : cache) {
+      if (entry < 0)
+        break;
+
+      if (std::find(newCache.begin(), newCache.begin() + newCacheSize, entry) == newCache.begin() + newCacheSize)
+        newCache[newCacheSize++] = entry;
+    }
+
+    // Rescore everything which was in either cache,
+    // including the entries which just fell out of it
+    for (auto i = 0u; i < newCacheSize; i++) {
+      auto &vertex = vertices[static_cast<std::size_t>(newCache[i])];
+      vertex.cachePosition = i < static_cast<unsigned int>(cacheSize) ? static_cast<int>(i) : -1;
+
+      const auto newScore = vertexScore(vertex);
+      const auto difference = newScore - vertex.score;
+      vertex.score = newScore;
+
+      for (auto j = 0u; j < vertex.remaining; j++)
+        triangleScores[triangleLists[vertex.triangleOffset + j]] += difference;
+    }
+
+    // The next triangle is the best one using a cached vertex
+    bestTriangle = static_cast<std::size_t>(-1);
+    bestScore = -1.0f;
+    for (auto i = 0u; i < std::min(newCacheSize, static_cast<unsigned int>(cacheSize)); i++) {
+      const auto &vertex = vertices[static_cast<std::size_t>(newCache[i])];
+
+      for (auto j = 0u; j < vertex.remaining; j++) {
+        const auto triangle = triangleLists[vertex.triangleOffset + j];
+        if (triangleScores[triangle] > bestScore) {
+          bestScore = triangleScores[triangle];
+          bestTriangle = triangle;
+        }
+      }
+    }
+
+    cache.fill(-1);
+    std::copy(newCache.begin(), newCache.begin() + std::min(newCacheSize, static_cast<unsigned int>(cacheSize)),
+              cache.begin());
+  }
+
+  std::copy(output.begin(), output.end(), indices.begin());
+}
+
+} // namespace netsimulyzer
@@ -0,0 +1,94 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace netsimulyzer {
+
+/**
+ * Reorder the triangles of an indexed triangle list, so vertices are reused
+ * while they are still in the GPU's post-transform vertex cache.
+ *
+ * Uses Tom Forsyth's "Linear-Speed Vertex Cache Optimisation",
+ * which does not depend on the exact size of the hardware cache.
+ *
+ * @param indices
+ * The triangle list, three indices per triangle. Reordered in place.
+ * A trailing partial triangle is left where it is
+ *
+ * @param vertexCount
+ * The number of vertices `indices` refers to
+ */
+void optimizeVertexCache(std::vector<unsigned int> &indices, std::size_t vertexCount);
+
+/**
+ * Reorder vertices into the order the index buffer first uses them,
+ * so vertex fetches walk through memory mostly sequentially.
+ * Vertices no index refers to are dropped.
+ *
+ * Best run after `optimizeVertexCache()`
+ *
+ * @tparam T
+ * The vertex type
+ *
+ * @param vertices
+ * The vertices to reorder. Replaced with the reordered vertices
+ *
+ * @param indices
+ * The indices referring to `vertices`. Rewritten to refer to the new order
+ */
+template <class T>
+void optimizeVertexFetch(std::vector<T> &vertices, std::vector<unsigned int> &indices) {
+  constexpr auto unused = static_cast<unsigned int>(-1);
+  std::vector<unsigned int> remap(vertices.size(), unused);
+
+  std::vector<T> reordered;
+  reordered.reserve(vertices.size());
+
+  for (auto &index : indices) {
+    auto &newIndex = remap[index];
+    if (newIndex == unused) {
+      newIndex = static_cast<unsigned int>(reordered.size());
+      reordered.emplace_back(vertices[index]);
+    }
+
+    index = newIndex;
+  }
+
+  vertices = std::move(reordered);
+}
+
+} // namespace netsimulyzer
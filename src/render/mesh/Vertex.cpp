@@ -0,0 +1,124 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#include "Vertex.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+/**
+ * Pack a component in [-1.0, 1.0] as a 10 bit signed normalized integer
+ */
+std::uint32_t packSnorm10(float value) {
+  const auto scaled = static_cast<std::int32_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 511.0f));
+  return static_cast<std::uint32_t>(scaled) & 0x3FFu;
+}
+
+} // namespace
+
+namespace netsimulyzer {
+
+std::uint16_t toHalfFloat(float value) {
+  std::uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+
+  const auto sign = static_cast<std::uint16_t>((bits >> 16u) & 0x8000u);
+  const auto exponent = static_cast<std::int32_t>((bits >> 23u) & 0xFFu);
+  auto mantissa = bits & 0x7FFFFFu;
+
+  // NaN & infinity
+  if (exponent == 0xFF)
+    return sign | 0x7C00u | (mantissa ? 0x200u : 0u);
+
+  // Rebias from the float exponent (127) to the half exponent (15)
+  const auto halfExponent = exponent - 127 + 15;
+
+  // Too large, saturate to infinity
+  if (halfExponent >= 0x1F)
+    return sign | 0x7C00u;
+
+  // Too small for a normal half, produce a subnormal (or zero)
+  if (halfExponent <= 0) {
+    if (halfExponent < -10)
+      return sign;
+
+    mantissa |= 0x800000u;
+    const auto shift = static_cast<std::uint32_t>(14 - halfExponent);
+    auto half = mantissa >> shift;
+
+    // Round to nearest, ties to even
+    const auto remainder = mantissa & ((1u << shift) - 1u);
+    const auto halfway = 1u << (shift - 1u);
+    if (remainder > halfway || (remainder == halfway && (half & 1u)))
+      half++;
+
+    return sign | static_cast<std::uint16_t>(half);
+  }
+
+  auto half = (static_cast<std::uint32_t>(halfExponent) << 10u) | (mantissa >> 13u);
+
+  // Round to nearest, ties to even. A carry out of the mantissa
+  // correctly bumps the exponent (up to infinity)
+  const auto remainder = mantissa & 0x1FFFu;
+  if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u)))
+    half++;
+
+  return sign | static_cast<std::uint16_t>(half);
+}
+
+PackedVertex PackedVertex::pack(const Vertex &vertex) {
+  PackedVertex packed;
+  packed.position = vertex.position;
+
+  const auto &n = vertex.normal;
+  const auto length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+  if (length > 0.0f) {
+    packed.normal = packSnorm10(n[0] / length) | (packSnorm10(n[1] / length) << 10u) |
+                    (packSnorm10(n[2] / length) << 20u);
+  }
+
+  const auto &t = vertex.textureCoordinate;
+  assert(std::abs(t[0]) <= maxTextureCoordinate && std::abs(t[1]) <= maxTextureCoordinate &&
+         "Texture coordinate too large for a half float");
+
+  // Keep release builds finite, rather than saturating to infinity
+  packed.textureCoordinate = {toHalfFloat(std::clamp(t[0], -maxTextureCoordinate, maxTextureCoordinate)),
+                              toHalfFloat(std::clamp(t[1], -maxTextureCoordinate, maxTextureCoordinate))};
+
+  return packed;
+}
+
+} // namespace netsimulyzer
@@ -33,6 +33,7 @@
 
 #pragma once
 #include <array>
+#include <cstdint>
 
 namespace netsimulyzer {
 
@@ -42,4 +43,47 @@ struct Vertex {
   std::array<float, 2> textureCoordinate{0.0f, 0.0f};
 };
 
+/**
+ * The layout of `Vertex` uploaded to the GPU.
+ *
+ * 20 bytes, rather than the 32 of `Vertex`.
+ * The position stays full precision, while the normal is
+ * packed as signed normalized 10:10:10:2 (`GL_INT_2_10_10_10_REV`)
+ * and the texture coordinate as half floats (`GL_HALF_FLOAT`).
+ * The shaders see the same `vec3`/`vec2` attributes either way.
+ */
+struct PackedVertex {
+  std::array<float, 3> position;
+  std::uint32_t normal = 0u;
+  std::array<std::uint16_t, 2> textureCoordinate{0u, 0u};
+
+  /**
+   * The largest magnitude of a texture coordinate that may be packed.
+   * The largest finite half float
+   */
+  static constexpr float maxTextureCoordinate = 65504.0f;
+
+  /**
+   * Convert a vertex into the GPU layout
+   *
+   * @param vertex
+   * The vertex to convert. The normal does not need to be unit length,
+   * but only its direction is kept. Texture coordinates must be within
+   * `maxTextureCoordinate`; larger values are clamped to it
+   */
+  [[nodiscard]] static PackedVertex pack(const Vertex &vertex);
+};
+
+/**
+ * Convert a float to an IEEE 754 half precision float.
+ * Rounds to the nearest value, and saturates to infinity
+ *
+ * @param value
+ * The value to convert
+ *
+ * @return
+ * The bits of the half float
+ */
+[[nodiscard]] std::uint16_t toHalfFloat(float value);
+
 } // namespace netsimulyzer
@@ -32,58 +32,119 @@
  */
 
 #include "ModelCache.h"
+#include "../mesh/MeshOptimizer.h"
 #include "../shader/Shader.h"
 #include <QDebug>
 #include <QFileInfo>
+#include <QRunnable>
+#include <QThreadPool>
 #include <algorithm>
+#include <assimp/DefaultIOSystem.h>
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 #include <cstring>
+#include <functional>
 #include <iostream>
+#include <string>
+#include <trace.h>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
-namespace netsimulyzer {
+namespace {
 
-void ModelRenderInfo::updateBounds() {
-  if (!meshes.empty()) {
-    const auto &firstBounds = meshes.front().getBounds();
-    bounds.min = firstBounds.min;
-    bounds.max = firstBounds.max;
-  }
+/**
+ * Reads from the filesystem as Assimp normally does,
+ * but remembers each file successfully opened
+ */
+class RecordingIOSystem : public Assimp::DefaultIOSystem {
+  std::vector<std::string> opened;
 
-  for (const auto &mesh : meshes) {
-    const auto &meshBounds = mesh.getBounds();
-    bounds.max.x = std::max(bounds.max.x, meshBounds.max.x);
-    bounds.min.x = std::min(bounds.min.x, meshBounds.min.x);
+public:
+  Assimp::IOStream *Open(const char *pFile, const char *pMode = "rb") override {
+    auto stream = Assimp::DefaultIOSystem::Open(pFile, pMode);
+    if (!stream)
+      return stream;
 
-    bounds.max.y = std::max(bounds.max.y, meshBounds.max.y);
-    bounds.min.y = std::min(bounds.min.y, meshBounds.min.y);
+    auto path = QFileInfo{QString::fromUtf8(pFile)}.absoluteFilePath().toStdString();
+    if (std::find(opened.begin(), opened.end(), path) == opened.end())
+      opened.emplace_back(std::move(path));
 
-    bounds.max.z = std::max(bounds.max.z, meshBounds.max.z);
-    bounds.min.z = std::min(bounds.min.z, meshBounds.min.z);
+    return stream;
   }
-}
 
-void ModelRenderInfo::loadNode(aiNode const *node, aiScene const *scene) {
-  for (auto i = 0u; i < node->mNumMeshes; i++) {
-    loadMesh(scene->mMeshes[node->mMeshes[i]], scene);
+  /**
+   * @return
+   * The absolute paths of every file opened, in the order they were first opened
+   */
+  [[nodiscard]] const std::vector<std::string> &getOpened() const {
+    return opened;
   }
+};
 
-  for (auto i = 0u; i < node->mNumChildren; i++) {
-    loadNode(node->mChildren[i], scene);
+void importMaterials(aiScene const *scene, netsimulyzer::ModelData &data) {
+  using MaterialType = netsimulyzer::Material::MaterialType;
+  data.materials.reserve(scene->mNumMaterials);
+
+  for (auto i = 0u; i < scene->mNumMaterials; i++) {
+    auto const *material = scene->mMaterials[i];
+    netsimulyzer::ModelData::MaterialData materialData;
+    auto &m = materialData.material;
+
+    material->Get(AI_MATKEY_OPACITY, m.opacity);
+
+    aiString name;
+    material->Get(AI_MATKEY_NAME, name);
+
+    // Check for configurable materials
+    if (std::strcmp(name.data, "netsimulyzer.base") == 0) {
+      m.materialType = MaterialType::Base;
+    } else if (std::strcmp(name.data, "netsimulyzer.highlight") == 0)
+      m.materialType = MaterialType::Highlight;
+    else
+      m.materialType = MaterialType::Unclassified;
+
+    if (material->GetTextureCount(aiTextureType_DIFFUSE)) {
+      aiString path;
+
+      if (material->GetTexture(aiTextureType_DIFFUSE, 0, &path) == AI_SUCCESS) {
+        std::string pathCppString{path.data};
+        // Strips back to the last '\' character (i.e. 'C:\Users\Evan\projects' -> 'projects')
+        materialData.texturePath = pathCppString.substr(pathCppString.rfind('\\') + 1);
+      } else {
+        // Empty path, use the fallback texture
+        materialData.texturePath = std::string{};
+      }
+    } else {
+      aiColor3D color;
+
+      // Diffuse diffuse & transparent color are separate for some reason...
+      if (m.opacity < 1.0f)
+        material->Get(AI_MATKEY_COLOR_TRANSPARENT, color);
+      else
+        material->Get(AI_MATKEY_COLOR_DIFFUSE, color);
+
+      m.color = {color.r, color.g, color.b};
+    }
+
+    material->Get(AI_MATKEY_SHININESS, m.shininess);                  // Errors Ignored
+    material->Get(AI_MATKEY_SHININESS_STRENGTH, m.specularIntensity); // Errors Ignored
+
+    data.materials.emplace_back(std::move(materialData));
   }
 }
 
-void ModelRenderInfo::loadMesh(aiMesh const *m, aiScene const *) {
-  std::vector<Vertex> vertices;
+void importMesh(aiMesh const *m, netsimulyzer::ModelData &data) {
+  std::vector<netsimulyzer::Vertex> vertices;
   vertices.reserve(m->mNumVertices);
 
   std::vector<unsigned int> indices;
+  indices.reserve(static_cast<std::size_t>(m->mNumFaces) * 3u);
 
   for (auto i = 0u; i < m->mNumVertices; i++) {
-    Vertex v;
+    netsimulyzer::Vertex v;
     v.position = {m->mVertices[i].x, m->mVertices[i].y, m->mVertices[i].z};
 
     // if we have at least one texture
@@ -106,82 +167,134 @@ void ModelRenderInfo::loadMesh(aiMesh const *m, aiScene const *) {
     }
   }
 
-  const auto &material = materials[m->mMaterialIndex];
-  if (material.opacity < 1.0f)
-    transparentMeshes.emplace_back(vertices.data(), indices.data(), vertices.size(), indices.size())
-        .setMaterial(material);
-  else
-    meshes.emplace_back(vertices.data(), indices.data(), vertices.size(), indices.size()).setMaterial(material);
+  // Post processing, done once here (and stored in the disk cache)
+  // rather than on every upload
+  netsimulyzer::optimizeVertexCache(indices, vertices.size());
+  netsimulyzer::optimizeVertexFetch(vertices, indices);
+
+  auto &mesh = data.meshes.emplace_back();
+  mesh.materialIndex = m->mMaterialIndex;
+  mesh.indices = std::move(indices);
+  mesh.vertices.reserve(vertices.size());
+  for (const auto &vertex : vertices) {
+    mesh.vertices.emplace_back(netsimulyzer::PackedVertex::pack(vertex));
+  }
 }
 
-ModelRenderInfo::ModelRenderInfo(aiScene const *scene, TextureCache &textureCache) : textureCache(textureCache) {
-  initializeOpenGLFunctions();
-  loadMaterials(scene);
-  loadNode(scene->mRootNode, scene);
+void importNode(aiNode const *node, aiScene const *scene, netsimulyzer::ModelData &data) {
+  for (auto i = 0u; i < node->mNumMeshes; i++) {
+    importMesh(scene->mMeshes[node->mMeshes[i]], data);
+  }
 
-  updateBounds();
+  for (auto i = 0u; i < node->mNumChildren; i++) {
+    importNode(node->mChildren[i], scene, data);
+  }
 }
 
-ModelRenderInfo::ModelRenderInfo(std::vector<Mesh> meshes, TextureCache &textureCache)
-    : meshes(std::move(meshes)), textureCache(textureCache) {
-  initializeOpenGLFunctions();
+/**
+ * Find the bounds of the opaque meshes of `data`,
+ * matching the bounds `Mesh` calculates on upload
+ */
+void computeBounds(netsimulyzer::ModelData &data) {
+  bool first = true;
+  for (const auto &mesh : data.meshes) {
+    if (data.materials[mesh.materialIndex].material.opacity < 1.0f || mesh.vertices.empty())
+      continue;
+
+    for (const auto &vertex : mesh.vertices) {
+      const glm::vec3 position{vertex.position[0], vertex.position[1], vertex.position[2]};
+      if (first) {
+        data.bounds.min = position;
+        data.bounds.max = position;
+        first = false;
+        continue;
+      }
 
-  updateBounds();
+      data.bounds.min = glm::min(data.bounds.min, position);
+      data.bounds.max = glm::max(data.bounds.max, position);
+    }
+  }
 }
 
-ModelRenderInfo::~ModelRenderInfo() {
-  clear();
-}
+/**
+ * Runs a single model import on a `QThreadPool`
+ */
+class ImportTask : public QRunnable {
+  std::function<void()> work;
 
-void ModelRenderInfo::loadMaterials(aiScene const *scene) {
-  using MaterialType = Material::MaterialType;
-  auto fallbackTexture = textureCache.getFallbackTexture();
+public:
+  explicit ImportTask(std::function<void()> work) : work(std::move(work)) {
+  }
 
-  for (auto i = 0u; i < scene->mNumMaterials; i++) {
-    auto const *material = scene->mMaterials[i];
-    Material m;
+  void run() override {
+    work();
+  }
+};
 
-    material->Get(AI_MATKEY_OPACITY, m.opacity);
+} // namespace
 
-    aiString name;
-    material->Get(AI_MATKEY_NAME, name);
+namespace netsimulyzer {
 
-    // Check for configurable materials
-    if (std::strcmp(name.data, "netsimulyzer.base") == 0) {
-      m.materialType = MaterialType::Base;
-    } else if (std::strcmp(name.data, "netsimulyzer.highlight") == 0)
-      m.materialType = MaterialType::Highlight;
-    else
-      m.materialType = MaterialType::Unclassified;
+void ModelRenderInfo::updateBounds() {
+  if (!meshes.empty()) {
+    const auto &firstBounds = meshes.front().getBounds();
+    bounds.min = firstBounds.min;
+    bounds.max = firstBounds.max;
+  }
 
-    if (material->GetTextureCount(aiTextureType_DIFFUSE)) {
-      aiString path;
+  for (const auto &mesh : meshes) {
+    const auto &meshBounds = mesh.getBounds();
+    bounds.max.x = std::max(bounds.max.x, meshBounds.max.x);
+    bounds.min.x = std::min(bounds.min.x, meshBounds.min.x);
 
-      if (material->GetTexture(aiTextureType_DIFFUSE, 0, &path) == AI_SUCCESS) {
-        std::string pathCppString{path.data};
-        // Strips back to the last '\' character (i.e. 'C:\Users\Evan\projects' -> 'projects')
-        auto filepath = pathCppString.substr(pathCppString.rfind('\\') + 1);
-        m.textureId = textureCache.load(filepath);
-      } else {
-        m.textureId = fallbackTexture;
-      }
-    } else {
-      aiColor3D color;
+    bounds.max.y = std::max(bounds.max.y, meshBounds.max.y);
+    bounds.min.y = std::min(bounds.min.y, meshBounds.min.y);
 
-      // Diffuse diffuse & transparent color are separate for some reason...
-      if (m.opacity < 1.0f)
-        material->Get(AI_MATKEY_COLOR_TRANSPARENT, color);
-      else
-        material->Get(AI_MATKEY_COLOR_DIFFUSE, color);
+    bounds.max.z = std::max(bounds.max.z, meshBounds.max.z);
+    bounds.min.z = std::min(bounds.min.z, meshBounds.min.z);
+  }
+}
 
-      m.color = {color.r, color.g, color.b};
+ModelRenderInfo::ModelRenderInfo(ModelData data, TextureCache &textureCache) : textureCache(textureCache) {
+  initializeOpenGLFunctions();
+
+  materials.reserve(data.materials.size());
+  for (const auto &materialData : data.materials) {
+    auto material = materialData.material;
+
+    if (materialData.texturePath) {
+      if (materialData.texturePath->empty())
+        material.textureId = textureCache.getFallbackTexture();
+      else
+        material.textureId = textureCache.load(*materialData.texturePath);
     }
 
-    material->Get(AI_MATKEY_SHININESS, m.shininess);                  // Errors Ignored
-    material->Get(AI_MATKEY_SHININESS_STRENGTH, m.specularIntensity); // Errors Ignored
+    materials.emplace_back(material);
+  }
+
+  for (auto &mesh : data.meshes) {
+    const auto &material = materials[mesh.materialIndex];
+    auto &target = material.opacity < 1.0f ? transparentMeshes : meshes;
 
-    materials.emplace_back(m);
+    target
+        .emplace_back(mesh.vertices.data(), mesh.indices.data(), static_cast<unsigned int>(mesh.vertices.size()),
+                      static_cast<int>(mesh.indices.size()))
+        .setMaterial(material);
   }
+
+  bounds.min = data.bounds.min;
+  bounds.max = data.bounds.max;
+}
+
+ModelRenderInfo::ModelRenderInfo(std::vector<Mesh> meshes, TextureCache &textureCache)
+    : meshes(std::move(meshes)), textureCache(textureCache) {
+  initializeOpenGLFunctions();
+
+  updateBounds();
+}
+
+ModelRenderInfo::~ModelRenderInfo() {
+  clear();
 }
 
 const ModelRenderInfo::ModelRenderBounds &ModelRenderInfo::getBounds() const {
@@ -192,6 +305,10 @@ bool ModelRenderInfo::hasTransparentMeshes() const {
   return !transparentMeshes.empty();
 }
 
+const std::vector<Mesh> &ModelRenderInfo::getMeshes() const {
+  return meshes;
+}
+
 void ModelRenderInfo::render(Shader &s, const Model &model) {
   for (auto &m : meshes) {
     // Operator [] for unordered map is not const...
@@ -261,18 +378,19 @@ void ModelRenderInfo::clear() {
   meshes.clear();
 }
 
-ModelCache::ModelCache(TextureCache &textureCache) : textureCache(textureCache) {
+ModelCache::ModelCache(TextureCache &textureCache, ResourceIndex &resources)
+    : textureCache(textureCache), resources(resources) {
 }
 
 ModelCache::~ModelCache() {
   clear();
 }
 
-void ModelCache::setBasePath(std::string value) {
-  basePath = std::move(value);
+std::string ModelCache::resolve(const std::string &path) {
+  if (const auto indexed = resources.findRelative(path))
+    return indexed->toStdString();
 
-  if (basePath.back() != '/')
-    basePath.push_back('/');
+  return resources.getRoot().filePath(QString::fromStdString(path)).toStdString();
 }
 
 void ModelCache::init(const std::string &fallbackModelPath) {
@@ -280,21 +398,61 @@ void ModelCache::init(const std::string &fallbackModelPath) {
   load(fallbackModelPath);
 }
 
-Model::ModelLoadInfo ModelCache::load(const std::string &path) {
-  auto fullPath = basePath + path;
+std::optional<ModelData> ModelCache::import(const std::string &fullPath, std::string &error) const {
+  NETSIMULYZER_TRACE_SCOPE("ModelCache::import");
+  if (auto cached = diskCache.read(fullPath))
+    return cached;
 
-  auto existing = indexMap.find(fullPath);
-  if (existing != indexMap.end()) {
-    const auto &bounds = get(existing->second).getBounds();
-    return {existing->second, bounds.min, bounds.max};
-  }
+  // Taken before the import, so a model changed while importing is not cached as the new version
+  const auto cacheKey = ModelDiskCache::key(fullPath);
 
   Assimp::Importer importer;
+
+  // Owned by `importer`
+  auto ioSystem = new RecordingIOSystem;
+  importer.SetIOHandler(ioSystem);
+
   const auto *const scene =
       importer.ReadFile(fullPath.c_str(), aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_GenSmoothNormals |
                                               aiProcess_JoinIdenticalVertices);
   if (!scene) {
-    std::cerr << "Model (" << fullPath << ") failed to load: " << importer.GetErrorString() << '\n';
+    error = importer.GetErrorString();
+    return {};
+  }
+
+  ModelData data;
+  importMaterials(scene, data);
+  importNode(scene->mRootNode, scene, data);
+  computeBounds(data);
+
+  if (!cacheKey)
+    return data;
+
+  // Record every other file the import read (e.g. material libraries),
+  // so the entry is invalidated if any of them change
+  std::vector<ModelDiskCache::Key> files{*cacheKey};
+  for (const auto &path : ioSystem->getOpened()) {
+    if (path == cacheKey->path)
+      continue;
+
+    const auto key = ModelDiskCache::key(path);
+
+    // Without a key the entry could not be checked later, so don't cache it
+    if (!key)
+      return data;
+
+    files.emplace_back(*key);
+  }
+
+  diskCache.write(fullPath, files, data);
+  return data;
+}
+
+Model::ModelLoadInfo ModelCache::upload(const std::string &fullPath, std::optional<ModelData> data,
+                                        const std::string &error) {
+  NETSIMULYZER_TRACE_SCOPE("ModelCache::upload");
+  if (!data) {
+    std::cerr << "Model (" << fullPath << ") failed to load: " << error << '\n';
 
     // Make sure we have a fallback model
     if (models.empty()) {
@@ -302,17 +460,82 @@ Model::ModelLoadInfo ModelCache::load(const std::string &path) {
       std::abort();
     }
 
+    // Remember the failure, so later loads of the same model
+    // do not attempt the import again
+    indexMap.emplace(fullPath, fallbackModel);
+
     const auto &bounds = get(fallbackModel).getBounds();
     return {fallbackModel, bounds.min, bounds.max};
   }
 
-  const auto &newModel = models.emplace_back(scene, textureCache);
+  const auto &newModel = models.emplace_back(std::move(*data), textureCache);
   indexMap.emplace(fullPath, models.size() - 1);
 
   const auto bounds = newModel.getBounds();
   return {models.size() - 1, bounds.min, bounds.max};
 }
 
+void ModelCache::preload(const std::vector<std::string> &paths) {
+  NETSIMULYZER_TRACE_SCOPE("ModelCache::preload");
+  std::vector<std::string> pending;
+  std::unordered_set<std::string> seen;
+  for (const auto &path : paths) {
+    auto fullPath = resolve(path);
+    if (indexMap.find(fullPath) != indexMap.end() || !seen.insert(fullPath).second)
+      continue;
+
+    pending.emplace_back(std::move(fullPath));
+  }
+
+  if (pending.empty())
+    return;
+
+  std::vector<std::optional<ModelData>> results(pending.size());
+  std::vector<std::string> errors(pending.size());
+
+  QThreadPool pool;
+  for (auto i = 0u; i < pending.size(); i++) {
+    // The pool deletes the task once it is done
+    pool.start(new ImportTask{[&, i]() { results[i] = import(pending[i], errors[i]); }});
+  }
+  pool.waitForDone();
+
+  // Decode every texture the models use together,
+  // so the uploads below find them already loaded
+  std::vector<std::string> texturePaths;
+  for (const auto &result : results) {
+    if (!result)
+      continue;
+
+    for (const auto &material : result->materials) {
+      if (material.texturePath && !material.texturePath->empty())
+        texturePaths.emplace_back(*material.texturePath);
+    }
+  }
+  textureCache.preload(texturePaths);
+
+  // Upload in request order, so model IDs do not depend on which import
+  // happens to finish first
+  for (auto i = 0u; i < pending.size(); i++) {
+    upload(pending[i], std::move(results[i]), errors[i]);
+  }
+}
+
+Model::ModelLoadInfo ModelCache::load(const std::string &path) {
+  NETSIMULYZER_TRACE_SCOPE("ModelCache::load");
+  auto fullPath = resolve(path);
+
+  auto existing = indexMap.find(fullPath);
+  if (existing != indexMap.end()) {
+    const auto &bounds = get(existing->second).getBounds();
+    return {existing->second, bounds.min, bounds.max};
+  }
+
+  std::string error;
+  auto data = import(fullPath, error);
+  return upload(fullPath, std::move(data), error);
+}
+
 ModelRenderInfo &ModelCache::get(model_id index) {
   return models[index];
 }
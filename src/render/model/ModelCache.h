@@ -33,14 +33,16 @@
 
 #pragma once
 #include "../mesh/Mesh.h"
+#include "../resource/ResourceIndex.h"
 #include "../shader/Shader.h"
 #include "../texture/TextureCache.h"
 #include "../texture/texture.h"
 #include "Model.h"
+#include "ModelData.h"
+#include "ModelDiskCache.h"
 #include <QOpenGLFunctions_3_3_Core>
-#include <assimp/Importer.hpp>
-#include <assimp/scene.h>
 #include <glm/glm.hpp>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -64,13 +66,20 @@ private:
 
   void updateBounds();
 
-  void loadNode(aiNode const *node, aiScene const *scene);
-  void loadMesh(aiMesh const *m, aiScene const *scene);
-  void loadMaterials(aiScene const *scene);
-
 public:
   ~ModelRenderInfo() override;
-  ModelRenderInfo(aiScene const *scene, TextureCache &textureCache);
+
+  /**
+   * Upload an imported model.
+   * Must be called with the GL context current.
+   *
+   * @param data
+   * The imported model. Consumed by the upload
+   *
+   * @param textureCache
+   * The cache to load the model's textures into
+   */
+  ModelRenderInfo(ModelData data, TextureCache &textureCache);
   ModelRenderInfo(std::vector<Mesh> meshes, TextureCache &textureCache);
 
   // Allow Moves
@@ -90,6 +99,12 @@ public:
   [[nodiscard]] const ModelRenderBounds &getBounds() const;
   [[nodiscard]] bool hasTransparentMeshes() const;
 
+  /**
+   * @return
+   * The opaque meshes of the model
+   */
+  [[nodiscard]] const std::vector<Mesh> &getMeshes() const;
+
   void render(Shader &s, const Model &model);
   void renderTransparent(Shader &s, const Model &model);
   void clear();
@@ -99,15 +114,88 @@ class ModelCache : protected QOpenGLFunctions_3_3_Core {
   std::unordered_map<std::string, std::size_t> indexMap;
   std::vector<ModelRenderInfo> models;
   TextureCache &textureCache;
-  std::string basePath;
+  ResourceIndex &resources;
+
+  /**
+   * Previously imported models, so unchanged models skip Assimp
+   */
+  ModelDiskCache diskCache;
+
+  /**
+   * Find the file for a model
+   *
+   * @param path
+   * The path to the model, relative to the resource directory
+   *
+   * @return
+   * The absolute path to the model, or `path` under the resource directory
+   * if it is not in the index, so the import reports the failure
+   */
+  [[nodiscard]] std::string resolve(const std::string &path);
+
+  /**
+   * Read a model from disk into CPU-side data.
+   * Uses the disk cache entry for the model if it is still valid,
+   * otherwise imports the model with Assimp and stores the result in the disk cache.
+   *
+   * Only reads immutable state, so it is safe to call from any thread
+   *
+   * @param fullPath
+   * The resolved path to the model file
+   *
+   * @param error
+   * Set to the reason the import failed, if it did
+   *
+   * @return
+   * The imported model, or an unset optional if the import failed
+   */
+  std::optional<ModelData> import(const std::string &fullPath, std::string &error) const;
+
+  /**
+   * Upload an imported model and record it under `fullPath`.
+   * If the import failed, `fullPath` is mapped to the fallback model instead
+   *
+   * @param fullPath
+   * The resolved path the model was imported from
+   *
+   * @param data
+   * The result of `import()` for `fullPath`
+   *
+   * @param error
+   * The error from `import()`, reported if `data` is unset
+   *
+   * @return
+   * The ID & bounds of the uploaded model, or of the fallback model
+   */
+  Model::ModelLoadInfo upload(const std::string &fullPath, std::optional<ModelData> data, const std::string &error);
 
 public:
   const model_id fallbackModel = 0u;
-  explicit ModelCache(TextureCache &textureCache);
+  /**
+   * @param textureCache
+   * The cache for model textures
+   *
+   * @param resources
+   * The index models are found through
+   */
+  ModelCache(TextureCache &textureCache, ResourceIndex &resources);
   ~ModelCache() override;
 
-  void setBasePath(std::string value);
   void init(const std::string &fallbackModelPath);
+
+  /**
+   * Import every model in `paths` that is not already cached on a thread pool,
+   * decode the textures they use (also in parallel), then upload the models.
+   *
+   * Only the upload touches the GL context, so this must be called with
+   * the context current, but the (much slower) imports & decodes run in parallel.
+   * Later calls to `load()` with any of these paths are cache hits.
+   *
+   * @param paths
+   * The model paths, relative to the resource directory. May contain duplicates
+   */
+  void preload(const std::vector<std::string> &paths);
+
   Model::ModelLoadInfo load(const std::string &path);
   ModelRenderInfo &get(model_id index);
 
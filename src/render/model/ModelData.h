@@ -0,0 +1,94 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+#include "../material/material.h"
+#include "../mesh/Vertex.h"
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace netsimulyzer {
+
+/**
+ * A model read from disk, but not yet uploaded to the GPU.
+ *
+ * Contains no OpenGL objects, so it may be produced on any thread.
+ * Converted into a `ModelRenderInfo` on the thread owning the GL context.
+ */
+struct ModelData {
+  struct MaterialData {
+    /**
+     * The material, with `textureId` unset, since textures
+     * are only loaded once the model is uploaded
+     */
+    Material material;
+
+    /**
+     * The diffuse texture for this material, relative to the texture cache's base path.
+     * An empty path means the model references a texture we could not read,
+     * and the fallback texture should be used
+     */
+    std::optional<std::string> texturePath;
+  };
+
+  struct MeshData {
+    /**
+     * Vertices in the GPU layout, in the order the indices first use them
+     */
+    std::vector<PackedVertex> vertices;
+
+    /**
+     * Triangle list, ordered for the post-transform vertex cache
+     */
+    std::vector<unsigned int> indices;
+    std::size_t materialIndex = 0u;
+  };
+
+  struct Bounds {
+    glm::vec3 min{0.0f};
+    glm::vec3 max{0.0f};
+  };
+
+  std::vector<MaterialData> materials;
+  std::vector<MeshData> meshes;
+
+  /**
+   * The bounds of the opaque meshes of the model
+   */
+  Bounds bounds;
+};
+
+} // namespace netsimulyzer
@@ -0,0 +1,259 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#include "ModelDiskCache.h"
+#include "../resource/CacheEntry.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/**
+ * Identifies a model cache entry file
+ */
+constexpr std::array<char, 4> magic{'N', 'S', 'M', 'C'};
+
+/**
+ * Increment whenever the entry layout,
+ * or the layout of `PackedVertex`/`Material`, changes
+ */
+constexpr std::uint32_t formatVersion = 3u;
+
+/**
+ * The fewest bytes a material takes in an entry (one without a texture path)
+ */
+constexpr std::size_t minimumMaterialSize = 3u * sizeof(float) + sizeof(std::uint8_t) + sizeof(glm::vec3) + 2u;
+
+/**
+ * The fewest bytes a mesh takes in an entry (one without vertices or indices)
+ */
+constexpr std::size_t minimumMeshSize = 3u * sizeof(std::uint32_t);
+
+} // namespace
+
+namespace netsimulyzer {
+
+QString ModelDiskCache::entryPath(const std::string &fullPath) const {
+  const auto absolutePath = QFileInfo{QString::fromStdString(fullPath)}.absoluteFilePath();
+  const auto name = QCryptographicHash::hash(absolutePath.toUtf8(), QCryptographicHash::Sha1).toHex();
+
+  return QDir{directory}.filePath(QString::fromLatin1(name) + ".mesh");
+}
+
+ModelDiskCache::ModelDiskCache()
+    : ModelDiskCache(QDir{QStandardPaths::writableLocation(QStandardPaths::CacheLocation)}.filePath("models")) {
+}
+
+ModelDiskCache::ModelDiskCache(QString directory) : directory(std::move(directory)) {
+}
+
+std::optional<ModelDiskCache::Key> ModelDiskCache::key(const std::string &path) {
+  QFile file{QString::fromStdString(path)};
+  if (!file.open(QIODevice::ReadOnly))
+    return {};
+
+  QCryptographicHash hash{QCryptographicHash::Sha1};
+  if (!hash.addData(&file))
+    return {};
+
+  const QFileInfo info{file};
+  return Key{info.absoluteFilePath().toStdString(), info.lastModified().toMSecsSinceEpoch(), info.size(),
+             hash.result()};
+}
+
+std::optional<ModelData> ModelDiskCache::read(const std::string &fullPath) const {
+  if (directory.isEmpty())
+    return {};
+
+  QFile file{entryPath(fullPath)};
+  if (!file.open(QIODevice::ReadOnly))
+    return {};
+
+  const auto size = file.size();
+  const auto *mapped = file.map(0, size);
+  if (!mapped)
+    return {};
+
+  EntryReader reader{mapped, size};
+
+  std::array<char, 4> entryMagic{};
+  std::uint32_t version;
+  std::uint32_t vertexSize;
+  std::uint32_t fileCount;
+  if (!reader.value(entryMagic) || entryMagic != magic || !reader.value(version) || version != formatVersion ||
+      !reader.value(vertexSize) || vertexSize != sizeof(PackedVertex) || !reader.value(fileCount))
+    return {};
+
+  // Any change to a file the model was imported from invalidates the entry
+  for (auto i = 0u; i < fileCount; i++) {
+    Key recorded;
+    std::string hash;
+    if (!reader.string(recorded.path) || !reader.value(recorded.modified) || !reader.value(recorded.size) ||
+        !reader.string(hash))
+      return {};
+
+    // Check the cheap parts first, so only unchanged files are hashed
+    const QFileInfo info{QString::fromStdString(recorded.path)};
+    if (!info.exists() || info.lastModified().toMSecsSinceEpoch() != recorded.modified ||
+        info.size() != recorded.size)
+      return {};
+
+    const auto current = key(recorded.path);
+    if (!current || current->hash != QByteArray::fromStdString(hash))
+      return {};
+  }
+
+  ModelData data;
+  std::uint32_t materialCount;
+  std::uint32_t meshCount;
+  if (!reader.value(data.bounds.min) || !reader.value(data.bounds.max) || !reader.value(materialCount) ||
+      !reader.value(meshCount) || !reader.fits(materialCount, minimumMaterialSize) ||
+      !reader.fits(meshCount, minimumMeshSize))
+    return {};
+
+  data.materials.resize(materialCount);
+  for (auto &materialData : data.materials) {
+    auto &material = materialData.material;
+    std::uint8_t hasColor;
+    glm::vec3 color;
+    std::uint8_t materialType;
+    std::uint8_t hasTexturePath;
+
+    if (!reader.value(material.specularIntensity) || !reader.value(material.shininess) ||
+        !reader.value(material.opacity) || !reader.value(hasColor) || !reader.value(color) ||
+        !reader.value(materialType) || !reader.value(hasTexturePath))
+      return {};
+
+    if (materialType > static_cast<std::uint8_t>(Material::MaterialType::Highlight))
+      return {};
+
+    if (hasColor)
+      material.color = color;
+    material.materialType = static_cast<Material::MaterialType>(materialType);
+
+    if (hasTexturePath && !reader.string(materialData.texturePath.emplace()))
+      return {};
+  }
+
+  data.meshes.resize(meshCount);
+  for (auto &mesh : data.meshes) {
+    std::uint32_t materialIndex;
+    std::uint32_t vertexCount;
+    std::uint32_t indexCount;
+    if (!reader.value(materialIndex) || materialIndex >= materialCount || !reader.value(vertexCount) ||
+        !reader.value(indexCount) || !reader.array(mesh.vertices, vertexCount) ||
+        !reader.array(mesh.indices, indexCount))
+      return {};
+
+    // Never hand the GPU an index outside of the mesh
+    if (std::any_of(mesh.indices.begin(), mesh.indices.end(), [vertexCount](unsigned int index) {
+          return index >= vertexCount;
+        }))
+      return {};
+
+    mesh.materialIndex = materialIndex;
+  }
+
+  return data;
+}
+
+void ModelDiskCache::write(const std::string &fullPath, const std::vector<Key> &files, const ModelData &data) const {
+  if (directory.isEmpty())
+    return;
+
+  if (!QDir{}.mkpath(directory)) {
+    std::cerr << "Failed to create model cache directory: " << directory.toStdString() << '\n';
+    return;
+  }
+
+  QByteArray buffer;
+  EntryWriter writer{buffer};
+
+  writer.value(magic);
+  writer.value(formatVersion);
+  writer.value(static_cast<std::uint32_t>(sizeof(PackedVertex)));
+  writer.value(static_cast<std::uint32_t>(files.size()));
+
+  for (const auto &key : files) {
+    writer.string(key.path);
+    writer.value(key.modified);
+    writer.value(key.size);
+    writer.string(key.hash.toStdString());
+  }
+
+  writer.value(data.bounds.min);
+  writer.value(data.bounds.max);
+  writer.value(static_cast<std::uint32_t>(data.materials.size()));
+  writer.value(static_cast<std::uint32_t>(data.meshes.size()));
+
+  for (const auto &materialData : data.materials) {
+    const auto &material = materialData.material;
+    writer.value(material.specularIntensity);
+    writer.value(material.shininess);
+    writer.value(material.opacity);
+    writer.value(static_cast<std::uint8_t>(material.color.has_value()));
+    writer.value(material.color.value_or(glm::vec3{0.0f}));
+    writer.value(static_cast<std::uint8_t>(material.materialType));
+    writer.value(static_cast<std::uint8_t>(materialData.texturePath.has_value()));
+
+    if (materialData.texturePath)
+      writer.string(*materialData.texturePath);
+  }
+
+  for (const auto &mesh : data.meshes) {
+    writer.value(static_cast<std::uint32_t>(mesh.materialIndex));
+    writer.value(static_cast<std::uint32_t>(mesh.vertices.size()));
+    writer.value(static_cast<std::uint32_t>(mesh.indices.size()));
+    writer.bytes(mesh.vertices.data(), sizeof(PackedVertex) * mesh.vertices.size());
+    writer.bytes(mesh.indices.data(), sizeof(unsigned int) * mesh.indices.size());
+  }
+
+  // Written to a temporary file first, so a reader never sees a partial entry
+  QSaveFile file{entryPath(fullPath)};
+  if (!file.open(QIODevice::WriteOnly) || file.write(buffer) != buffer.size() || !file.commit())
+    std::cerr << "Failed to write model cache entry for: " << fullPath << '\n';
+}
+
+} // namespace netsimulyzer
@@ -0,0 +1,142 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+#include "ModelData.h"
+#include <QByteArray>
+#include <QString>
+#include <QtGlobal>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace netsimulyzer {
+
+/**
+ * On-disk cache of imported models.
+ *
+ * Stores the processed `ModelData` for a model file,
+ * so later runs skip Assimp entirely. Entries are keyed by the model's path,
+ * and record every file read by the import (e.g. the model & its material libraries).
+ * An entry is only used while the modification time, size,
+ * and content hash of each of those files match those recorded in the entry.
+ *
+ * All methods are const & touch only the filesystem,
+ * so the cache may be used from several import threads at once,
+ * so long as each thread works on a different model.
+ */
+class ModelDiskCache {
+public:
+  /**
+   * Identifies a specific version of a file read by an import
+   */
+  struct Key {
+    /**
+     * The absolute path to the file
+     */
+    std::string path;
+    qint64 modified = 0;
+    qint64 size = 0;
+    QByteArray hash;
+  };
+
+private:
+  /**
+   * Directory the cache entries are stored in.
+   * Empty if the cache is disabled
+   */
+  QString directory;
+
+  /**
+   * Finds the entry file for a model
+   *
+   * @param fullPath
+   * The resolved path to the model file
+   */
+  [[nodiscard]] QString entryPath(const std::string &fullPath) const;
+
+public:
+  /**
+   * Use the platform's cache location
+   */
+  ModelDiskCache();
+
+  /**
+   * @param directory
+   * The directory to store entries in. May not exist yet.
+   * An empty directory disables the cache
+   */
+  explicit ModelDiskCache(QString directory);
+
+  /**
+   * Build the key for the current version of a file
+   *
+   * @param path
+   * The path to the file
+   *
+   * @return
+   * The key, or an unset optional if the file could not be read
+   */
+  [[nodiscard]] static std::optional<Key> key(const std::string &path);
+
+  /**
+   * Load a model from the cache.
+   * The entry is memory mapped, rather than read through a buffer
+   *
+   * @param fullPath
+   * The resolved path to the model file
+   *
+   * @return
+   * The cached model, or an unset optional if there is no entry,
+   * or any file the entry was imported from has changed
+   */
+  [[nodiscard]] std::optional<ModelData> read(const std::string &fullPath) const;
+
+  /**
+   * Store a model in the cache, replacing any existing entry.
+   * Failures are reported, but otherwise ignored
+   *
+   * @param fullPath
+   * The resolved path to the model file
+   *
+   * @param files
+   * The keys for the versions of every file `data` was imported from,
+   * including the model file itself
+   *
+   * @param data
+   * The imported model
+   */
+  void write(const std::string &fullPath, const std::vector<Key> &files, const ModelData &data) const;
+};
+
+} // namespace netsimulyzer
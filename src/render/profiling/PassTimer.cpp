@@ -0,0 +1,175 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#include "PassTimer.h"
+#include <iostream>
+
+namespace netsimulyzer {
+
+const char *PassTimer::name(PassTimer::Pass pass) {
+  switch (pass) {
+  case Pass::Skybox:
+    return "Skybox";
+  case Pass::Nodes:
+    return "Nodes";
+  case Pass::Trails:
+    return "Trails";
+  case Pass::Decorations:
+    return "Decorations";
+  case Pass::Floor:
+    return "Floor";
+  case Pass::Areas:
+    return "Areas";
+  case Pass::Buildings:
+    return "Buildings";
+  case Pass::Outlines:
+    return "Outlines";
+  case Pass::Links:
+    return "Links";
+  case Pass::Grid:
+    return "Grid";
+  case Pass::Transparent:
+    return "Transparent";
+  case Pass::Count:
+    break;
+  }
+  return "Unknown";
+}
+
+void PassTimer::Samples::add(double value) {
+  if (count == windowSize)
+    sum -= values[next];
+  else
+    count++;
+
+  values[next] = value;
+  sum += value;
+  next = (next + 1u) % windowSize;
+}
+
+void PassTimer::collect(std::size_t slot) {
+  for (auto pass = 0u; pass < passCount; pass++) {
+    if (!pending[slot][pass])
+      continue;
+    pending[slot][pass] = false;
+
+    GLint available = GL_FALSE;
+    glGetQueryObjectiv(queries[slot][pass], GL_QUERY_RESULT_AVAILABLE, &available);
+
+    // Don't wait for it, just drop the sample
+    if (available == GL_FALSE)
+      continue;
+
+    GLuint64 elapsed = 0u;
+    glGetQueryObjectui64v(queries[slot][pass], GL_QUERY_RESULT, &elapsed);
+    samples[pass].add(static_cast<double>(elapsed) / 1'000'000.0);
+  }
+}
+
+PassTimer::PassTimer() {
+  initializeOpenGLFunctions();
+
+  for (auto &slot : queries)
+    glGenQueries(static_cast<GLsizei>(slot.size()), slot.data());
+}
+
+PassTimer::~PassTimer() {
+  for (auto &slot : queries)
+    glDeleteQueries(static_cast<GLsizei>(slot.size()), slot.data());
+}
+
+void PassTimer::setEnabled(bool enable) {
+  enabled = enable;
+}
+
+bool PassTimer::isEnabled() const {
+  return enabled;
+}
+
+void PassTimer::beginFrame() {
+  if (!enabled)
+    return;
+
+  // The oldest frame in the ring, which we are about to reuse
+  collect(frame);
+}
+
+void PassTimer::endFrame() {
+  if (!enabled)
+    return;
+
+  if (active != Pass::Count)
+    end();
+  frame = (frame + 1u) % frameLatency;
+}
+
+void PassTimer::begin(PassTimer::Pass pass) {
+  if (!enabled)
+    return;
+
+  if (active != Pass::Count) {
+    std::cerr << "Pass: " << name(pass) << " started while timing: " << name(active) << '\n';
+    end();
+  }
+
+  const auto index = static_cast<std::size_t>(pass);
+  glBeginQuery(GL_TIME_ELAPSED, queries[frame][index]);
+  pending[frame][index] = true;
+  active = pass;
+}
+
+void PassTimer::end() {
+  if (!enabled || active == Pass::Count)
+    return;
+
+  glEndQuery(GL_TIME_ELAPSED);
+  active = Pass::Count;
+}
+
+double PassTimer::average(PassTimer::Pass pass) const {
+  const auto &s = samples[static_cast<std::size_t>(pass)];
+  if (s.count == 0u)
+    return 0.0;
+
+  return s.sum / static_cast<double>(s.count);
+}
+
+double PassTimer::total() const {
+  auto result = 0.0;
+  for (auto pass = 0u; pass < passCount; pass++)
+    result += average(static_cast<Pass>(pass));
+
+  return result;
+}
+
+} // namespace netsimulyzer
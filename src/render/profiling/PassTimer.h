@@ -0,0 +1,201 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+
+#include <QOpenGLFunctions_3_3_Core>
+#include <array>
+#include <cstddef>
+
+namespace netsimulyzer {
+
+/**
+ * Measures how long the GPU spends on each pass of a frame
+ * with `GL_TIME_ELAPSED` queries.
+ *
+ * Queries are kept in a ring several frames deep,
+ * and a frame's results are only read once the GPU reports them available,
+ * so collecting timings never waits on the GPU.
+ * Results which are still not ready when their queries are reused are dropped
+ */
+class PassTimer : protected QOpenGLFunctions_3_3_Core {
+public:
+  /**
+   * Each timed section of `Scene::render()`.
+   * Passes may not overlap
+   */
+  enum class Pass : int {
+    Skybox,
+    Nodes,
+    Trails,
+    Decorations,
+    Floor,
+    Areas,
+    Buildings,
+    Outlines,
+    Links,
+    Grid,
+    Transparent,
+    Count
+  };
+
+  static constexpr auto passCount = static_cast<std::size_t>(Pass::Count);
+
+  /**
+   * Number of frames of queries in flight.
+   * The results for a frame are read this many frames after it was drawn
+   */
+  static constexpr std::size_t frameLatency = 4u;
+
+  /**
+   * Number of frames averaged for each pass
+   */
+  static constexpr std::size_t windowSize = 60u;
+
+  /**
+   * Display name for a pass
+   */
+  static const char *name(Pass pass);
+
+private:
+  /**
+   * The last `windowSize` results for a single pass
+   */
+  struct Samples {
+    std::array<double, windowSize> values{};
+    std::size_t next = 0u;
+    std::size_t count = 0u;
+    double sum = 0.0;
+
+    void add(double value);
+  };
+
+  std::array<std::array<unsigned int, passCount>, frameLatency> queries{};
+
+  /**
+   * If the query in `queries` was issued,
+   * and its result not yet collected
+   */
+  std::array<std::array<bool, passCount>, frameLatency> pending{};
+
+  std::array<Samples, passCount> samples;
+
+  /**
+   * The slot of `queries` for the frame being drawn
+   */
+  std::size_t frame = 0u;
+
+  /**
+   * The pass currently being timed, `Pass::Count` if none
+   */
+  Pass active = Pass::Count;
+
+  bool enabled = false;
+
+  /**
+   * Read the results of a previous frame's queries, if they are ready
+   *
+   * @param slot
+   * The slot of `queries` to read
+   */
+  void collect(std::size_t slot);
+
+public:
+  /**
+   * Requires a current OpenGL context
+   */
+  PassTimer();
+
+  /**
+   * Requires a current OpenGL context
+   */
+  ~PassTimer();
+
+  PassTimer(const PassTimer &) = delete;
+  PassTimer &operator=(const PassTimer &) = delete;
+
+  /**
+   * Turn the timing on or off.
+   * While disabled, no queries are issued,
+   * and the existing averages are kept
+   */
+  void setEnabled(bool enable);
+
+  [[nodiscard]] bool isEnabled() const;
+
+  /**
+   * Call before timing any passes for a new frame
+   *
+   * Requires a current OpenGL context
+   */
+  void beginFrame();
+
+  /**
+   * Call once all of the passes for a frame have been timed
+   */
+  void endFrame();
+
+  /**
+   * Start timing `pass`.
+   * Only one pass may be timed at once
+   *
+   * Requires a current OpenGL context
+   */
+  void begin(Pass pass);
+
+  /**
+   * Stop timing the pass started with `begin()`
+   *
+   * Requires a current OpenGL context
+   */
+  void end();
+
+  /**
+   * Gets the rolling average GPU time of `pass`
+   *
+   * @return
+   * The average time, in milliseconds.
+   * 0 if no results have been collected yet
+   */
+  [[nodiscard]] double average(Pass pass) const;
+
+  /**
+   * Gets the sum of the rolling averages of every pass
+   *
+   * @return
+   * The total average time, in milliseconds
+   */
+  [[nodiscard]] double total() const;
+};
+
+} // namespace netsimulyzer
@@ -61,7 +61,7 @@ void Renderer::initShader(Shader &s, const QString &vertexPath, const QString &f
   }
   auto fragmentSrc = QTextStream{&fragmentFile}.readAll().toStdString();
 
-  s.init(vertexSrc, fragmentSrc);
+  s.init(vertexSrc, fragmentSrc, &shaderCache);
 }
 
 Renderer::Renderer(ModelCache &modelCache, TextureCache &textureCache)
@@ -70,24 +70,31 @@ Renderer::Renderer(ModelCache &modelCache, TextureCache &textureCache)
 
 void Renderer::init() {
   initializeOpenGLFunctions();
+  shaderCache.init();
 
-  initShader(areaShader, ":shader/shaders/area.vert", ":shader/shaders/area.frag");
+  initShader(batchShader, ":shader/shaders/batch.vert", ":shader/shaders/batch.frag");
   initShader(buildingShader, ":shader/shaders/building.vert", ":shader/shaders/building.frag");
 
+  initShader(linkShader, ":shader/shaders/link.vert", ":shader/shaders/building.frag");
+  linkShader.uniform("node_positions", 1);
+
   initShader(gridShader, ":shader/shaders/grid.vert", ":shader/shaders/grid.frag");
   gridShader.uniform("discard_distance", 250.0f);
   gridShader.uniform("height", -0.001f);
 
   initShader(modelShader, ":shader/shaders/model.vert", ":shader/shaders/model.frag");
   initShader(skyBoxShader, ":shader/shaders/skybox.vert", ":shader/shaders/skybox.frag");
+  initShader(transmissionShader, ":shader/shaders/transmission.vert", ":shader/shaders/batch.frag");
 }
 
 void Renderer::setPerspective(const glm::mat4 &perspective) {
-  areaShader.uniform("projection", perspective);
+  batchShader.uniform("projection", perspective);
   buildingShader.uniform("projection", perspective);
   gridShader.uniform("projection", perspective);
+  linkShader.uniform("projection", perspective);
   modelShader.uniform("projection", perspective);
   skyBoxShader.uniform("projection", perspective);
+  transmissionShader.uniform("projection", perspective);
 }
 
 void Renderer::setPointLightCount(unsigned int count) {
@@ -102,46 +109,12 @@ void Renderer::setSpotLightCount(unsigned int count) {
   modelShader.uniform("spotLightCount", count);
 }
 
-TrailBuffer Renderer::allocateTrailBuffer(QOpenGLFunctions_3_3_Core *openGl, int size) {
-  const auto vertexSize = sizeof(float) * 3;
-
-  // Vao
-  unsigned int vao;
-  openGl->glGenVertexArrays(1, &vao);
-  openGl->glBindVertexArray(vao);
-
-  // Vbo
-  unsigned int vbo;
-  openGl->glGenBuffers(1, &vbo);
-  openGl->glBindBuffer(GL_ARRAY_BUFFER, vbo);
-  openGl->glBufferData(GL_ARRAY_BUFFER, vertexSize * size, nullptr, GL_DYNAMIC_DRAW);
-
-  // Location
-  openGl->glVertexAttribPointer(0u, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 3, nullptr);
-  openGl->glEnableVertexAttribArray(0u);
-
-  TrailBuffer buffer{openGl, vao, vbo, size, vertexSize};
-  return buffer;
-}
-
-Building::RenderInfo Renderer::allocate(const parser::Building &building) {
-  Building::RenderInfo info;
-
-  auto min = toRenderCoordinate(building.min);
-  auto max = toRenderCoordinate(building.max);
+StaticBatch Renderer::allocateBuildings(const std::vector<Building> &buildings) {
+  std::vector<StaticBatch::Vertex> vertices;
+  std::vector<unsigned int> indices;
 
   // clang-format off
-  std::vector<float> vertices{
-      min.x, min.y, min.z, // 0
-      max.x, min.y, min.z, // 1
-      max.x, min.y, max.z, // 2
-      min.x, min.y, max.z, // 3
-      min.x, max.y, min.z, // 4
-      max.x, max.y, min.z, // 5
-      max.x, max.y, max.z, // 6
-      min.x, max.y, max.z  // 7
-  };
-  std::vector<unsigned int> indices{
+  const std::array<unsigned int, 36> boxIndices{
       0u, 1u, 2u,
       3u, 0u, 2u,
       1u, 5u, 6u,
@@ -157,98 +130,89 @@ Building::RenderInfo Renderer::allocate(const parser::Building &building) {
   };
   // clang-format on
 
-  auto last_index = 7u;
-
-  glGenVertexArrays(1, &info.vao);
-  glBindVertexArray(info.vao);
-
-  // Floors
-  //   All floors are exactly the same height
-  //   abs() just in case our coordinates are negative
-  const auto floor_height = (std::abs(max.y) - std::abs(min.y)) / static_cast<float>(building.floors);
-  for (auto currentFloor = 1; currentFloor < building.floors; currentFloor++) {
-    const auto currentHeight = floor_height * currentFloor + min.y;
-
-    vertices.insert(vertices.end(), {min.x, currentHeight, min.z});
-    vertices.insert(vertices.end(), {max.x, currentHeight, min.z});
-    vertices.insert(vertices.end(), {max.x, currentHeight, max.z});
-    vertices.insert(vertices.end(), {min.x, currentHeight, max.z});
-
-    // 0, 1, 2, 3, 0, 2
-    indices.insert(indices.end(),
-                   {last_index + 1, last_index + 2, last_index + 3, last_index + 4, last_index + 1, last_index + 3});
-    last_index += 4;
-  }
+  // Adds a quad made of the next 4 vertices
+  // 0, 1, 2, 3, 0, 2
+  const auto addQuad = [&vertices, &indices](const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c,
+                                             const glm::vec3 &d, const glm::vec3 &color) {
+    const auto first = static_cast<unsigned int>(vertices.size());
+    vertices.insert(vertices.end(), {{a, color}, {b, color}, {c, color}, {d, color}});
+    indices.insert(indices.end(), {first, first + 1u, first + 2u, first + 3u, first, first + 2u});
+  };
 
-  // Walls
-  // X
+  for (const auto &building : buildings) {
+    // Hidden buildings are left out of the batch entirely,
+    // so changing visibility requires rebuilding it
+    if (!building.visible())
+      continue;
 
-  // Find the size of each room
-  auto roomLengthX = (max.x - min.x) / static_cast<float>(building.roomsX);
+    const auto &model = building.getModel();
+    const auto &color = building.getColor();
+    const auto min = toRenderCoordinate(model.min);
+    const auto max = toRenderCoordinate(model.max);
+
+    // Outer box
+    // clang-format off
+    const std::array<glm::vec3, 8> corners{
+        glm::vec3{min.x, min.y, min.z}, // 0
+        glm::vec3{max.x, min.y, min.z}, // 1
+        glm::vec3{max.x, min.y, max.z}, // 2
+        glm::vec3{min.x, min.y, max.z}, // 3
+        glm::vec3{min.x, max.y, min.z}, // 4
+        glm::vec3{max.x, max.y, min.z}, // 5
+        glm::vec3{max.x, max.y, max.z}, // 6
+        glm::vec3{min.x, max.y, max.z}  // 7
+    };
+    // clang-format on
+
+    const auto first = static_cast<unsigned int>(vertices.size());
+    for (const auto &corner : corners)
+      vertices.emplace_back(StaticBatch::Vertex{corner, color});
+    for (const auto index : boxIndices)
+      indices.emplace_back(first + index);
+
+    // Floors
+    //   All floors are exactly the same height
+    //   abs() just in case our coordinates are negative
+    const auto floor_height = (std::abs(max.y) - std::abs(min.y)) / static_cast<float>(model.floors);
+    for (auto currentFloor = 1; currentFloor < model.floors; currentFloor++) {
+      const auto currentHeight = floor_height * currentFloor + min.y;
+
+      addQuad({min.x, currentHeight, min.z}, {max.x, currentHeight, min.z}, {max.x, currentHeight, max.z},
+              {min.x, currentHeight, max.z}, color);
+    }
 
-  for (auto currentRoom = 1; currentRoom < building.roomsX; currentRoom++) {
-    auto currentWallPosition = roomLengthX * currentRoom + min.x;
+    // Walls
+    // X
 
-    vertices.insert(vertices.end(), {currentWallPosition, min.y, min.z});
-    vertices.insert(vertices.end(), {currentWallPosition, max.y, min.z});
-    vertices.insert(vertices.end(), {currentWallPosition, max.y, max.z});
-    vertices.insert(vertices.end(), {currentWallPosition, min.y, max.z});
+    // Find the size of each room
+    const auto roomLengthX = (max.x - min.x) / static_cast<float>(model.roomsX);
 
-    // 0, 1, 2, 3, 0, 2
-    indices.insert(indices.end(),
-                   {last_index + 1, last_index + 2, last_index + 3, last_index + 4, last_index + 1, last_index + 3});
-    last_index += 4;
-  }
+    for (auto currentRoom = 1; currentRoom < model.roomsX; currentRoom++) {
+      const auto currentWallPosition = roomLengthX * currentRoom + min.x;
 
-  // Y (Z in OpenGl coordinates)
-  auto roomLengthY = (max.z - min.z) / static_cast<float>(building.roomsY);
+      addQuad({currentWallPosition, min.y, min.z}, {currentWallPosition, max.y, min.z},
+              {currentWallPosition, max.y, max.z}, {currentWallPosition, min.y, max.z}, color);
+    }
 
-  for (auto currentRoom = 1; currentRoom < building.roomsY; currentRoom++) {
-    auto currentWallPosition = roomLengthY * currentRoom + min.z;
+    // Y (Z in OpenGl coordinates)
+    const auto roomLengthY = (max.z - min.z) / static_cast<float>(model.roomsY);
 
-    vertices.insert(vertices.end(), {min.x, min.y, currentWallPosition});
-    vertices.insert(vertices.end(), {max.x, min.y, currentWallPosition});
-    vertices.insert(vertices.end(), {max.x, max.y, currentWallPosition});
-    vertices.insert(vertices.end(), {min.x, max.y, currentWallPosition});
+    for (auto currentRoom = 1; currentRoom < model.roomsY; currentRoom++) {
+      const auto currentWallPosition = roomLengthY * currentRoom + min.z;
 
-    // 0, 1, 2, 3, 0, 2
-    indices.insert(indices.end(),
-                   {last_index + 1, last_index + 2, last_index + 3, last_index + 4, last_index + 1, last_index + 3});
-    last_index += 4;
+      addQuad({min.x, min.y, currentWallPosition}, {max.x, min.y, currentWallPosition},
+              {max.x, max.y, currentWallPosition}, {min.x, max.y, currentWallPosition}, color);
+    }
   }
 
-  info.ibo_size = indices.size();
-
-  glGenBuffers(1, &info.ibo);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, info.ibo);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int) * indices.size(), indices.data(), GL_STATIC_DRAW);
-
-  glGenBuffers(1, &info.vbo);
-  glBindBuffer(GL_ARRAY_BUFFER, info.vbo);
-  glBufferData(GL_ARRAY_BUFFER, sizeof(float) * vertices.size(), vertices.data(), GL_STATIC_DRAW);
-
-  // Location
-  glVertexAttribPointer(0u, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 3, nullptr);
-  glEnableVertexAttribArray(0u);
+  return StaticBatch{vertices, indices, GL_TRIANGLES};
+}
 
-  // Border Lines
-
-  // add a very slight offset
-  // so lines do not directly
-  // intersect the walls
-  const float offset = 0.01f;
+StaticBatch Renderer::allocateBuildingOutlines(const std::vector<Building> &buildings) {
+  std::vector<StaticBatch::Vertex> vertices;
+  std::vector<unsigned int> indices;
 
   // clang-format off
-  const std::array<float, 24> borderVertices {
-      min.x - offset, min.y - offset, min.z - offset, // 0
-      max.x + offset, min.y - offset, min.z - offset, // 1
-      max.x + offset, min.y - offset, max.z + offset, // 2
-      min.x - offset, min.y - offset, max.z + offset, // 3
-      min.x - offset, max.y + offset, min.z - offset, // 4
-      max.x + offset, max.y + offset, min.z - offset, // 5
-      max.x + offset, max.y + offset, max.z + offset, // 6
-      min.x - offset, max.y + offset, max.z + offset  // 7
-  };
   const std::array<unsigned int, 24> lineIndices {
       0u, 1u, // Bottom
       1u, 2u,
@@ -265,143 +229,144 @@ Building::RenderInfo Renderer::allocate(const parser::Building &building) {
   };
   // clang-format on
 
-  glGenVertexArrays(1, &info.lineVao);
-  glBindVertexArray(info.lineVao);
+  // add a very slight offset
+  // so lines do not directly
+  // intersect the walls
+  const float offset = 0.01f;
 
-  info.lineIboSize = lineIndices.size();
+  // Outline color is set when rendering,
+  // so the vertex color is unused
+  const glm::vec3 color{0.0f};
 
-  glGenBuffers(1, &info.lineIbo);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, info.lineIbo);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int) * lineIndices.size(), lineIndices.data(), GL_STATIC_DRAW);
+  for (const auto &building : buildings) {
+    if (!building.visible())
+      continue;
 
-  glGenBuffers(1, &info.lineVbo);
-  glBindBuffer(GL_ARRAY_BUFFER, info.lineVbo);
-  glBufferData(GL_ARRAY_BUFFER, sizeof(float) * borderVertices.size(), borderVertices.data(), GL_STATIC_DRAW);
+    const auto &model = building.getModel();
+    const auto min = toRenderCoordinate(model.min) - offset;
+    const auto max = toRenderCoordinate(model.max) + offset;
+
+    // clang-format off
+    const std::array<glm::vec3, 8> corners{
+        glm::vec3{min.x, min.y, min.z}, // 0
+        glm::vec3{max.x, min.y, min.z}, // 1
+        glm::vec3{max.x, min.y, max.z}, // 2
+        glm::vec3{min.x, min.y, max.z}, // 3
+        glm::vec3{min.x, max.y, min.z}, // 4
+        glm::vec3{max.x, max.y, min.z}, // 5
+        glm::vec3{max.x, max.y, max.z}, // 6
+        glm::vec3{min.x, max.y, max.z}  // 7
+    };
+    // clang-format on
 
-  // Location
-  glVertexAttribPointer(0u, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 3, nullptr);
-  glEnableVertexAttribArray(0u);
+    const auto first = static_cast<unsigned int>(vertices.size());
+    for (const auto &corner : corners)
+      vertices.emplace_back(StaticBatch::Vertex{corner, color});
+    for (const auto index : lineIndices)
+      indices.emplace_back(first + index);
+  }
 
-  return info;
+  return StaticBatch{vertices, indices, GL_LINES};
 }
 
-Area::RenderInfo Renderer::allocate(const parser::Area &area) {
-  Area::RenderInfo info;
-
-  // Convert to OpenGl coordinates
-  // for easier reading later
-  // Also handle the fill
-  std::vector<glm::vec3> convertedPoints;
-  convertedPoints.reserve(area.points.size());
-  for (const auto &point : area.points) {
-    auto converted = toRenderCoordinate(point);
-    convertedPoints.emplace_back(converted);
-
-    // Handle the fill vertexes
-    // since we're already looping through all the points
-  }
-
+StaticBatch Renderer::allocateAreas(const std::vector<Area> &areas) {
   using DrawMode = parser::Area::DrawMode;
+  std::vector<StaticBatch::Vertex> vertices;
+  std::vector<unsigned int> indices;
 
-  // Fill
-  info.renderFill = area.fillMode == DrawMode::Solid;
-  if (info.renderFill) {
-    std::vector<float> fillVertices;
-    fillVertices.reserve(area.points.size() * 3uL);
-
-    for (const auto &point : convertedPoints) {
-      // It's easiest to pass a flat array of floats
-      // with only one vertex attribute
-      // (Location in this case)
-      fillVertices.insert(fillVertices.end(), {point.x, point.y, point.z});
+  for (const auto &area : areas) {
+    const auto &model = area.getModel();
+
+    // Convert to OpenGl coordinates
+    // for easier reading later
+    std::vector<glm::vec3> convertedPoints;
+    convertedPoints.reserve(model.points.size());
+    for (const auto &point : model.points) {
+      convertedPoints.emplace_back(toRenderCoordinate(point));
     }
 
-    glGenVertexArrays(1, &info.fillVao);
-    glBindVertexArray(info.fillVao);
-
-    // Size is in number of three component vertices
-    // not raw number of floats
-    // so the ns-3 or converted point count would work
-    info.fillVbo_size = area.points.size();
-
-    glGenBuffers(1, &info.fillVbo);
-    glBindBuffer(GL_ARRAY_BUFFER, info.fillVbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * fillVertices.size(), fillVertices.data(), GL_STATIC_DRAW);
+    // Fill
+    // Emitted before the border, so the border is drawn
+    // after the fill, like the individual draws were
+    if (model.fillMode == DrawMode::Solid && convertedPoints.size() >= 3u) {
+      const auto first = static_cast<unsigned int>(vertices.size());
+      for (const auto &point : convertedPoints) {
+        vertices.emplace_back(StaticBatch::Vertex{point, area.getFillColor()});
+      }
+
+      // Triangle fan expanded into triangles
+      // so every area may share one draw
+      for (auto i = 1u; i + 1u < convertedPoints.size(); i++) {
+        indices.insert(indices.end(), {first, first + i, first + i + 1u});
+      }
+    }
 
-    // Location Attribute
-    glVertexAttribPointer(0u, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 3, nullptr);
-    glEnableVertexAttribArray(0u);
+    // Border
+    if (model.borderMode == DrawMode::Solid && convertedPoints.size() >= 4u) {
+      const auto borderWidth = 0.5f; // TODO: Make configurable?
+      const auto &color = area.getBorderColor();
+
+      // TODO: Filled Corners?
+      const std::array<glm::vec3, 14> borderPoints{
+          // Top Left
+          convertedPoints[0],                                                                        // 0
+          glm::vec3{convertedPoints[0].x - borderWidth, convertedPoints[0].y, convertedPoints[0].z}, // 1
+
+          // Bottom Left
+          convertedPoints[1],                                                                        // 2
+          glm::vec3{convertedPoints[1].x - borderWidth, convertedPoints[1].y, convertedPoints[1].z}, // 3
+          glm::vec3{convertedPoints[1].x, convertedPoints[1].y, convertedPoints[1].z + borderWidth}, // 4
+
+          // Bottom Right
+          convertedPoints[2],                                                                        // 5
+          glm::vec3{convertedPoints[2].x, convertedPoints[2].y, convertedPoints[2].z + borderWidth}, // 6
+          glm::vec3{convertedPoints[2].x + borderWidth, convertedPoints[2].y, convertedPoints[2].z}, // 7
+
+          // Top Right
+          convertedPoints[3],                                                                        // 8
+          glm::vec3{convertedPoints[3].x + borderWidth, convertedPoints[3].y, convertedPoints[3].z}, // 9
+          glm::vec3{convertedPoints[3].x, convertedPoints[3].y, convertedPoints[3].z - borderWidth}, // 10
+
+          // Top Left (Again)
+          convertedPoints[0],                                                                        // 11 (same as 0)
+          glm::vec3{convertedPoints[0].x, convertedPoints[0].y, convertedPoints[0].z - borderWidth}, // 12
+          glm::vec3{convertedPoints[0].x - borderWidth, convertedPoints[0].y, convertedPoints[0].z}, // 13 (same as 1)
+      };
+
+      const auto first = static_cast<unsigned int>(vertices.size());
+      for (const auto &point : borderPoints) {
+        vertices.emplace_back(StaticBatch::Vertex{point, color});
+      }
+
+      // Triangle strip expanded into triangles
+      for (auto i = 0u; i + 2u < borderPoints.size(); i++) {
+        indices.insert(indices.end(), {first + i, first + i + 1u, first + i + 2u});
+      }
+    }
   }
 
-  // Border
-  info.renderBorder = area.borderMode == DrawMode::Solid;
-  if (info.renderBorder) {
-    const auto borderWidth = 0.5f; // TODO: Make configurable?
-
-    // TODO: Filled Corners?
-    float borderPoints[] = {
-        // Top Left
-        convertedPoints[0].x, convertedPoints[0].y, convertedPoints[0].z,               // 0
-        convertedPoints[0].x - borderWidth, convertedPoints[0].y, convertedPoints[0].z, // 1
-
-        // Bottom Left
-        convertedPoints[1].x, convertedPoints[1].y, convertedPoints[1].z,               // 2
-        convertedPoints[1].x - borderWidth, convertedPoints[1].y, convertedPoints[1].z, // 3
-        convertedPoints[1].x, convertedPoints[1].y, convertedPoints[1].z + borderWidth, // 4
-
-        // Bottom Right
-        convertedPoints[2].x, convertedPoints[2].y, convertedPoints[2].z,               // 5
-        convertedPoints[2].x, convertedPoints[2].y, convertedPoints[2].z + borderWidth, // 6
-        convertedPoints[2].x + borderWidth, convertedPoints[2].y, convertedPoints[2].z, // 7
-
-        // Top Right
-        convertedPoints[3].x, convertedPoints[3].y, convertedPoints[3].z,               // 8
-        convertedPoints[3].x + borderWidth, convertedPoints[3].y, convertedPoints[3].z, // 9
-        convertedPoints[3].x, convertedPoints[3].y, convertedPoints[3].z - borderWidth, // 10
-
-        // Top Left (Again)
-        convertedPoints[0].x, convertedPoints[0].y, convertedPoints[0].z,               // 11 (same as 0)
-        convertedPoints[0].x, convertedPoints[0].y, convertedPoints[0].z - borderWidth, // 12
-        convertedPoints[0].x - borderWidth, convertedPoints[0].y, convertedPoints[0].z, // 13 (same as 1)
-    };
-
-    info.borderVbo_size = 14u;
-    info.borderColor = toRenderColor(area.borderColor);
+  return StaticBatch{vertices, indices, GL_TRIANGLES};
+}
 
-    glGenVertexArrays(1, &info.borderVao);
-    glBindVertexArray(info.borderVao);
+StaticBatch Renderer::allocateWiredLinks(const std::vector<WiredLink> &wiredLinks) {
+  std::vector<unsigned int> indices;
 
-    glGenBuffers(1, &info.borderVbo);
-    glBindBuffer(GL_ARRAY_BUFFER, info.borderVbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(borderPoints), borderPoints, GL_STATIC_DRAW);
+  for (const auto &wiredLink : wiredLinks) {
+    const auto &positionIndices = wiredLink.getPositionIndices();
 
-    // Location
-    glVertexAttribPointer(0u, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 3, nullptr);
-    glEnableVertexAttribArray(0u);
+    // Links are drawn as pairs of Nodes, with any unpaired Node ignored
+    // Do not let it pair with the next link
+    for (auto i = 0u; i + 1u < positionIndices.size(); i += 2u) {
+      indices.emplace_back(static_cast<unsigned int>(positionIndices[i]));
+      indices.emplace_back(static_cast<unsigned int>(positionIndices[i + 1u]));
+    }
   }
 
-  return info;
+  return StaticBatch{indices, GL_LINES};
 }
 
-WiredLink::RenderInfo Renderer::allocate(const parser::WiredLink &link) {
-  WiredLink::RenderInfo info;
-
-  info.size = static_cast<int>(link.nodes.size());
-
-  glGenVertexArrays(1, &info.vao);
-  glBindVertexArray(info.vao);
-
-  glGenBuffers(1, &info.vbo);
-  glBindBuffer(GL_ARRAY_BUFFER, info.vbo);
-
-  // Location data is set when this link is added to each node
-  glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 3 * link.nodes.size(), nullptr, GL_DYNAMIC_DRAW);
-
-  // Location
-  glVertexAttribPointer(0u, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 3, nullptr);
-  glEnableVertexAttribArray(0u);
-
-  return info;
+std::unique_ptr<TransmissionSpheres> Renderer::allocateTransmissionSpheres(const Model &sphere) {
+  return std::make_unique<TransmissionSpheres>(modelCache.get(sphere.getModelId()).getMeshes());
 }
 
 Mesh Renderer::allocateFloor(float size) {
@@ -411,9 +376,11 @@ Mesh Renderer::allocateFloor(float size) {
   // Make sure this isn't negative
   size = std::abs(size);
 
+  // The texture is repeated `size` times by the shader, see `Floor::textureRepeat`,
+  // as coordinates that large do not fit in `PackedVertex`
   Vertex floorVertices[]{
-      Vertex{{-size, 0.0f, -size}, normal, {0.0f, 0.0f}}, Vertex{{size, 0.0f, -size}, normal, {size, 0.0f}},
-      Vertex{{-size, 0.0f, size}, normal, {0.0f, size}}, Vertex{{size, 0.0f, size}, normal, {size, size}}};
+      Vertex{{-size, 0.0f, -size}, normal, {0.0f, 0.0f}}, Vertex{{size, 0.0f, -size}, normal, {1.0f, 0.0f}},
+      Vertex{{-size, 0.0f, size}, normal, {0.0f, 1.0f}}, Vertex{{size, 0.0f, size}, normal, {1.0f, 1.0f}}};
 
   Material floorMaterial;
   floorMaterial.shininess = 4.0f;
@@ -428,15 +395,23 @@ void Renderer::resize(Floor &f, float size) {
   // Make sure this isn't negative
   size = std::abs(size);
 
+  f.setTextureRepeat(size);
+
   std::array<float, 3> normal{0.0f, -1.0f, 1.0f};
   Vertex floorVertices[]{
-      Vertex{{-size, 0.0f, -size}, normal, {0.0f, 0.0f}}, Vertex{{size, 0.0f, -size}, normal, {size, 0.0f}},
-      Vertex{{-size, 0.0f, size}, normal, {0.0f, size}}, Vertex{{size, 0.0f, size}, normal, {size, size}}};
+      Vertex{{-size, 0.0f, -size}, normal, {0.0f, 0.0f}}, Vertex{{size, 0.0f, -size}, normal, {1.0f, 0.0f}},
+      Vertex{{-size, 0.0f, size}, normal, {0.0f, 1.0f}}, Vertex{{size, 0.0f, size}, normal, {1.0f, 1.0f}}};
+
+  // Match the layout `Mesh` uploaded
+  std::array<PackedVertex, 4> packedVertices{};
+  for (auto i = 0u; i < packedVertices.size(); i++) {
+    packedVertices[i] = PackedVertex::pack(floorVertices[i]);
+  }
 
   const auto &renderInfo = f.getMesh().getRenderInfo();
 
   glBindBuffer(GL_ARRAY_BUFFER, renderInfo.vbo);
-  glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(floorVertices), reinterpret_cast<const void *>(floorVertices));
+  glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(packedVertices), reinterpret_cast<const void *>(packedVertices.data()));
 }
 
 CoordinateGrid::RenderInfo Renderer::allocateCoordinateGrid(float size, int stepSize) {
@@ -525,12 +500,14 @@ void Renderer::endTransparent() {
 }
 
 void Renderer::use(const Camera &cam) {
-  areaShader.uniform("view", cam.view_matrix());
+  batchShader.uniform("view", cam.view_matrix());
 
   modelShader.uniform("view", cam.view_matrix());
   modelShader.uniform("eye_position", cam.get_position());
 
   buildingShader.uniform("view", cam.view_matrix());
+  linkShader.uniform("view", cam.view_matrix());
+  transmissionShader.uniform("view", cam.view_matrix());
 
   gridShader.uniform("view", cam.view_matrix());
   gridShader.uniform("eye_position", cam.get_position());
@@ -576,59 +553,25 @@ void Renderer::render(const SpotLight &light) {
   modelShader.uniform(light.prefix + "edge", light.processedEdge);
 }
 
-void Renderer::render(const std::vector<Area> &areas) {
-  areaShader.bind();
-
-  for (const auto &area : areas) {
-    const auto &renderInfo = area.getRenderInfo();
-    if (renderInfo.renderFill) {
-      areaShader.uniform("color", renderInfo.fillColor);
-      glBindVertexArray(renderInfo.fillVao);
-      glDrawArrays(GL_TRIANGLE_FAN, 0, renderInfo.fillVbo_size);
-    }
-
-    if (renderInfo.renderBorder) {
-      areaShader.uniform("color", renderInfo.borderColor);
-      glBindVertexArray(renderInfo.borderVao);
-      glDrawArrays(GL_TRIANGLE_STRIP, 0, renderInfo.borderVbo_size);
-    }
-  }
+void Renderer::render(StaticBatch &batch) {
+  batchShader.bind();
+  batch.render();
 }
 
-void Renderer::render(const std::vector<Building> &buildings) {
+void Renderer::renderOutlines(StaticBatch &outlines, const glm::vec3 &color) {
   buildingShader.bind();
-  for (const auto &building : buildings) {
-    if (!building.visible())
-      continue;
-    const auto &renderInfo = building.getRenderInfo();
-    buildingShader.uniform("color", building.getColor());
-
-    glBindVertexArray(renderInfo.vao);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, renderInfo.ibo);
-    glDrawElements(GL_TRIANGLES, renderInfo.ibo_size, GL_UNSIGNED_INT, nullptr);
-  }
+  buildingShader.uniform("color", color);
+  outlines.render();
 }
 
-void Renderer::renderOutlines(const std::vector<Building> &buildings, const glm::vec3 &color) {
-  buildingShader.bind();
-  for (const auto &building : buildings) {
-    if (!building.visible())
-      continue;
-    const auto &renderInfo = building.getRenderInfo();
+void Renderer::render(TrailPool &trails, const TrailPool::DrawList &drawList) {
+  trails.flush();
 
-    glBindVertexArray(renderInfo.lineVao);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, renderInfo.lineIbo);
-    buildingShader.uniform("color", color);
-    glDrawElements(GL_LINES, renderInfo.lineIboSize, GL_UNSIGNED_INT, nullptr);
-  }
-}
-
-void Renderer::renderTrail(const TrailBuffer &buffer, const glm::vec3 &color) {
   glEnable(GL_LINE_SMOOTH);
 
-  buildingShader.bind();
-  buildingShader.uniform("color", color);
-  buffer.render();
+  // Trail colors are stored per vertex
+  batchShader.bind();
+  trails.render(drawList);
 
   glDisable(GL_LINE_SMOOTH);
 }
@@ -657,7 +600,11 @@ void Renderer::render(Floor &f) {
   modelShader.uniform("model", f.getModelMatrix());
   modelShader.uniform("useTexture", false);
   modelShader.uniform("material_color", f.getMesh().getMaterial().color.value());
+  modelShader.uniform("texture_repeat", f.getTextureRepeat());
   f.render();
+
+  // Models use their texture coordinates as is
+  modelShader.uniform("texture_repeat", 1.0f);
 }
 
 void Renderer::render(SkyBox &skyBox) {
@@ -695,19 +642,25 @@ void Renderer::render(CoordinateGrid &coordinateGrid) {
   glDepthMask(GL_TRUE);
 }
 
-void Renderer::render(const std::vector<WiredLink> &wiredLinks) {
+void Renderer::render(TransmissionSpheres &spheres) {
+  transmissionShader.bind();
+  spheres.render();
+}
+
+void Renderer::renderWiredLinks(StaticBatch &links, NodePositionBuffer &nodePositions) {
+  nodePositions.flush();
+
   glEnable(GL_LINE_SMOOTH);
 
-  buildingShader.bind();
+  linkShader.bind();
   // TODO: Make configurable
-  buildingShader.uniform("color", {0.0f, 0.0f, 0.0f});
+  linkShader.uniform("color", {0.0f, 0.0f, 0.0f});
 
-  for (const auto &wiredLink : wiredLinks) {
-    const auto &renderInfo = wiredLink.getRenderInfo();
-    glBindVertexArray(renderInfo.vao);
-    glBindBuffer(GL_ARRAY_BUFFER, renderInfo.vbo);
-    glDrawArrays(GL_LINES, 0, renderInfo.size);
-  }
+  glActiveTexture(GL_TEXTURE1);
+  nodePositions.bind();
+  links.render();
+  glBindTexture(GL_TEXTURE_BUFFER, 0u);
+  glActiveTexture(GL_TEXTURE0);
 
   glDisable(GL_LINE_SMOOTH);
 }
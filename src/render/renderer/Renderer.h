@@ -41,13 +41,18 @@
 #include "../model/Model.h"
 #include "../model/ModelCache.h"
 #include "../shader/Shader.h"
+#include "../shader/ShaderCache.h"
 #include "../texture/TextureCache.h"
 #include "src/group/link/WiredLink.h"
-#include "src/group/node/TrailBuffer.h"
+#include "src/group/node/NodePositionBuffer.h"
+#include "src/group/node/TrailPool.h"
 #include "src/render/helper/CoordinateGrid.h"
 #include "src/render/helper/SkyBox.h"
+#include "src/render/helper/StaticBatch.h"
+#include "src/render/helper/TransmissionSpheres.h"
 #include <QOpenGLFunctions_3_3_Core>
 #include <glm/glm.hpp>
+#include <memory>
 #include <sstream>
 #include <vector>
 
@@ -57,11 +62,19 @@ class Renderer : protected QOpenGLFunctions_3_3_Core {
   ModelCache &modelCache;
   TextureCache &textureCache;
 
-  Shader areaShader;
+  /**
+   * Linked programs from previous runs,
+   * so repeat launches skip compiling the shaders
+   */
+  ShaderCache shaderCache;
+
+  Shader batchShader;
   Shader buildingShader;
   Shader gridShader;
+  Shader linkShader;
   Shader modelShader;
   Shader skyBoxShader;
+  Shader transmissionShader;
 
   void initShader(Shader &s, const QString &vertexPath, const QString &fragmentPath);
 
@@ -77,10 +90,67 @@ public:
   void setPointLightCount(unsigned int count);
   void setSpotLightCount(unsigned int count);
 
-  TrailBuffer allocateTrailBuffer(QOpenGLFunctions_3_3_Core *openGl, int size);
-  Building::RenderInfo allocate(const parser::Building &building);
-  Area::RenderInfo allocate(const parser::Area &area);
-  WiredLink::RenderInfo allocate(const parser::WiredLink &link);
+  /**
+   * Merge the walls & floors of every visible building
+   * into a single batch
+   *
+   * @param buildings
+   * The buildings to include in the batch.
+   * Buildings which are not `visible()` are skipped.
+   *
+   * @return
+   * A batch drawn with `render(StaticBatch&)`
+   */
+  StaticBatch allocateBuildings(const std::vector<Building> &buildings);
+
+  /**
+   * Merge the outlines of every visible building
+   * into a single batch of lines
+   *
+   * @param buildings
+   * The buildings to include in the batch.
+   * Buildings which are not `visible()` are skipped.
+   *
+   * @return
+   * A batch drawn with `renderOutlines()`
+   */
+  StaticBatch allocateBuildingOutlines(const std::vector<Building> &buildings);
+
+  /**
+   * Merge the fill & border of every area
+   * into a single batch
+   *
+   * @param areas
+   * The areas to include in the batch
+   *
+   * @return
+   * A batch drawn with `render(StaticBatch&)`
+   */
+  StaticBatch allocateAreas(const std::vector<Area> &areas);
+
+  /**
+   * Merge every link into a single index only batch of lines.
+   * The indices are positions in the `NodePositionBuffer`
+   *
+   * @param wiredLinks
+   * The links to include in the batch
+   *
+   * @return
+   * A batch drawn with `renderWiredLinks()`
+   */
+  StaticBatch allocateWiredLinks(const std::vector<WiredLink> &wiredLinks);
+
+  /**
+   * Prepare instanced drawing of a model,
+   * for the transmission spheres
+   *
+   * @param sphere
+   * The model to draw for each transmission
+   *
+   * @return
+   * An object drawn with `render(TransmissionSpheres&)`
+   */
+  std::unique_ptr<TransmissionSpheres> allocateTransmissionSpheres(const Model &sphere);
   Mesh allocateFloor(float size);
   void resize(Floor &f, float size);
   CoordinateGrid::RenderInfo allocateCoordinateGrid(float size, int stepSize);
@@ -93,16 +163,49 @@ public:
   void render(const DirectionalLight &light);
   void render(const PointLight &light);
   void render(const SpotLight &light);
-  void render(const std::vector<Area> &areas);
-  void render(const std::vector<Building> &buildings);
-  void renderOutlines(const std::vector<Building> &buildings, const glm::vec3 &color);
-  void renderTrail(const TrailBuffer &buffer, const glm::vec3 &color);
+  void render(StaticBatch &batch);
+  void renderOutlines(StaticBatch &outlines, const glm::vec3 &color);
+
+  /**
+   * Upload any changed trail points,
+   * then draw every trail in `drawList` at once
+   *
+   * @param trails
+   * The pool holding the trails
+   *
+   * @param drawList
+   * The ranges of the pool to draw,
+   * see `TrailBuffer::appendDrawRanges()`
+   */
+  void render(TrailPool &trails, const TrailPool::DrawList &drawList);
+
   void render(const Model &m, LightingMode lightingMode = LightingMode::LightingEnabled);
   void renderTransparent(const Model &m, LightingMode lightingMode = LightingMode::LightingEnabled);
   void render(Floor &f);
   void render(SkyBox &skyBox);
   void render(CoordinateGrid &coordinateGrid);
-  void render(const std::vector<WiredLink> &wiredLinks);
+
+  /**
+   * Draw every sphere added this frame, unlit.
+   * Should be called between `startTransparent()`
+   * and `endTransparent()`
+   *
+   * @param spheres
+   * The spheres to draw
+   */
+  void render(TransmissionSpheres &spheres);
+
+  /**
+   * Upload any moved Node positions,
+   * then draw every link at once
+   *
+   * @param links
+   * The batch from `allocateWiredLinks()`
+   *
+   * @param nodePositions
+   * The buffer the indices in `links` refer to
+   */
+  void renderWiredLinks(StaticBatch &links, NodePositionBuffer &nodePositions);
 };
 
 } // namespace netsimulyzer
@@ -0,0 +1,136 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+#include <QByteArray>
+#include <QtGlobal>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace netsimulyzer {
+
+/**
+ * Appends plain values to an on-disk cache entry
+ */
+class EntryWriter {
+  QByteArray &buffer;
+
+public:
+  explicit EntryWriter(QByteArray &buffer) : buffer(buffer) {
+  }
+
+  template <class T>
+  void value(const T &v) {
+    static_assert(std::is_trivially_copyable_v<T>, "Only plain values may be written directly");
+    buffer.append(reinterpret_cast<const char *>(&v), sizeof(T));
+  }
+
+  void bytes(const void *data, std::size_t size) {
+    buffer.append(static_cast<const char *>(data), static_cast<int>(size));
+  }
+
+  void string(const std::string &s) {
+    value(static_cast<std::uint32_t>(s.size()));
+    bytes(s.data(), s.size());
+  }
+};
+
+/**
+ * Reads plain values back out of a mapped on-disk cache entry.
+ * Every read is bounds checked, so a truncated entry is treated as a miss
+ */
+class EntryReader {
+  const uchar *position;
+  const uchar *end;
+
+public:
+  EntryReader(const uchar *data, qint64 size) : position(data), end(data + size) {
+  }
+
+  /**
+   * Check that `count` records could still be read,
+   * before allocating space for them
+   *
+   * @param count
+   * The number of records the entry claims to hold
+   *
+   * @param minimumSize
+   * The fewest bytes a single record takes
+   *
+   * @return
+   * False if the rest of the entry is too short to hold `count` records
+   */
+  bool fits(std::uint32_t count, std::size_t minimumSize) const {
+    return static_cast<std::size_t>(end - position) / minimumSize >= count;
+  }
+
+  template <class T>
+  bool value(T &v) {
+    static_assert(std::is_trivially_copyable_v<T>, "Only plain values may be read directly");
+    return bytes(&v, sizeof(T));
+  }
+
+  bool bytes(void *destination, std::size_t size) {
+    if (static_cast<std::size_t>(end - position) < size)
+      return false;
+
+    std::memcpy(destination, position, size);
+    position += size;
+    return true;
+  }
+
+  bool string(std::string &s) {
+    std::uint32_t size;
+    if (!value(size) || static_cast<std::size_t>(end - position) < size)
+      return false;
+
+    s.assign(reinterpret_cast<const char *>(position), size);
+    position += size;
+    return true;
+  }
+
+  template <class T>
+  bool array(std::vector<T> &v, std::uint32_t count) {
+    if (static_cast<std::size_t>(end - position) / sizeof(T) < count)
+      return false;
+
+    v.resize(count);
+    return bytes(v.data(), sizeof(T) * count);
+  }
+};
+
+} // namespace netsimulyzer
@@ -0,0 +1,117 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#include "ResourceIndex.h"
+#include <QFileInfo>
+#include <QFileInfoList>
+#include <QStringList>
+#include <trace.h>
+
+namespace netsimulyzer {
+
+ResourceIndex::ResourceIndex() {
+  QObject::connect(&watcher, &QFileSystemWatcher::directoryChanged, [this]() { stale = true; });
+}
+
+void ResourceIndex::rebuild() {
+  NETSIMULYZER_TRACE_SCOPE("ResourceIndex::rebuild");
+  byName.clear();
+  byRelativePath.clear();
+
+  const auto watched = watcher.directories();
+  if (!watched.isEmpty())
+    watcher.removePaths(watched);
+
+  if (root.exists())
+    indexDirectory(root.absolutePath(), 0u);
+
+  stale = false;
+}
+
+void ResourceIndex::indexDirectory(const QString &path, unsigned int depth) {
+  if (depth >= maxDepth)
+    return;
+
+  watcher.addPath(path);
+
+  // Files before subdirectories, so a file closer to the root
+  // wins a name collision, matching the old recursive search
+  const QDir directory{path};
+  const auto files = directory.entryInfoList(QDir::Files | QDir::Readable, QDir::Name);
+  for (const auto &file : files) {
+    const auto absolutePath = file.absoluteFilePath();
+    byName.try_emplace(file.fileName().toStdString(), absolutePath);
+    byRelativePath.try_emplace(root.relativeFilePath(absolutePath).toStdString(), absolutePath);
+  }
+
+  const auto subDirectories = directory.entryInfoList(QDir::Dirs | QDir::Readable | QDir::NoDotAndDotDot, QDir::Name);
+  for (const auto &subDirectory : subDirectories) {
+    indexDirectory(subDirectory.absoluteFilePath(), depth + 1u);
+  }
+}
+
+void ResourceIndex::refresh() {
+  if (stale)
+    rebuild();
+}
+
+void ResourceIndex::setRoot(const QDir &value) {
+  root = value;
+  stale = true;
+}
+
+const QDir &ResourceIndex::getRoot() const {
+  return root;
+}
+
+std::optional<QString> ResourceIndex::findByName(const std::string &fileName) {
+  refresh();
+
+  const auto result = byName.find(fileName);
+  if (result == byName.end())
+    return {};
+
+  return result->second;
+}
+
+std::optional<QString> ResourceIndex::findRelative(const std::string &relativePath) {
+  refresh();
+
+  const auto result = byRelativePath.find(QDir::cleanPath(QString::fromStdString(relativePath)).toStdString());
+  if (result == byRelativePath.end())
+    return {};
+
+  return result->second;
+}
+
+} // namespace netsimulyzer
@@ -0,0 +1,124 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+#include <QDir>
+#include <QFileSystemWatcher>
+#include <QString>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace netsimulyzer {
+
+/**
+ * Index of every file in the resource directory.
+ *
+ * Built with a single walk of the resource directory, rather than
+ * searching the tree for each texture/model. Rebuilt when the root changes,
+ * or on the next lookup after a watched directory changes.
+ *
+ * Not thread safe, use only from the thread that owns it.
+ */
+class ResourceIndex {
+  /**
+   * The deepest directory under the root to index
+   */
+  static constexpr unsigned int maxDepth = 25u;
+
+  QDir root;
+
+  /**
+   * File name -> absolute path.
+   * If two files share a name, the first one found is kept
+   */
+  std::unordered_map<std::string, QString> byName;
+
+  /**
+   * Path relative to the root -> absolute path
+   */
+  std::unordered_map<std::string, QString> byRelativePath;
+
+  /**
+   * Notifies us when a file is added/removed/renamed
+   * in one of the indexed directories
+   */
+  QFileSystemWatcher watcher;
+
+  /**
+   * Flag indicating the index no longer matches the tree
+   */
+  bool stale = true;
+
+  void rebuild();
+  void indexDirectory(const QString &path, unsigned int depth);
+  void refresh();
+
+public:
+  ResourceIndex();
+
+  /**
+   * Index a new resource directory.
+   * Indexing is deferred until the next lookup
+   *
+   * @param value
+   * The root of the resource directory
+   */
+  void setRoot(const QDir &value);
+
+  [[nodiscard]] const QDir &getRoot() const;
+
+  /**
+   * Find a file anywhere under the root by its name
+   *
+   * @param fileName
+   * The name of the file, with no directory components (e.g. 'texture.png')
+   *
+   * @return
+   * The absolute path to the file, or an unset optional if no file has that name
+   */
+  std::optional<QString> findByName(const std::string &fileName);
+
+  /**
+   * Find a file by its path relative to the root
+   *
+   * @param relativePath
+   * The path from the root, using '/' separators (e.g. 'models/smartphone.obj')
+   *
+   * @return
+   * The absolute path to the file, or an unset optional if it is not in the index
+   */
+  std::optional<QString> findRelative(const std::string &relativePath);
+};
+
+} // namespace netsimulyzer
@@ -69,13 +69,16 @@ unsigned int Shader::compile(unsigned int type, const char *src) {
   return id;
 }
 
-unsigned int Shader::createProgram(const std::string &vertex, const std::string &fragment) {
+unsigned int Shader::createProgram(const std::string &vertex, const std::string &fragment, ShaderCache *cache) {
   const auto program_id = glCreateProgram();
   const auto vertex_shader = compile(GL_VERTEX_SHADER, vertex.c_str());
   const auto fragment_shader = compile(GL_FRAGMENT_SHADER, fragment.c_str());
 
   glAttachShader(program_id, vertex_shader);
   glAttachShader(program_id, fragment_shader);
+
+  if (cache)
+    cache->markRetrievable(program_id);
   glLinkProgram(program_id);
   glValidateProgram(program_id);
 
@@ -100,9 +103,21 @@ Shader::~Shader() {
   glDeleteProgram(glId);
 }
 
-void Shader::init(const std::string &vertex, const std::string &fragment) {
+void Shader::init(const std::string &vertex, const std::string &fragment, ShaderCache *cache) {
   initializeOpenGLFunctions();
-  glId = createProgram(vertex, fragment);
+
+  if (cache) {
+    const auto cached = cache->load(vertex, fragment);
+    if (cached) {
+      glId = *cached;
+      return;
+    }
+  }
+
+  glId = createProgram(vertex, fragment, cache);
+
+  if (cache)
+    cache->store(glId, vertex, fragment);
 }
 
 void Shader::uniform(const std::string &name, const glm::vec3 &value) {
@@ -32,6 +32,7 @@
  */
 
 #pragma once
+#include "ShaderCache.h"
 #include <QOpenGLFunctions_3_3_Core>
 #include <cstdio>
 #include <fstream>
@@ -47,11 +48,25 @@ class Shader : protected QOpenGLFunctions_3_3_Core {
   unsigned int glId = 0u;
 
   unsigned int compile(unsigned int type, const char *src);
-  unsigned int createProgram(const std::string &vertex, const std::string &fragment);
+  unsigned int createProgram(const std::string &vertex, const std::string &fragment, ShaderCache *cache);
 
 public:
   ~Shader() override;
-  void init(const std::string &vertex, const std::string &fragment);
+
+  /**
+   * Build the program from source, or load it from `cache`
+   *
+   * @param vertex
+   * The source of the vertex shader
+   *
+   * @param fragment
+   * The source of the fragment shader
+   *
+   * @param cache
+   * The program binary cache to use & fill.
+   * May be null, to always compile from source
+   */
+  void init(const std::string &vertex, const std::string &fragment, ShaderCache *cache = nullptr);
 
   void uniform(const std::string &name, const glm::vec3 &value);
   void uniform(const std::string &name, float value);
@@ -0,0 +1,198 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#include "ShaderCache.h"
+#include "../resource/CacheEntry.h"
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QOpenGLContext>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/**
+ * Identifies a shader cache entry file
+ */
+constexpr std::array<char, 4> magic{'N', 'S', 'S', 'C'};
+
+/**
+ * Increment whenever the entry layout changes
+ */
+constexpr std::uint32_t formatVersion = 1u;
+
+// From `GL_ARB_get_program_binary`, not defined by the 3.3 headers
+constexpr GLenum programBinaryRetrievableHint = 0x8257;
+constexpr GLenum programBinaryLength = 0x8741;
+constexpr GLenum numProgramBinaryFormats = 0x87FE;
+
+} // namespace
+
+namespace netsimulyzer {
+
+QString ShaderCache::entryPath(const std::string &vertex, const std::string &fragment) const {
+  QCryptographicHash hash{QCryptographicHash::Sha1};
+  hash.addData(driver);
+
+  // Separate the sources, so moving text between them changes the name
+  hash.addData(vertex.data(), static_cast<int>(vertex.size()));
+  hash.addData("\0", 1);
+  hash.addData(fragment.data(), static_cast<int>(fragment.size()));
+
+  return QDir{directory}.filePath(QString::fromLatin1(hash.result().toHex()) + ".program");
+}
+
+ShaderCache::ShaderCache()
+    : ShaderCache(QDir{QStandardPaths::writableLocation(QStandardPaths::CacheLocation)}.filePath("shaders")) {
+}
+
+ShaderCache::ShaderCache(QString directory) : directory(std::move(directory)) {
+}
+
+bool ShaderCache::init() {
+  initializeOpenGLFunctions();
+
+  auto *context = QOpenGLContext::currentContext();
+  if (!context || directory.isEmpty())
+    return false;
+
+  const auto version = context->format().version();
+  if (version < qMakePair(4, 1) && !context->hasExtension("GL_ARB_get_program_binary"))
+    return false;
+
+  // The driver may support the functions, but not offer any formats (e.g. some Mesa drivers)
+  int formatCount = 0;
+  glGetIntegerv(numProgramBinaryFormats, &formatCount);
+  if (formatCount < 1)
+    return false;
+
+  getProgramBinary = reinterpret_cast<GetProgramBinaryFunction>(context->getProcAddress("glGetProgramBinary"));
+  programBinary = reinterpret_cast<ProgramBinaryFunction>(context->getProcAddress("glProgramBinary"));
+  programParameteri = reinterpret_cast<ProgramParameteriFunction>(context->getProcAddress("glProgramParameteri"));
+
+  driver.clear();
+  for (const auto name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+    driver.append(reinterpret_cast<const char *>(glGetString(name)));
+    driver.append('\0');
+  }
+
+  return isEnabled();
+}
+
+bool ShaderCache::isEnabled() const {
+  return getProgramBinary && programBinary && programParameteri;
+}
+
+std::optional<unsigned int> ShaderCache::load(const std::string &vertex, const std::string &fragment) {
+  if (!isEnabled())
+    return {};
+
+  QFile file{entryPath(vertex, fragment)};
+  if (!file.open(QIODevice::ReadOnly))
+    return {};
+
+  const auto entry = file.readAll();
+  EntryReader reader{reinterpret_cast<const uchar *>(entry.constData()), entry.size()};
+
+  std::array<char, 4> entryMagic{};
+  std::uint32_t version;
+  GLenum binaryFormat;
+  std::uint32_t length;
+  std::vector<char> binary;
+  if (!reader.value(entryMagic) || entryMagic != magic || !reader.value(version) || version != formatVersion ||
+      !reader.value(binaryFormat) || !reader.value(length) || !reader.array(binary, length))
+    return {};
+
+  const auto program = glCreateProgram();
+  programBinary(program, binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+
+  int linked = GL_FALSE;
+  glGetProgramiv(program, GL_LINK_STATUS, &linked);
+  if (!linked) {
+    // Stale entry, the caller compiles from source & replaces it
+    glDeleteProgram(program);
+    return {};
+  }
+
+  return program;
+}
+
+void ShaderCache::markRetrievable(unsigned int program) {
+  if (isEnabled())
+    programParameteri(program, programBinaryRetrievableHint, GL_TRUE);
+}
+
+void ShaderCache::store(unsigned int program, const std::string &vertex, const std::string &fragment) {
+  if (!isEnabled())
+    return;
+
+  int linked = GL_FALSE;
+  glGetProgramiv(program, GL_LINK_STATUS, &linked);
+  if (!linked)
+    return;
+
+  int length = 0;
+  glGetProgramiv(program, programBinaryLength, &length);
+  if (length < 1)
+    return;
+
+  std::vector<char> binary(static_cast<std::size_t>(length));
+  GLenum binaryFormat;
+  getProgramBinary(program, length, &length, &binaryFormat, binary.data());
+
+  if (!QDir{}.mkpath(directory)) {
+    std::cerr << "Failed to create shader cache directory: " << directory.toStdString() << '\n';
+    return;
+  }
+
+  QByteArray buffer;
+  EntryWriter writer{buffer};
+  writer.value(magic);
+  writer.value(formatVersion);
+  writer.value(binaryFormat);
+  writer.value(static_cast<std::uint32_t>(length));
+  writer.bytes(binary.data(), static_cast<std::size_t>(length));
+
+  // Written to a temporary file first, so a reader never sees a partial entry
+  QSaveFile file{entryPath(vertex, fragment)};
+  if (!file.open(QIODevice::WriteOnly) || file.write(buffer) != buffer.size() || !file.commit())
+    std::cerr << "Failed to write shader cache entry: " << file.fileName().toStdString() << '\n';
+}
+
+} // namespace netsimulyzer
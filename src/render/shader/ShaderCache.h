@@ -0,0 +1,144 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+#include <QByteArray>
+#include <QOpenGLFunctions_3_3_Core>
+#include <QString>
+#include <optional>
+#include <qopengl.h>
+#include <string>
+
+namespace netsimulyzer {
+
+/**
+ * On-disk cache of linked shader program binaries.
+ *
+ * Uses `glGetProgramBinary`/`glProgramBinary`, which are only core in OpenGL 4.1,
+ * so they are resolved at runtime, and the cache disables itself
+ * when neither OpenGL 4.1 nor `GL_ARB_get_program_binary` is available.
+ *
+ * Entries are keyed by the shader sources, along with the
+ * GL vendor, renderer, and version strings, since a binary is only
+ * valid for the driver which produced it.
+ */
+class ShaderCache : protected QOpenGLFunctions_3_3_Core {
+  using GetProgramBinaryFunction = void(QOPENGLF_APIENTRYP)(GLuint program, GLsizei bufferSize, GLsizei *length,
+                                                            GLenum *binaryFormat, void *binary);
+  using ProgramBinaryFunction = void(QOPENGLF_APIENTRYP)(GLuint program, GLenum binaryFormat, const void *binary,
+                                                         GLsizei length);
+  using ProgramParameteriFunction = void(QOPENGLF_APIENTRYP)(GLuint program, GLenum name, GLint value);
+
+  GetProgramBinaryFunction getProgramBinary = nullptr;
+  ProgramBinaryFunction programBinary = nullptr;
+  ProgramParameteriFunction programParameteri = nullptr;
+
+  /**
+   * Directory the cache entries are stored in.
+   * Empty if the cache is disabled
+   */
+  QString directory;
+
+  /**
+   * The GL vendor, renderer, and version strings,
+   * prepended to the sources when building entry names
+   */
+  QByteArray driver;
+
+  [[nodiscard]] QString entryPath(const std::string &vertex, const std::string &fragment) const;
+
+public:
+  /**
+   * Use the platform's cache location
+   */
+  ShaderCache();
+
+  /**
+   * @param directory
+   * The directory to store entries in. May not exist yet.
+   * An empty directory disables the cache
+   */
+  explicit ShaderCache(QString directory);
+
+  /**
+   * Resolve the program binary functions & identify the driver.
+   * Must be called with the GL context current
+   *
+   * @return
+   * True if program binaries are supported, false if the cache is disabled
+   */
+  bool init();
+
+  [[nodiscard]] bool isEnabled() const;
+
+  /**
+   * Create a program from a cached binary
+   *
+   * @param vertex
+   * The source of the vertex shader
+   *
+   * @param fragment
+   * The source of the fragment shader
+   *
+   * @return
+   * The linked program, or an unset optional if there is no entry,
+   * or the driver rejected it (e.g. after a driver update)
+   */
+  std::optional<unsigned int> load(const std::string &vertex, const std::string &fragment);
+
+  /**
+   * Ask the driver to keep the binary of a program.
+   * Must be called before the program is linked
+   *
+   * @param program
+   * The program to be linked
+   */
+  void markRetrievable(unsigned int program);
+
+  /**
+   * Store the binary of a linked program.
+   * Failures are reported, but otherwise ignored
+   *
+   * @param program
+   * The linked program
+   *
+   * @param vertex
+   * The source of the vertex shader `program` was built from
+   *
+   * @param fragment
+   * The source of the fragment shader `program` was built from
+   */
+  void store(unsigned int program, const std::string &vertex, const std::string &fragment);
+};
+
+} // namespace netsimulyzer
@@ -36,45 +36,40 @@
 #include <QDebug>
 #include <QDir>
 #include <QImage>
+#include <QRunnable>
 #include <QString>
+#include <QThreadPool>
 #include <Qt>
+#include <algorithm>
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <trace.h>
+#include <unordered_set>
 #include <utility>
 
 namespace {
-std::optional<QFileInfo> findTexture(const QDir &base, const QString &fileName, unsigned int max = 25u) {
-  // Cut us off after `max` levels
-  if (max == 0u)
-    return {};
-
-  QDir searchFile{base};
-  searchFile.setFilter(QDir::Files | QDir::Readable);
-  searchFile.setNameFilters({fileName});
 
-  auto fileResults = searchFile.entryInfoList();
-  if (fileResults.count() > 0)
-    return {fileResults[0]};
-
-  QDir subDirectories{base};
-  subDirectories.setFilter(QDir::Dirs | QDir::Readable | QDir::NoDotAndDotDot);
-  // no name filter
+/**
+ * Runs a single texture decode on a `QThreadPool`
+ */
+class DecodeTask : public QRunnable {
+  std::function<void()> work;
 
-  auto directoryResults = subDirectories.entryInfoList();
-  for (const auto &subDirectory : directoryResults) {
-    auto result = findTexture({subDirectory.canonicalFilePath()}, fileName, max - 1);
-    if (result)
-      return result;
+public:
+  explicit DecodeTask(std::function<void()> work) : work(std::move(work)) {
   }
 
-  return {};
-}
+  void run() override {
+    work();
+  }
+};
 
 } // namespace
 
 namespace netsimulyzer {
 
-void TextureCache::setResourceDirectory(const QDir &value) {
-  resourceDirectory = value;
+TextureCache::TextureCache(ResourceIndex &resources) : resources(resources) {
 }
 
 TextureCache::~TextureCache() {
@@ -114,83 +109,169 @@ bool TextureCache::init() {
   return true;
 }
 
-texture_id TextureCache::load(const std::string &filename) {
-
-  // If we've already loaded the texture, use that ID
-  auto existing = indexMap.find(filename);
-  if (existing != indexMap.end()) {
-    return existing->second;
+std::optional<TextureData> TextureCache::decode(const QString &path, bool mipmaps,
+                                                const TextureDiskCache &diskCache) {
+  NETSIMULYZER_TRACE_SCOPE("TextureCache::decode");
+  const auto cacheKey = TextureDiskCache::key(path);
+  if (cacheKey) {
+    auto cached = diskCache.read(*cacheKey, mipmaps);
+    if (cached)
+      return cached;
   }
 
-  auto result = findTexture(resourceDirectory, QString::fromStdString(filename));
-  if (!result)
-    return fallbackTexture;
+  QImage image{path};
+  if (image.isNull())
+    return {};
+
+  TextureData data;
+  data.hasAlpha = image.hasAlphaChannel();
 
-  QImage image{result->canonicalFilePath()};
+  // Byte order R, G, B, A regardless of platform endianness
+  image = image.convertToFormat(QImage::Format_RGBA8888);
   if (image.isNull())
-    return fallbackTexture;
+    return {};
+
+  const auto levelCount = mipmaps ? TextureData::mipLevelCount(image.width(), image.height()) : 1u;
+  data.levels.reserve(levelCount);
+
+  for (auto i = 0u; i < levelCount; i++) {
+    if (i > 0u) {
+      image = image.scaled(std::max(1, image.width() / 2), std::max(1, image.height() / 2), Qt::IgnoreAspectRatio,
+                           Qt::SmoothTransformation);
+    }
+
+    auto &level = data.levels.emplace_back();
+    level.width = image.width();
+    level.height = image.height();
+
+    // Copy by row, since `QImage` may pad the end of each one
+    const auto rowSize = static_cast<std::size_t>(level.width) * 4u;
+    level.pixels.resize(rowSize * static_cast<std::size_t>(level.height));
+    for (auto row = 0; row < level.height; row++) {
+      std::memcpy(level.pixels.data() + rowSize * static_cast<std::size_t>(row), image.constScanLine(row), rowSize);
+    }
+  }
+
+  if (cacheKey)
+    diskCache.write(*cacheKey, data);
 
-  unsigned int glFormat;
-  switch (image.format()) {
-  case QImage::Format::Format_RGB32:
-    glFormat = GL_RGB;
-    break;
-  case QImage::Format::Format_ARGB32:
-    glFormat = GL_RGBA;
-    break;
-  default:
-    qDebug() << "Unsupported format: " << image.format() << "\nAttempting conversion...";
-    image = image.convertToFormat(QImage::Format_ARGB32);
-    glFormat = GL_RGBA;
-
-    if (image.isNull())
-      return fallbackTexture;
+  return data;
+}
+
+std::vector<std::optional<TextureData>> TextureCache::decodeAll(const std::vector<QString> &paths,
+                                                                bool mipmaps) const {
+  std::vector<std::optional<TextureData>> results(paths.size());
+
+  QThreadPool pool;
+  for (auto i = 0u; i < paths.size(); i++) {
+    // The pool deletes the task once it is done
+    pool.start(new DecodeTask{[&, i]() { results[i] = decode(paths[i], mipmaps, diskCache); }});
   }
+  pool.waitForDone();
+
+  return results;
+}
+
+texture_id TextureCache::upload(const std::string &key, const TextureData &data) {
+  NETSIMULYZER_TRACE_SCOPE("TextureCache::upload");
+  const auto &base = data.levels.front();
 
   Texture t;
-  t.height = image.height();
-  t.width = image.width();
+  t.height = base.height;
+  t.width = base.width;
 
   glGenTextures(1, &t.id);
   glBindTexture(GL_TEXTURE_2D, t.id);
 
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  // Only sample between levels when there is a chain to sample from
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, data.levels.size() > 1u ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-  // QImage keeps BGRA format, event without an alpha channel
-  glTexImage2D(GL_TEXTURE_2D, 0, glFormat, t.width, t.height, 0, GL_BGRA, GL_UNSIGNED_BYTE, image.constBits());
-
-  glGenerateMipmap(GL_TEXTURE_2D);
+  // Upload the prebuilt mip chain, rather than generating one on the GPU
+  const auto internalFormat = data.hasAlpha ? GL_RGBA : GL_RGB;
+  for (auto i = 0u; i < data.levels.size(); i++) {
+    const auto &level = data.levels[i];
+    glTexImage2D(GL_TEXTURE_2D, static_cast<int>(i), internalFormat, level.width, level.height, 0, GL_RGBA,
+                 GL_UNSIGNED_BYTE, level.pixels.data());
+  }
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<int>(data.levels.size()) - 1);
 
   glBindTexture(GL_TEXTURE_2D, 0u);
 
   textures.emplace_back(t);
   const auto newIndex = textures.size() - 1;
-  indexMap.emplace(result->canonicalFilePath().toStdString(), newIndex);
+  indexMap.emplace(key, newIndex);
   return newIndex;
 }
 
+void TextureCache::preload(const std::vector<std::string> &filenames) {
+  NETSIMULYZER_TRACE_SCOPE("TextureCache::preload");
+  std::vector<QString> pending;
+  std::unordered_set<std::string> seen;
+  for (const auto &filename : filenames) {
+    const auto result = resources.findByName(filename);
+    if (!result)
+      continue;
+
+    auto key = result->toStdString();
+    if (indexMap.find(key) != indexMap.end() || !seen.insert(std::move(key)).second)
+      continue;
+
+    pending.emplace_back(*result);
+  }
+
+  if (pending.empty())
+    return;
+
+  auto results = decodeAll(pending, true);
+  for (auto i = 0u; i < pending.size(); i++) {
+    // Failures are left out, so `load()` returns the fallback for them
+    if (results[i])
+      upload(pending[i].toStdString(), *results[i]);
+  }
+}
+
+texture_id TextureCache::load(const std::string &filename) {
+  auto result = resources.findByName(filename);
+  if (!result)
+    return fallbackTexture;
+
+  // If we've already loaded the texture, use that ID
+  const auto key = result->toStdString();
+  auto existing = indexMap.find(key);
+  if (existing != indexMap.end()) {
+    return existing->second;
+  }
+
+  const auto data = decode(*result, true, diskCache);
+  if (!data)
+    return fallbackTexture;
+
+  return upload(key, *data);
+}
+
 unsigned int TextureCache::load(const CubeMap &cubeMap) {
+  NETSIMULYZER_TRACE_SCOPE("TextureCache::loadCubeMap");
+  // Same order as the `GL_TEXTURE_CUBE_MAP_*` targets
+  const auto faces = decodeAll({cubeMap.right, cubeMap.left, cubeMap.top, cubeMap.bottom, cubeMap.back, cubeMap.front},
+                               false);
+
   unsigned int id;
   glGenTextures(1, &id);
   glBindTexture(GL_TEXTURE_CUBE_MAP, id);
 
-  glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X, 0, GL_RGB, cubeMap.right.width(), cubeMap.right.height(), 0, GL_BGRA,
-               GL_UNSIGNED_BYTE, cubeMap.right.constBits());
-  glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_X, 0, GL_RGB, cubeMap.left.width(), cubeMap.left.height(), 0, GL_BGRA,
-               GL_UNSIGNED_BYTE, cubeMap.left.constBits());
-
-  glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_Y, 0, GL_RGB, cubeMap.top.width(), cubeMap.top.height(), 0, GL_BGRA,
-               GL_UNSIGNED_BYTE, cubeMap.top.constBits());
-  glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_Y, 0, GL_RGB, cubeMap.bottom.width(), cubeMap.bottom.height(), 0, GL_BGRA,
-               GL_UNSIGNED_BYTE, cubeMap.bottom.constBits());
+  for (auto i = 0u; i < faces.size(); i++) {
+    if (!faces[i]) {
+      std::cerr << "Failed to load skybox face " << i << '\n';
+      continue;
+    }
 
-  glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_Z, 0, GL_RGB, cubeMap.back.width(), cubeMap.back.height(), 0, GL_BGRA,
-               GL_UNSIGNED_BYTE, cubeMap.back.constBits());
-  glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_Z, 0, GL_RGB, cubeMap.front.width(), cubeMap.front.height(), 0, GL_BGRA,
-               GL_UNSIGNED_BYTE, cubeMap.front.constBits());
+    const auto &level = faces[i]->levels.front();
+    glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB, level.width, level.height, 0, GL_RGBA,
+                 GL_UNSIGNED_BYTE, level.pixels.data());
+  }
 
   glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
   glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
@@ -33,10 +33,13 @@
 
 #pragma once
 
+#include "../resource/ResourceIndex.h"
+#include "TextureData.h"
+#include "TextureDiskCache.h"
 #include "texture.h"
 #include <QDir>
-#include <QImage>
 #include <QOpenGLFunctions_3_3_Core>
+#include <QString>
 #include <array>
 #include <cstddef>
 #include <optional>
@@ -55,24 +58,109 @@ class TextureCache : protected QOpenGLFunctions_3_3_Core {
   std::unordered_map<std::string, std::size_t> indexMap;
   std::vector<Texture> textures;
   texture_id fallbackTexture;
-  QDir resourceDirectory;
+  ResourceIndex &resources;
+
+  /**
+   * Previously decoded textures, so unchanged images skip decoding
+   */
+  TextureDiskCache diskCache;
+
+  /**
+   * Decode an image into RGBA levels.
+   * Uses the disk cache entry for the image if there is one,
+   * otherwise decodes the image and stores the result in the disk cache.
+   *
+   * Touches no `TextureCache` state, so it is safe to call from any thread
+   *
+   * @param path
+   * The path to the image. May be a Qt resource path
+   *
+   * @param mipmaps
+   * If the full mip chain should be built, rather than only the base level
+   *
+   * @param diskCache
+   * The cache to check & fill
+   *
+   * @return
+   * The decoded texture, or an unset optional if the image could not be read
+   */
+  static std::optional<TextureData> decode(const QString &path, bool mipmaps, const TextureDiskCache &diskCache);
+
+  /**
+   * Decode several images in parallel on a thread pool
+   *
+   * @param paths
+   * The paths to the images. May be Qt resource paths
+   *
+   * @param mipmaps
+   * If the full mip chain should be built for each image
+   *
+   * @return
+   * The result of `decode()` for each of `paths`, in the same order
+   */
+  [[nodiscard]] std::vector<std::optional<TextureData>> decodeAll(const std::vector<QString> &paths,
+                                                                  bool mipmaps) const;
+
+  /**
+   * Upload a decoded texture & record it under `key`.
+   * Must be called with the GL context current
+   *
+   * @param key
+   * The resolved path the texture was decoded from
+   *
+   * @param data
+   * The decoded texture
+   *
+   * @return
+   * The ID of the new texture
+   */
+  texture_id upload(const std::string &key, const TextureData &data);
 
 public:
+  /**
+   * Paths to each face of a cube map.
+   * May be Qt resource paths
+   */
   struct CubeMap {
-    QImage right;
-    QImage left;
-    QImage top;
-    QImage bottom;
-    QImage back;
-    QImage front;
+    QString right;
+    QString left;
+    QString top;
+    QString bottom;
+    QString back;
+    QString front;
   };
 
+  /**
+   * @param resources
+   * The index textures are found through
+   */
+  explicit TextureCache(ResourceIndex &resources);
   ~TextureCache() override;
 
   bool init();
 
-  void setResourceDirectory(const QDir &value);
+  /**
+   * Decode every texture in `filenames` that is not already loaded on a thread pool,
+   * then upload them. Later calls to `load()` with any of these names are cache hits.
+   *
+   * Must be called with the GL context current.
+   *
+   * @param filenames
+   * The texture file names, as passed to `load()`. May contain duplicates
+   */
+  void preload(const std::vector<std::string> &filenames);
+
   texture_id load(const std::string &filename);
+
+  /**
+   * Load a cube map, decoding the faces in parallel
+   *
+   * @param cubeMap
+   * The paths to each face
+   *
+   * @return
+   * The OpenGL ID of the new cube map texture
+   */
   unsigned int load(const CubeMap &cubeMap);
   [[nodiscard]] const Texture &get(texture_id index);
 
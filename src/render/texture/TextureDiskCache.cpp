@@ -0,0 +1,165 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#include "TextureDiskCache.h"
+#include "../resource/CacheEntry.h"
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+
+namespace {
+
+/**
+ * Identifies a texture cache entry file
+ */
+constexpr std::array<char, 4> magic{'N', 'S', 'T', 'C'};
+
+/**
+ * Increment whenever the entry layout changes
+ */
+constexpr std::uint32_t formatVersion = 1u;
+
+} // namespace
+
+namespace netsimulyzer {
+
+QString TextureDiskCache::entryPath(const Key &key) const {
+  return QDir{directory}.filePath(QString::fromLatin1(key.hash.toHex()) + ".texture");
+}
+
+TextureDiskCache::TextureDiskCache()
+    : TextureDiskCache(QDir{QStandardPaths::writableLocation(QStandardPaths::CacheLocation)}.filePath("textures")) {
+}
+
+TextureDiskCache::TextureDiskCache(QString directory) : directory(std::move(directory)) {
+}
+
+std::optional<TextureDiskCache::Key> TextureDiskCache::key(const QString &path) {
+  QFile file{path};
+  if (!file.open(QIODevice::ReadOnly))
+    return {};
+
+  QCryptographicHash hash{QCryptographicHash::Sha1};
+  if (!hash.addData(&file))
+    return {};
+
+  return Key{file.size(), hash.result()};
+}
+
+std::optional<TextureData> TextureDiskCache::read(const Key &key, bool mipmaps) const {
+  if (directory.isEmpty())
+    return {};
+
+  QFile file{entryPath(key)};
+  if (!file.open(QIODevice::ReadOnly))
+    return {};
+
+  const auto size = file.size();
+  const auto *mapped = file.map(0, size);
+  if (!mapped)
+    return {};
+
+  EntryReader reader{mapped, size};
+
+  std::array<char, 4> entryMagic{};
+  std::uint32_t version;
+  qint64 fileSize;
+  std::uint8_t hasAlpha;
+  std::uint32_t levelCount;
+  if (!reader.value(entryMagic) || entryMagic != magic || !reader.value(version) || version != formatVersion ||
+      !reader.value(fileSize) || fileSize != key.size || !reader.value(hasAlpha) || !reader.value(levelCount) ||
+      levelCount == 0u || levelCount > 32u)
+    return {};
+
+  TextureData data;
+  data.hasAlpha = hasAlpha;
+
+  // Only the base level is needed without mipmaps,
+  // so skip reading the rest of the chain, if there is one
+  data.levels.resize(mipmaps ? levelCount : 1u);
+  for (auto &level : data.levels) {
+    std::int32_t width;
+    std::int32_t height;
+    if (!reader.value(width) || !reader.value(height) || width <= 0 || height <= 0 ||
+        !reader.array(level.pixels, static_cast<std::uint32_t>(width) * static_cast<std::uint32_t>(height) * 4u))
+      return {};
+
+    level.width = width;
+    level.height = height;
+  }
+
+  // An entry written without mip levels does not satisfy a request with them
+  const auto &base = data.levels.front();
+  if (mipmaps && levelCount != TextureData::mipLevelCount(base.width, base.height))
+    return {};
+
+  return data;
+}
+
+void TextureDiskCache::write(const Key &key, const TextureData &data) const {
+  if (directory.isEmpty())
+    return;
+
+  if (!QDir{}.mkpath(directory)) {
+    std::cerr << "Failed to create texture cache directory: " << directory.toStdString() << '\n';
+    return;
+  }
+
+  QByteArray buffer;
+  EntryWriter writer{buffer};
+
+  writer.value(magic);
+  writer.value(formatVersion);
+  writer.value(key.size);
+  writer.value(static_cast<std::uint8_t>(data.hasAlpha));
+  writer.value(static_cast<std::uint32_t>(data.levels.size()));
+
+  for (const auto &level : data.levels) {
+    writer.value(static_cast<std::int32_t>(level.width));
+    writer.value(static_cast<std::int32_t>(level.height));
+    writer.bytes(level.pixels.data(), level.pixels.size());
+  }
+
+  // Written to a temporary file first, so a reader never sees a partial entry
+  QSaveFile file{entryPath(key)};
+  if (!file.open(QIODevice::WriteOnly) || file.write(buffer) != buffer.size() || !file.commit())
+    std::cerr << "Failed to write texture cache entry: " << file.fileName().toStdString() << '\n';
+}
+
+} // namespace netsimulyzer
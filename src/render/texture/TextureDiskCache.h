@@ -0,0 +1,124 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+#include "TextureData.h"
+#include <QByteArray>
+#include <QString>
+#include <QtGlobal>
+#include <optional>
+
+namespace netsimulyzer {
+
+/**
+ * On-disk cache of decoded textures, including their mip levels.
+ *
+ * Entries are keyed by the hash of the encoded image,
+ * so the same image under several names/paths shares an entry,
+ * and images compiled into the application (e.g. the skybox) may be cached too.
+ *
+ * All methods are const & touch only the filesystem,
+ * so the cache may be used from several decode threads at once.
+ */
+class TextureDiskCache {
+public:
+  /**
+   * Identifies the contents of an image file
+   */
+  struct Key {
+    qint64 size = 0;
+    QByteArray hash;
+  };
+
+private:
+  /**
+   * Directory the cache entries are stored in.
+   * Empty if the cache is disabled
+   */
+  QString directory;
+
+  [[nodiscard]] QString entryPath(const Key &key) const;
+
+public:
+  /**
+   * Use the platform's cache location
+   */
+  TextureDiskCache();
+
+  /**
+   * @param directory
+   * The directory to store entries in. May not exist yet.
+   * An empty directory disables the cache
+   */
+  explicit TextureDiskCache(QString directory);
+
+  /**
+   * Build the key for the current contents of an image file
+   *
+   * @param path
+   * The path to the image. May be a Qt resource path
+   *
+   * @return
+   * The key, or an unset optional if the file could not be read
+   */
+  [[nodiscard]] static std::optional<Key> key(const QString &path);
+
+  /**
+   * Load a decoded texture from the cache.
+   * The entry is memory mapped, rather than read through a buffer
+   *
+   * @param key
+   * The key of the encoded image
+   *
+   * @param mipmaps
+   * If the entry must contain the full mip chain
+   *
+   * @return
+   * The cached texture, or an unset optional if there is no valid entry for `key`
+   */
+  [[nodiscard]] std::optional<TextureData> read(const Key &key, bool mipmaps) const;
+
+  /**
+   * Store a decoded texture in the cache, replacing any existing entry.
+   * Failures are reported, but otherwise ignored
+   *
+   * @param key
+   * The key of the encoded image `data` was decoded from
+   *
+   * @param data
+   * The decoded texture
+   */
+  void write(const Key &key, const TextureData &data) const;
+};
+
+} // namespace netsimulyzer
@@ -0,0 +1,459 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#include "Scene.h"
+#include <QDir>
+#include <algorithm>
+#include <cmath>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <iostream>
+#include <string>
+#include <trace.h>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace netsimulyzer {
+
+void Scene::handleEvents() {
+  NETSIMULYZER_TRACE_SCOPE("Scene::handleEvents");
+  // Returns true after handling an event
+  // false otherwise
+  auto handleEvent = [this](auto &&arg) -> bool {
+    // Strip off qualifiers, etc
+    // so T holds just the type
+    // so we can more easily match it
+    using T = std::decay_t<decltype(arg)>;
+
+    // All events have a time
+    // Make sure we don't handle one in the future
+    if (arg.time > simulationTime)
+      return false;
+
+    if constexpr (std::is_same_v<T, parser::MoveEvent> || std::is_same_v<T, parser::NodeOrientationChangeEvent> ||
+                  std::is_same_v<T, parser::NodeColorChangeEvent> || std::is_same_v<T, parser::TransmitEvent> ||
+                  std::is_same_v<T, parser::TransmitEndEvent>) {
+      auto node = nodes.find(arg.nodeId);
+      if (node == nodes.end())
+        return false;
+      undoEvents.emplace_back(node->second.handle(arg));
+      return true;
+    } else if constexpr (std::is_same_v<T, parser::DecorationMoveEvent> ||
+                         std::is_same_v<T, parser::DecorationOrientationChangeEvent>) {
+      auto decoration = decorations.find(arg.decorationId);
+      if (decoration == decorations.end())
+        return false;
+      undoEvents.emplace_back(decoration->second.handle(arg));
+      return true;
+    }
+  };
+
+  while (!events.empty() && std::visit(handleEvent, events.front())) {
+    events.pop_front();
+  }
+}
+
+void Scene::handleUndoEvents() {
+  NETSIMULYZER_TRACE_SCOPE("Scene::handleUndoEvents");
+  auto handleUndoEvent = [this](auto &&arg) -> bool {
+    // Strip off qualifiers, etc
+    // so T holds just the type
+    // so we can more easily match it
+    using T = std::decay_t<decltype(arg)>;
+
+    // All events have a time
+    // Make sure we don't handle one
+    // Before it was originally applied
+    if (simulationTime > arg.event.time)
+      return false;
+
+    if constexpr (std::is_same_v<T, undo::MoveEvent> || std::is_same_v<T, undo::NodeOrientationChangeEvent> ||
+                  std::is_same_v<T, undo::TransmitEvent> || std::is_same_v<T, undo::TransmitEndEvent> ||
+                  std::is_same_v<T, undo::NodeColorChangeEvent>) {
+      auto node = nodes.find(arg.event.nodeId);
+      if (node == nodes.end())
+        return false;
+      node->second.handle(arg);
+
+      events.emplace_front(arg.event);
+      return true;
+    }
+
+    if constexpr (std::is_same_v<T, undo::DecorationMoveEvent> ||
+                  std::is_same_v<T, undo::DecorationOrientationChangeEvent>) {
+      auto decoration = decorations.find(arg.event.decorationId);
+      if (decoration == decorations.end())
+        return false;
+      decoration->second.handle(arg);
+
+      events.emplace_front(arg.event);
+      return true;
+    }
+
+    return false;
+  };
+
+  while (!undoEvents.empty() && std::visit(handleUndoEvent, undoEvents.back())) {
+    undoEvents.pop_back();
+  }
+}
+
+void Scene::rebuildStaticGeometry() {
+  areaBatch = std::make_unique<StaticBatch>(renderer.allocateAreas(areas));
+  buildingBatch = std::make_unique<StaticBatch>(renderer.allocateBuildings(buildings));
+  buildingOutlineBatch = std::make_unique<StaticBatch>(renderer.allocateBuildingOutlines(buildings));
+}
+
+void Scene::initialize() {
+  if (!initializeOpenGLFunctions()) {
+    std::cerr << "Failed OpenGL functions\n";
+    std::abort();
+  }
+
+  if (!textures.init()) {
+    std::cerr << "Failed Initializing Texture Cache\n";
+    std::abort();
+  }
+
+  models.init("models/fallback.obj");
+  renderer.init();
+
+  transmissionSphere = std::make_unique<Model>(models.load("models/transmission_sphere.obj"));
+  transmissionSpheres = renderer.allocateTransmissionSpheres(*transmissionSphere);
+
+  TextureCache::CubeMap cubeMap;
+  cubeMap.right = ":/texture/resources/textures/skybox/right.png";
+  cubeMap.left = ":/texture/resources/textures/skybox/left.png";
+  cubeMap.top = ":/texture/resources/textures/skybox/top.png";
+  cubeMap.bottom = ":/texture/resources/textures/skybox/bottom.png";
+  cubeMap.back = ":/texture/resources/textures/skybox/back.png";
+  cubeMap.front = ":/texture/resources/textures/skybox/front.png";
+  skyBox = std::make_unique<SkyBox>(textures.load(cubeMap));
+
+  floor = std::make_unique<Floor>(renderer.allocateFloor(100.0f), 100.0f);
+  floor->setPosition({0.0f, -0.5f, 0.0f});
+
+  coordinateGrid = std::make_unique<CoordinateGrid>(
+      renderer.allocateCoordinateGrid(100.0f, settings.get<int>(SettingsManager::Key::RenderGridStep).value()));
+  coordinateGrid->setHeight(-0.1f);
+
+  trailPool = std::make_unique<TrailPool>();
+  nodePositions = std::make_unique<NodePositionBuffer>();
+  passTimer = std::make_unique<PassTimer>();
+
+  mainLight.ambientIntensity = 0.9f;
+  mainLight.color = {1.0f, 1.0f, 1.0f};
+  mainLight.direction = {-2.0f, -1.0f, -2.0f};
+  mainLight.diffuseIntensity = 0.5f;
+  renderer.render(mainLight);
+}
+
+void Scene::setConfiguration(parser::GlobalConfiguration configuration) {
+  config = configuration;
+
+  // Resize ground plane to the farthest away item/event
+  auto newSize = std::max({std::abs(config.minLocation.x), std::abs(config.maxLocation.x),
+                           std::abs(config.minLocation.y), std::abs(config.maxLocation.y)});
+
+  // Don't resize beneath the default
+  if (newSize > 100.0f) {
+    renderer.resize(*floor, newSize + 50.0f); // Give the new size a bit of extra overrun
+    renderer.resize(*coordinateGrid, newSize + 50.0f, settings.get<int>(SettingsManager::Key::RenderGridStep).value());
+  }
+}
+
+const parser::GlobalConfiguration &Scene::getConfiguration() const {
+  return config;
+}
+
+void Scene::reset() {
+  areas.clear();
+  buildings.clear();
+  areaBatch.reset();
+  buildingBatch.reset();
+  buildingOutlineBatch.reset();
+  wiredLinkBatch.reset();
+
+  nodes.clear();
+  if (trailPool)
+    trailPool->clear();
+  if (nodePositions)
+    nodePositions->clear();
+  decorations.clear();
+  wiredLinks.clear();
+  events.clear();
+  undoEvents.clear();
+  simulationTime = 0LL;
+}
+
+void Scene::add(const std::vector<parser::Area> &areaModels, const std::vector<parser::Building> &buildingModels,
+                const std::vector<parser::Decoration> &decorationModels, const std::vector<parser::WiredLink> &links,
+                const std::vector<parser::Node> &nodeModels) {
+  areas.reserve(areaModels.size());
+  for (const auto &area : areaModels) {
+    areas.emplace_back(area);
+  }
+
+  buildings.reserve(buildingModels.size());
+  for (const auto &building : buildingModels) {
+    buildings.emplace_back(building);
+  }
+  rebuildStaticGeometry();
+
+  // Import every model up front, so the imports may run in parallel
+  std::vector<std::string> modelPaths;
+  modelPaths.reserve(decorationModels.size() + nodeModels.size());
+  for (const auto &decoration : decorationModels) {
+    modelPaths.emplace_back(decoration.model);
+  }
+  for (const auto &node : nodeModels) {
+    modelPaths.emplace_back(node.model);
+  }
+  models.preload(modelPaths);
+
+  decorations.reserve(decorationModels.size());
+  for (const auto &decoration : decorationModels) {
+    decorations.try_emplace(decoration.id, Model{models.load(decoration.model)}, decoration);
+  }
+
+  nodes.reserve(nodeModels.size());
+  const auto trailLength = settings.get<int>(SettingsManager::Key::RenderMotionTrailLength).value();
+  for (const auto &node : nodeModels) {
+    nodes.try_emplace(node.id, Model{models.load(node.model)}, node, trailPool->allocate(trailLength));
+  }
+
+  for (auto &[id, node] : nodes) {
+    node.setPositionBuffer(*nodePositions, nodePositions->allocate());
+  }
+
+  wiredLinks.reserve(links.size());
+  for (const auto &link : links) {
+    std::vector<int> positionIndices;
+    positionIndices.reserve(link.nodes.size());
+
+    // Flag to ignore links with non-configured nodes
+    // should be picked up by the ns-3 module, but just in case
+    bool ignoreLink = false;
+    for (const auto nodeId : link.nodes) {
+      const auto &node = nodes.find(nodeId);
+
+      if (node == nodes.end()) {
+        std::cerr << "A wired link references an unknown Node with ID: " << nodeId << " ignoring link\n";
+        ignoreLink = true;
+        continue;
+      }
+
+      positionIndices.emplace_back(node->second.getPositionIndex());
+    }
+
+    if (!ignoreLink)
+      wiredLinks.emplace_back(link, std::move(positionIndices));
+  }
+  wiredLinkBatch = std::make_unique<StaticBatch>(renderer.allocateWiredLinks(wiredLinks));
+}
+
+void Scene::enqueueEvents(const std::vector<parser::SceneEvent> &e) {
+  events.insert(events.end(), e.begin(), e.end());
+}
+
+void Scene::setTime(parser::nanoseconds value) {
+  simulationTime = value;
+}
+
+parser::nanoseconds Scene::getTime() const {
+  return simulationTime;
+}
+
+const std::unordered_map<unsigned int, Node> &Scene::getNodes() const {
+  return nodes;
+}
+
+void Scene::setPerspective(float fieldOfView, int width, int height) {
+  renderer.setPerspective(glm::perspective(glm::radians(fieldOfView),
+                                           static_cast<float>(width) / static_cast<float>(height), 0.1f, 1000.0f));
+}
+
+void Scene::setResourcePath(const QString &value) {
+  resources.setRoot(QDir{value});
+}
+
+void Scene::setSkyboxRenderState(bool enable) {
+  renderSkybox = enable;
+}
+
+void Scene::setBuildingRenderMode(SettingsManager::BuildingRenderMode mode) {
+  buildingRenderMode = mode;
+}
+
+void Scene::setBuildingRenderOutlines(bool enable) {
+  renderBuildingOutlines = enable;
+}
+
+void Scene::setRenderGrid(bool enable) {
+  renderGrid = enable;
+}
+
+void Scene::changeGridStepSize(int stepSize) {
+  // Keep the same square size, but change the grid step
+  renderer.resize(*coordinateGrid, coordinateGrid->getRenderInfo().squareSize, stepSize);
+}
+
+PassTimer &Scene::getPassTimer() {
+  return *passTimer;
+}
+
+void Scene::setRenderTrails(bool enable) {
+  renderMotionTrails = enable;
+}
+
+void Scene::render(const Camera &camera) {
+  using Pass = PassTimer::Pass;
+  passTimer->beginFrame();
+
+  // Set every frame, since anything painting over
+  // the scene (e.g. a QPainter) may change them
+  glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+  glEnable(GL_DEPTH_TEST);
+  glDepthMask(GL_TRUE);
+  glDisable(GL_BLEND);
+  glDisable(GL_SCISSOR_TEST);
+  glDisable(GL_STENCIL_TEST);
+
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); // NOLINT(hicpp-signed-bitwise)
+  renderer.use(camera);
+  if (renderSkybox) {
+    passTimer->begin(Pass::Skybox);
+    renderer.render(*skyBox);
+    passTimer->end();
+  }
+
+  passTimer->begin(Pass::Nodes);
+
+  trailDrawList.clear();
+  for (auto &[key, node] : nodes) {
+    if (!node.visible())
+      continue;
+    renderer.render(node.getModel());
+    if (renderMotionTrails)
+      node.getTrailBuffer().appendDrawRanges(trailDrawList.first, trailDrawList.counts);
+  }
+  passTimer->end();
+
+  passTimer->begin(Pass::Trails);
+  renderer.render(*trailPool, trailDrawList);
+  passTimer->end();
+
+  passTimer->begin(Pass::Decorations);
+  for (auto &[key, decoration] : decorations) {
+    renderer.render(decoration.getModel());
+  }
+  passTimer->end();
+
+  passTimer->begin(Pass::Floor);
+  renderer.render(*floor);
+  passTimer->end();
+
+  if (areaBatch) {
+    passTimer->begin(Pass::Areas);
+    renderer.render(*areaBatch);
+    passTimer->end();
+  }
+
+  if (buildingBatch && buildingRenderMode == SettingsManager::BuildingRenderMode::Opaque) {
+    passTimer->begin(Pass::Buildings);
+    renderer.render(*buildingBatch);
+    passTimer->end();
+  }
+  // else in the transparent section
+
+  if (buildingOutlineBatch && renderBuildingOutlines) {
+    passTimer->begin(Pass::Outlines);
+    // Black outlines for opaque buildings
+    // White for transparent
+    if (buildingRenderMode == SettingsManager::BuildingRenderMode::Opaque)
+      renderer.renderOutlines(*buildingOutlineBatch, glm::vec3{0.0f, 0.0f, 0.0f});
+    else
+      renderer.renderOutlines(*buildingOutlineBatch, glm::vec3{1.0f, 1.0f, 1.0f});
+    passTimer->end();
+  }
+
+  if (wiredLinkBatch) {
+    passTimer->begin(Pass::Links);
+    renderer.renderWiredLinks(*wiredLinkBatch, *nodePositions);
+    passTimer->end();
+  }
+
+  // Keep this next to `startTransparent()`
+  // has it's own transparency implementation
+  if (renderGrid) {
+    passTimer->begin(Pass::Grid);
+    renderer.render(*coordinateGrid);
+    passTimer->end();
+  }
+
+  // Includes transparent buildings,
+  // since passes cannot overlap
+  passTimer->begin(Pass::Transparent);
+  // Keep this after all opaque items
+  renderer.startTransparent();
+
+  // Other condition in opaque section
+  if (buildingBatch && buildingRenderMode == SettingsManager::BuildingRenderMode::Transparent)
+    renderer.render(*buildingBatch);
+
+  transmissionSpheres->clear();
+  for (const auto &[_, node] : nodes) {
+    const auto &nodeModel = node.getModel();
+    renderer.renderTransparent(nodeModel);
+
+    const auto &transmit = node.getTransmitInfo();
+    if (transmit.isTransmitting && transmit.startTime <= simulationTime &&
+        transmit.startTime + transmit.duration >= simulationTime) {
+      const auto delta = static_cast<double>(simulationTime - transmit.startTime) /
+                         static_cast<double>(transmit.duration) * transmit.targetSize;
+      transmissionSpheres->add(nodeModel.getPosition(), static_cast<float>(delta), transmit.color);
+    }
+  }
+  renderer.render(*transmissionSpheres);
+
+  for (auto &[key, decoration] : decorations) {
+    renderer.renderTransparent(decoration.getModel());
+  }
+  renderer.endTransparent();
+  passTimer->end();
+
+  passTimer->endFrame();
+}
+
+} // namespace netsimulyzer
@@ -0,0 +1,260 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+
+#include "../group/area/Area.h"
+#include "../group/building/Building.h"
+#include "../group/decoration/Decoration.h"
+#include "../group/link/WiredLink.h"
+#include "../group/node/Node.h"
+#include "../group/node/NodePositionBuffer.h"
+#include "../group/node/TrailPool.h"
+#include "../render/Light.h"
+#include "../render/camera/Camera.h"
+#include "../render/helper/CoordinateGrid.h"
+#include "../render/helper/Floor.h"
+#include "../render/helper/SkyBox.h"
+#include "../render/helper/StaticBatch.h"
+#include "../render/helper/TransmissionSpheres.h"
+#include "../render/model/Model.h"
+#include "../render/model/ModelCache.h"
+#include "../render/profiling/PassTimer.h"
+#include "../render/renderer/Renderer.h"
+#include "../render/resource/ResourceIndex.h"
+#include "../render/texture/TextureCache.h"
+#include "../settings/SettingsManager.h"
+#include "../util/undo-events.h"
+#include <QOpenGLFunctions_3_3_Core>
+#include <QString>
+#include <deque>
+#include <memory>
+#include <model.h>
+#include <unordered_map>
+#include <vector>
+
+namespace netsimulyzer {
+
+/**
+ * Everything displayed in the 3D view, and the events which change it.
+ *
+ * Does not own an OpenGL context, so anything which touches
+ * the GPU must be called with the owner's context current
+ * (i.e. `SceneWidget` or `HeadlessRenderer`)
+ */
+class Scene : protected QOpenGLFunctions_3_3_Core {
+  SettingsManager settings;
+  ResourceIndex resources;
+  TextureCache textures{resources};
+  ModelCache models{textures, resources};
+  Renderer renderer{models, textures};
+
+  bool renderSkybox = settings.get<bool>(SettingsManager::Key::RenderSkybox).value();
+  bool renderGrid = settings.get<bool>(SettingsManager::Key::RenderGrid).value();
+  bool renderBuildingOutlines = settings.get<bool>(SettingsManager::Key::RenderBuildingOutlines).value();
+  bool renderMotionTrails = settings.get<bool>(SettingsManager::Key::RenderMotionTrails).value();
+
+  DirectionalLight mainLight;
+  std::unique_ptr<SkyBox> skyBox;
+  std::unique_ptr<Floor> floor;
+  std::unique_ptr<CoordinateGrid> coordinateGrid;
+  SettingsManager::BuildingRenderMode buildingRenderMode =
+      settings.get<SettingsManager::BuildingRenderMode>(SettingsManager::Key::RenderBuildingMode).value();
+  std::unique_ptr<Model> transmissionSphere;
+  std::unique_ptr<TransmissionSpheres> transmissionSpheres;
+
+  parser::GlobalConfiguration config;
+  parser::nanoseconds simulationTime = 0LL;
+
+  std::vector<Area> areas;
+  std::vector<Building> buildings;
+  std::unordered_map<unsigned int, Node> nodes;
+  std::unordered_map<unsigned int, Decoration> decorations;
+  std::vector<WiredLink> wiredLinks;
+
+  /**
+   * Merged geometry for all of the `areas`
+   */
+  std::unique_ptr<StaticBatch> areaBatch;
+
+  /**
+   * Merged walls & floors for all of the visible `buildings`
+   */
+  std::unique_ptr<StaticBatch> buildingBatch;
+
+  /**
+   * Merged outlines for all of the visible `buildings`
+   */
+  std::unique_ptr<StaticBatch> buildingOutlineBatch;
+
+  /**
+   * Storage for the motion trails of every Node
+   */
+  std::unique_ptr<TrailPool> trailPool;
+
+  /**
+   * The trails to draw this frame.
+   * Kept as a member to reuse the allocations
+   */
+  TrailPool::DrawList trailDrawList;
+
+  /**
+   * Center of every Node, for anything which follows Nodes
+   */
+  std::unique_ptr<NodePositionBuffer> nodePositions;
+
+  /**
+   * Merged lines for all of the `wiredLinks`
+   */
+  std::unique_ptr<StaticBatch> wiredLinkBatch;
+
+  /**
+   * GPU time spent on each section of `render()`
+   */
+  std::unique_ptr<PassTimer> passTimer;
+
+  std::deque<parser::SceneEvent> events;
+  std::deque<undo::SceneUndoEvent> undoEvents;
+
+  /**
+   * Regenerate the batches for the areas & buildings.
+   * Should be called whenever one of those is added/removed,
+   * or a building's visibility or color changes.
+   *
+   * Requires a current OpenGL context
+   */
+  void rebuildStaticGeometry();
+
+public:
+  /**
+   * Load the OpenGL functions, shaders, and built in models/textures.
+   * Must be called once, before anything else which touches the GPU.
+   *
+   * Requires a current OpenGL context
+   */
+  void initialize();
+
+  /**
+   * Requires a current OpenGL context
+   */
+  void setConfiguration(parser::GlobalConfiguration configuration);
+
+  [[nodiscard]] const parser::GlobalConfiguration &getConfiguration() const;
+
+  /**
+   * Remove every item & event from the scene, and rewind to the beginning.
+   *
+   * Requires a current OpenGL context, if `initialize()` was called
+   */
+  void reset();
+
+  /**
+   * Requires a current OpenGL context
+   */
+  void add(const std::vector<parser::Area> &areaModels, const std::vector<parser::Building> &buildingModels,
+           const std::vector<parser::Decoration> &decorationModels, const std::vector<parser::WiredLink> &links,
+           const std::vector<parser::Node> &nodeModels);
+
+  void enqueueEvents(const std::vector<parser::SceneEvent> &e);
+
+  /**
+   * Apply the events up to the current time
+   */
+  void handleEvents();
+
+  /**
+   * Undo the events after the current time
+   */
+  void handleUndoEvents();
+
+  /**
+   * Move the scene's clock.
+   * Does not apply any events, see `handleEvents()` & `handleUndoEvents()`
+   *
+   * @param value
+   * The new simulation time
+   */
+  void setTime(parser::nanoseconds value);
+
+  [[nodiscard]] parser::nanoseconds getTime() const;
+
+  [[nodiscard]] const std::unordered_map<unsigned int, Node> &getNodes() const;
+
+  /**
+   * Update the projection matrix
+   *
+   * @param fieldOfView
+   * The vertical field of view, in degrees
+   *
+   * @param width
+   * The width of the target, in pixels
+   *
+   * @param height
+   * The height of the target, in pixels
+   */
+  void setPerspective(float fieldOfView, int width, int height);
+
+  void setResourcePath(const QString &value);
+
+  void setSkyboxRenderState(bool enable);
+  void setBuildingRenderMode(SettingsManager::BuildingRenderMode mode);
+  void setBuildingRenderOutlines(bool enable);
+  void setRenderGrid(bool enable);
+
+  /**
+   * Requires a current OpenGL context
+   */
+  void changeGridStepSize(int stepSize);
+
+  void setRenderTrails(bool enable);
+
+  /**
+   * Gets the GPU timings for each pass of `render()`.
+   * Timing is disabled by default, see `PassTimer::setEnabled()`.
+   * `initialize()` must be called first
+   */
+  [[nodiscard]] PassTimer &getPassTimer();
+
+  /**
+   * Draw the scene from the perspective of `camera`
+   * into the currently bound framebuffer
+   *
+   * Requires a current OpenGL context
+   *
+   * @param camera
+   * The camera to view the scene from
+   */
+  void render(const Camera &camera);
+};
+
+} // namespace netsimulyzer
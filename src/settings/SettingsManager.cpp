@@ -38,6 +38,21 @@ SettingsManager::ChartDropdownSortOrder SettingsManager::ChartDropdownSortOrderF
   }
 }
 
+SettingsManager::ChartDecimation SettingsManager::ChartDecimationFromInt(int value) {
+  using Decimation = SettingsManager::ChartDecimation;
+
+  switch (value) {
+  case static_cast<int>(Decimation::MinMax):
+    return Decimation::MinMax;
+  case static_cast<int>(Decimation::LargestTriangleThreeBuckets):
+    return Decimation::LargestTriangleThreeBuckets;
+  default:
+    QMessageBox::critical(nullptr, "Invalid value provided for 'Chart Decimation'!",
+                          "An unrecognised value for 'Chart Decimation':" + QString{value} + " was provided");
+    std::abort();
+  }
+}
+
 SettingsManager::TimeUnit SettingsManager::TimeUnitFromInt(int value) {
   switch (value) {
   case static_cast<int>(SettingsManager::TimeUnit::Nanoseconds):
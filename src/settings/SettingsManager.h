@@ -45,16 +45,22 @@ public:
     PlaybackTimeStepUnit,
     RenderBuildingMode,
     RenderBuildingOutlines,
+    RenderFrameRateLimit,
     RenderGrid,
     RenderGridStep,
     RenderMotionTrails,
     RenderMotionTrailLength,
+    RenderPassTimings,
     RenderSkybox,
     ChartDropdownSortOrder,
+    ChartDecimation,
+    ChartOpenGLView,
+    ChartStatisticsWindow,
   };
 
   enum class BuildingRenderMode : int { Transparent, Opaque };
   enum class ChartDropdownSortOrder : int { Alphabetical, Type, Id, None };
+  enum class ChartDecimation : int { MinMax, LargestTriangleThreeBuckets };
   enum class TimeUnit : int { Milliseconds, Microseconds, Nanoseconds };
 
   /**
@@ -81,6 +87,18 @@ public:
    */
   static ChartDropdownSortOrder ChartDropdownSortOrderFromInt(int value);
 
+  /**
+   * Convert an int to a `ChartDecimation` enum value.
+   * Necessary since Qt will only allow sending registered types with signals/slots.
+   *
+   * @param value
+   * An integer that corresponds to an enum value
+   *
+   * @return
+   * The enum value corresponding to `value`
+   */
+  static ChartDecimation ChartDecimationFromInt(int value);
+
   /**
    * Convert an int to a `TimeUnit` enum value.
    * Necessary since Qt will only allow sending registered types with signals/slots.
@@ -138,12 +156,17 @@ private:
       {Key::NumberSamples, {"renderer/numberSamples", 2}},
       {Key::RenderBuildingMode, {"renderer/buildingRenderMode", "transparent"}},
       {Key::RenderBuildingOutlines, {"renderer/showBuildingOutlines", true}},
+      {Key::RenderFrameRateLimit, {"renderer/frameRateLimit", 60}},
       {Key::RenderGrid, {"renderer/showGrid", true}},
       {Key::RenderGridStep, {"renderer/gridStepSize", 1}},
       {Key::RenderSkybox, {"renderer/enableSkybox", true}},
       {Key::RenderMotionTrails, {"renderer/showMotionTrails", false}},
       {Key::RenderMotionTrailLength, {"renderer/motionTrailLength", 100}},
-      {Key::ChartDropdownSortOrder, {"chart/dropdownSortOrder", "type"}}};
+      {Key::RenderPassTimings, {"renderer/showPassTimings", false}},
+      {Key::ChartDropdownSortOrder, {"chart/dropdownSortOrder", "type"}},
+      {Key::ChartDecimation, {"chart/decimation", "minmax"}},
+      {Key::ChartOpenGLView, {"chart/openGLView", false}},
+      {Key::ChartStatisticsWindow, {"chart/statisticsWindow", 1000}}};
 
   /**
    * Get the Qt key for the corresponding enum value.
@@ -354,6 +377,20 @@ SettingsManager::getDefault(SettingsManager::Key key) const {
   return SettingsManager::ChartDropdownSortOrder::Type;
 }
 
+// Specialization for ChartDecimation enum
+// so each widget does not need to convert to/from the settings representation
+template <>
+[[nodiscard]] inline SettingsManager::ChartDecimation SettingsManager::getDefault(SettingsManager::Key key) const {
+  const auto &settingKey = getQtKey(key);
+  if (!settingKey.defaultValue.isValid()) {
+    std::cerr << "Requested default for key: " << settingKey.key.toStdString() << " which has no default\n";
+    std::abort();
+  }
+
+  // TODO: Use the map value
+  return SettingsManager::ChartDecimation::MinMax;
+}
+
 // Specialization for TimeUnit enum
 // so each widget does not need to convert to/from the settings representation
 template <>
@@ -454,6 +491,33 @@ SettingsManager::get(Key key, RetrieveMode mode) const {
   return {};
 }
 
+template <>
+[[nodiscard]] inline std::optional<SettingsManager::ChartDecimation> SettingsManager::get(Key key,
+                                                                                          RetrieveMode mode) const {
+  const auto &settingKey = getQtKey(key);
+  const auto qtSetting = qtSettings.value(settingKey.key);
+
+  QString stringMode;
+
+  if (qtSetting.isValid() && qtSetting.template canConvert<QString>())
+    stringMode = qtSetting.toString();
+  else if (mode == RetrieveMode::AllowDefault)
+    stringMode = settingKey.defaultValue.toString();
+
+  if (stringMode == "minmax")
+    return {SettingsManager::ChartDecimation::MinMax};
+  else if (stringMode == "lttb")
+    return {SettingsManager::ChartDecimation::LargestTriangleThreeBuckets};
+  else
+    std::cerr << "Unrecognised 'ChartDecimation' provided '" << stringMode.toStdString() << "' value ignored!\n";
+
+  // Final catch if the provided string value is invalid
+  if (mode == RetrieveMode::AllowDefault)
+    return getDefault<ChartDecimation>(Key::ChartDecimation);
+
+  return {};
+}
+
 template <>
 inline void SettingsManager::set(SettingsManager::Key key, const SettingsManager::BuildingRenderMode &value) {
   const auto &settingKey = getQtKey(key);
@@ -492,6 +556,22 @@ inline void SettingsManager::set(SettingsManager::Key key, const SettingsManager
   }
 }
 
+template <>
+inline void SettingsManager::set(SettingsManager::Key key, const SettingsManager::ChartDecimation &value) {
+  const auto &settingKey = getQtKey(key);
+
+  switch (value) {
+  case SettingsManager::ChartDecimation::MinMax:
+    qtSettings.setValue(settingKey.key, "minmax");
+    break;
+  case SettingsManager::ChartDecimation::LargestTriangleThreeBuckets:
+    qtSettings.setValue(settingKey.key, "lttb");
+    break;
+  default:
+    std::cerr << "Unrecognised 'ChartDecimation': " << static_cast<int>(value) << " value not saved!\n";
+  }
+}
+
 template <>
 inline void SettingsManager::set(SettingsManager::Key key, const SettingsManager::TimeUnit &value) {
   const auto &settingKey = getQtKey(key);
@@ -33,9 +33,8 @@
 
 #pragma once
 
-#include <QPointF>
-#include <QVector>
 #include <array>
+#include <cstddef>
 #include <glm/vec3.hpp>
 #include <model.h>
 #include <variant>
@@ -146,25 +145,6 @@ struct XYSeriesAddValue {
   parser::XYSeriesAddValue event;
 };
 
-struct XYSeriesAddValues {
-  /**
-   * The event which generated this undo event
-   */
-  parser::XYSeriesAddValues event;
-};
-
-struct XYSeriesClear {
-  /**
-   * The event which generated this undo event
-   */
-  parser::XYSeriesClear event;
-
-  /**
-   * The list of points on the chart before it was cleared
-   */
-  QVector<QPointF> points;
-};
-
 /**
  * An event which undoes a `parser::CategorySeriesAddValue`
  */
@@ -177,15 +157,10 @@ struct CategorySeriesAddValue {
 
 struct StreamAppendEvent {
   /**
-   * Number of characters to erase from the unified log
-   * Includes the size of the prompt for every newline
-   */
-  int unifiedLogEraseCount{0};
-
-  /**
-   * Original ID of the last writer to the unified log
+   * The number of lines in the log before the event.
+   * Every line from here on was written by the event, or a later one
    */
-  unsigned int lastUnifiedWriter{0u};
+  std::size_t lineCount{0u};
 
   /**
    * The event which generated this undo event
@@ -197,7 +172,7 @@ using SceneUndoEvent =
     std::variant<MoveEvent, TransmitEvent, TransmitEndEvent, DecorationMoveEvent, NodeOrientationChangeEvent,
                  NodeColorChangeEvent, DecorationOrientationChangeEvent, XYSeriesAddValue, StreamAppendEvent>;
 
-using ChartUndoEvent = std::variant<XYSeriesAddValue, XYSeriesAddValues, XYSeriesClear, CategorySeriesAddValue>;
+using ChartUndoEvent = std::variant<CategorySeriesAddValue>;
 
 using LogUndoEvent = std::variant<StreamAppendEvent>;
 
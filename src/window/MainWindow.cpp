@@ -35,6 +35,7 @@
 #include "LoadWorker.h"
 #include "about/AboutDialog.h"
 #include "src/conversion.h"
+#include "src/util/common-times.h"
 #include "src/window/util/file-operations.h"
 #include <QAction>
 #include <QDockWidget>
@@ -46,6 +47,7 @@
 #include <parser/file-parser.h>
 #include <parser/model.h>
 #include <project.h>
+#include <trace.h>
 
 namespace netsimulyzer {
 
@@ -170,6 +172,18 @@ MainWindow::MainWindow() : QMainWindow() {
     charts.setSortOrder(SettingsManager::ChartDropdownSortOrderFromInt(value));
   });
 
+  QObject::connect(&settingsDialog, &SettingsDialog::chartDecimationChanged, [this](int value) {
+    charts.setDecimation(SettingsManager::ChartDecimationFromInt(value));
+  });
+
+  QObject::connect(&settingsDialog, &SettingsDialog::chartOpenGLViewChanged, [this](bool enable) {
+    charts.setOpenGLView(enable);
+  });
+
+  QObject::connect(&settingsDialog, &SettingsDialog::chartStatisticsWindowChanged, [this](int milliseconds) {
+    charts.setStatisticsWindow(static_cast<parser::nanoseconds>(milliseconds) * MILLISECOND);
+  });
+
   QObject::connect(&settingsDialog, &SettingsDialog::renderSkyboxChanged, [this](bool enable) {
     scene.setSkyboxRenderState(enable);
   });
@@ -184,6 +198,9 @@ MainWindow::MainWindow() : QMainWindow() {
   QObject::connect(&settingsDialog, &SettingsDialog::gridStepSizeChanged, &scene, &SceneWidget::changeGridStepSize);
 
   QObject::connect(&settingsDialog, &SettingsDialog::renderTrailsChanged, &scene, &SceneWidget::setRenderTrails);
+  QObject::connect(&settingsDialog, &SettingsDialog::frameRateLimitChanged, &scene, &SceneWidget::setFrameRateLimit);
+  QObject::connect(&settingsDialog, &SettingsDialog::renderPassTimingsChanged, &scene,
+                   &SceneWidget::setRenderPassTimings);
 
   QObject::connect(&settingsDialog, &SettingsDialog::playKeyChanged, [this](int key) {
     ui.actionPlayPause->setShortcut(QKeySequence{key});
@@ -204,6 +221,27 @@ MainWindow::MainWindow() : QMainWindow() {
   });
 
   QObject::connect(ui.actionRemovCharts, &QAction::triggered, &charts, &ChartManager::clearWidgets);
+
+  // May have been started from the command line
+  ui.actionRecordTrace->setChecked(trace::isEnabled());
+  QObject::connect(ui.actionRecordTrace, &QAction::toggled, [this](bool checked) {
+    if (checked) {
+      trace::setEnabled(true);
+      ui.statusbar->showMessage("Recording trace", 10000);
+      return;
+    }
+
+    // Don't record the dialog
+    trace::setEnabled(false);
+    const auto fileName = QFileDialog::getSaveFileName(this, "Save Trace", "", "Chrome Trace (*.json)");
+    if (fileName.isEmpty())
+      return;
+
+    if (trace::writeChromeTrace(fileName.toStdString()))
+      ui.statusbar->showMessage("Saved trace: " + fileName, 10000);
+    else
+      ui.statusbar->showMessage("Failed to save trace: " + fileName, 10000);
+  });
 }
 
 MainWindow::~MainWindow() {
@@ -33,6 +33,7 @@
 
 #include "ChartManager.h"
 #include "ChartWidget.h"
+#include "SeriesPickerModel.h"
 #include <QDockWidget>
 #include <QGraphicsLayout>
 #include <QMainWindow>
@@ -46,14 +47,18 @@
 #include <cstdlib>
 #include <iostream>
 #include <stdexcept>
+#include <trace.h>
 #include <utility>
 
 namespace {
 
-void updateRange(QtCharts::QAbstractAxis *axis, qreal value) {
-  // Amount to scale past the min/max
-  // so we don't cut off the actual point
-  const auto additionalScale = 0.05;
+// Amount to scale past the min/max
+// so we don't cut off the actual point
+const auto additionalScale = 0.05;
+
+void updateRange(QtCharts::QAbstractAxis *axis, const netsimulyzer::ChartManager::Bounds &bounds) {
+  if (!axis || bounds.empty())
+    return;
 
   qreal min;
   qreal max;
@@ -68,19 +73,113 @@ void updateRange(QtCharts::QAbstractAxis *axis, qreal value) {
     return;
   }
 
-  if (value > max)
-    axis->setMax(value + value * additionalScale);
-  else if (value < min)
-    axis->setMin(value - value * additionalScale);
+  const auto newMax = bounds.max > max ? bounds.max + bounds.max * additionalScale : max;
+  const auto newMin = bounds.min < min ? bounds.min - bounds.min * additionalScale : min;
+
+  // Touch the axis at most once, since every change redraws the chart
+  if (newMin != min || newMax != max)
+    axis->setRange(newMin, newMax);
+}
+
+/**
+ * Extend the range an axis will be created with,
+ * as well as the axis itself if it exists
+ *
+ * @param range
+ * The range kept while the axis does not exist
+ *
+ * @param axis
+ * The axis, if the series is displayed. May be null
+ *
+ * @param bounds
+ * The extent of the added values
+ */
+void updateRange(netsimulyzer::ChartManager::Bounds &range, QtCharts::QAbstractAxis *axis,
+                 const netsimulyzer::ChartManager::Bounds &bounds) {
+  if (bounds.empty())
+    return;
+
+  if (bounds.max > range.max)
+    range.max = bounds.max + bounds.max * additionalScale;
+  if (bounds.min < range.min)
+    range.min = bounds.min - bounds.min * additionalScale;
+
+  // Follow the displayed axis, which may be zoomed/scrolled
+  updateRange(axis, bounds);
+}
+
+QtCharts::QAbstractAxis *makeValueAxis(const parser::ValueAxis &model,
+                                       const netsimulyzer::ChartManager::Bounds &range, QObject *parent) {
+  QtCharts::QAbstractAxis *axis;
+  if (model.scale == parser::ValueAxis::Scale::Linear)
+    axis = new QtCharts::QValueAxis(parent);
+  else
+    axis = new QtCharts::QLogValueAxis(parent);
+
+  axis->setTitleText(QString::fromStdString(model.name));
+  axis->setRange(range.min, range.max);
+  return axis;
+}
+
+/**
+ * Delete a QtCharts object once control returns to the event loop
+ *
+ * @param object
+ * The object to delete. May be null
+ */
+void releaseObject(QObject *object) {
+  if (!object)
+    return;
+
+  object->setParent(nullptr);
+  object->deleteLater();
 }
 
 } // namespace
 
 namespace netsimulyzer {
 
+void ChartManager::Bounds::add(double value) {
+  min = std::min(min, value);
+  max = std::max(max, value);
+}
+
+bool ChartManager::Bounds::empty() const {
+  return min > max;
+}
+
 ChartManager::XYSeriesTie ChartManager::makeTie(const parser::XYSeries &model) {
   ChartManager::XYSeriesTie tie;
   tie.model = model;
+  tie.decimator.setMethod(decimation);
+  tie.xRange = {model.xAxis.min, model.xAxis.max};
+  tie.yRange = {model.yAxis.min, model.yAxis.max};
+
+  return tie;
+}
+
+ChartManager::SeriesCollectionTie ChartManager::makeTie(const parser::SeriesCollection &model) {
+  ChartManager::SeriesCollectionTie tie;
+  tie.model = model;
+  tie.xRange = {model.xAxis.min, model.xAxis.max};
+  tie.yRange = {model.yAxis.min, model.yAxis.max};
+
+  return tie;
+}
+
+ChartManager::CategoryValueTie ChartManager::makeTie(const parser::CategoryValueSeries &model) {
+  CategoryValueTie tie;
+  tie.model = model;
+  tie.xRange = {model.xAxis.min, model.xAxis.max};
+
+  return tie;
+}
+
+void ChartManager::materialize(XYSeriesTie &tie) {
+  if (tie.qtSeries)
+    return;
+
+  const auto &model = tie.model;
   switch (model.connection) {
   case parser::XYSeries::Connection::None: {
     auto scatterSeries = new QtCharts::QScatterSeries(this);
@@ -121,66 +220,36 @@ ChartManager::XYSeriesTie ChartManager::makeTie(const parser::XYSeries &model) {
   tie.qtSeries->setColor(QColor::fromRgb(model.color.red, model.color.green, model.color.blue));
   tie.qtSeries->setName(QString::fromStdString(model.legend));
 
-  // X Axis
-  if (tie.model.xAxis.scale == parser::ValueAxis::Scale::Linear)
-    tie.xAxis = new QtCharts::QValueAxis(this);
-  else
-    tie.xAxis = new QtCharts::QLogValueAxis(this);
-
-  tie.xAxis->setTitleText(QString::fromStdString(model.xAxis.name));
-  tie.xAxis->setRange(model.xAxis.min, model.xAxis.max);
-
-  // Y Axis
-  if (tie.model.yAxis.scale == parser::ValueAxis::Scale::Linear)
-    tie.yAxis = new QtCharts::QValueAxis(this);
-  else
-    tie.yAxis = new QtCharts::QLogValueAxis(this);
-  tie.yAxis = new QtCharts::QValueAxis(this);
-  tie.yAxis->setTitleText(QString::fromStdString(model.yAxis.name));
-  tie.yAxis->setRange(model.yAxis.min, model.yAxis.max);
-
-  return tie;
+  tie.xAxis = makeValueAxis(model.xAxis, tie.xRange, this);
+  tie.yAxis = makeValueAxis(model.yAxis, tie.yRange, this);
 }
 
-ChartManager::SeriesCollectionTie ChartManager::makeTie(const parser::SeriesCollection &model) {
-  ChartManager::SeriesCollectionTie tie;
-  tie.model = model;
+void ChartManager::materialize(SeriesCollectionTie &tie) {
+  if (!tie.xAxis)
+    tie.xAxis = makeValueAxis(tie.model.xAxis, tie.xRange, this);
+  if (!tie.yAxis)
+    tie.yAxis = makeValueAxis(tie.model.yAxis, tie.yRange, this);
 
-  // X Axis
-  if (tie.model.xAxis.scale == parser::ValueAxis::Scale::Linear)
-    tie.xAxis = new QtCharts::QValueAxis(this);
-  else
-    tie.xAxis = new QtCharts::QLogValueAxis(this);
-  tie.xAxis->setTitleText(QString::fromStdString(model.xAxis.name));
-  tie.xAxis->setRange(model.xAxis.min, model.xAxis.max);
-
-  // Y Axis
-  if (tie.model.yAxis.scale == parser::ValueAxis::Scale::Linear)
-    tie.yAxis = new QtCharts::QValueAxis(this);
-  else
-    tie.yAxis = new QtCharts::QLogValueAxis(this);
-  tie.yAxis = new QtCharts::QValueAxis(this);
-  tie.yAxis->setTitleText(QString::fromStdString(model.yAxis.name));
-  tie.yAxis->setRange(model.yAxis.min, model.yAxis.max);
-
-  return tie;
+  for (const auto seriesId : tie.model.series) {
+    auto &member = getSeries(seriesId);
+    if (std::holds_alternative<XYSeriesTie>(member))
+      materialize(std::get<XYSeriesTie>(member));
+  }
 }
 
-ChartManager::CategoryValueTie ChartManager::makeTie(const parser::CategoryValueSeries &model) {
-  CategoryValueTie tie;
-  tie.model = model;
+void ChartManager::materialize(CategoryValueTie &tie) {
+  if (tie.qtSeries)
+    return;
+
+  const auto &model = tie.model;
   tie.qtSeries = new QtCharts::QLineSeries(this);
 
   tie.qtSeries->setColor(QColor::fromRgb(model.color.red, model.color.green, model.color.blue));
   tie.qtSeries->setName(QString::fromStdString(model.legend));
+  tie.qtSeries->replace(tie.points);
 
   // X Axis (values)
-  if (tie.model.xAxis.scale == parser::ValueAxis::Scale::Linear)
-    tie.xAxis = new QtCharts::QValueAxis(this);
-  else
-    tie.xAxis = new QtCharts::QLogValueAxis(this);
-  tie.xAxis->setTitleText(QString::fromStdString(model.xAxis.name));
-  tie.xAxis->setRange(model.xAxis.min, model.xAxis.max);
+  tie.xAxis = makeValueAxis(model.xAxis, tie.xRange, this);
 
   // Y axis (categories)
   auto yAxis = new QtCharts::QCategoryAxis(this);
@@ -202,16 +271,62 @@ ChartManager::CategoryValueTie ChartManager::makeTie(const parser::CategoryValue
   yAxis->setLabelsPosition(QtCharts::QCategoryAxis::AxisLabelsPositionOnValue);
 
   tie.yAxis = yAxis;
-  return tie;
 }
 
-ChartManager::ChartManager(QWidget *parent) : QObject(parent) {
+void ChartManager::release(XYSeriesTie &tie) {
+  tie.decimator.clearView();
+  viewedSeries.erase(tie.model.id);
+
+  releaseObject(tie.qtSeries);
+  releaseObject(tie.xAxis);
+  releaseObject(tie.yAxis);
+  tie.qtSeries = nullptr;
+  tie.xAxis = nullptr;
+  tie.yAxis = nullptr;
+}
+
+void ChartManager::release(SeriesCollectionTie &tie) {
+  releaseObject(tie.xAxis);
+  releaseObject(tie.yAxis);
+  tie.xAxis = nullptr;
+  tie.yAxis = nullptr;
+
+  for (const auto seriesId : tie.model.series) {
+    auto &member = getSeries(seriesId);
+    if (std::holds_alternative<XYSeriesTie>(member))
+      release(std::get<XYSeriesTie>(member));
+  }
+}
+
+void ChartManager::release(CategoryValueTie &tie) {
+  releaseObject(tie.qtSeries);
+  releaseObject(tie.xAxis);
+  releaseObject(tie.yAxis);
+  tie.qtSeries = nullptr;
+  tie.xAxis = nullptr;
+  tie.yAxis = nullptr;
+}
+
+ChartManager::ChartManager(QWidget *parent)
+    : QObject(parent), seriesModel(new SeriesPickerModel{this, sortOrder}) {
 }
 
 void ChartManager::reset() {
-  dropdownElements.clear();
   events.clear();
   undoEvents.clear();
+  viewedSeries.clear();
+  collectionMembership.clear();
+  autoUpdates = {};
+  pendingCategorySeries.clear();
+  xySeriesChanges.clear();
+  xySeriesChangesApplied = 0u;
+  lastXYSeriesTime = 0LL;
+  pendingSeeks.clear();
+  currentTime = 0LL;
+  statisticsSeries.clear();
+  derivedSeries.clear();
+  derivedIds.clear();
+  nextDerivedId = PlaceholderId + 1u;
 
   // Clear the child widgets first
   // since they may be holding on to series
@@ -219,44 +334,28 @@ void ChartManager::reset() {
     chartWidget->reset();
   }
 
+  // Nothing should be displayed anymore,
+  // but make sure no Qt objects outlive their series
   for (auto &iterator : series) {
-    auto &value = iterator.second;
-    if (std::holds_alternative<XYSeriesTie>(value)) {
-      auto qtSeries = std::get<XYSeriesTie>(value).qtSeries;
-      qtSeries->setParent(nullptr);
-      qtSeries->deleteLater();
-    } else if (std::holds_alternative<CategoryValueTie>(value)) {
-      auto qtSeries = std::get<CategoryValueTie>(value).qtSeries;
-      qtSeries->setParent(nullptr);
-      qtSeries->deleteLater();
-    }
-    // No need to handle SeriesCollection since it has no pointers
+    std::visit(
+        [this](auto &tie) {
+          release(tie);
+        },
+        iterator.second);
   }
 
   series.clear();
+  seriesModel->setSeries({});
 }
 
-void ChartManager::setChildrenSeries(const std::vector<DropdownValue> &values) {
-  for (auto chartWidget : chartWidgets) {
-    chartWidget->setSeries(values);
-  }
-}
+const std::vector<unsigned int> &ChartManager::inCollections(unsigned int id) const {
+  static const std::vector<unsigned int> none;
 
-std::vector<unsigned int> ChartManager::inCollections(unsigned int id) {
-  std::vector<unsigned int> collections;
+  const auto iterator = collectionMembership.find(id);
+  if (iterator == collectionMembership.end())
+    return none;
 
-  for (const auto &[key, value] : series) {
-    // We're only concerned about collections
-    // so we can skip everything else
-    if (!std::holds_alternative<SeriesCollectionTie>(value))
-      continue;
-
-    const auto &tieModel = std::get<SeriesCollectionTie>(value).model;
-    if (std::find(tieModel.series.begin(), tieModel.series.end(), id) != tieModel.series.end())
-      collections.emplace_back(tieModel.id);
-  }
-
-  return collections;
+  return iterator->second;
 }
 
 void ChartManager::clearSeries(const ChartWidget *except, unsigned int id) {
@@ -270,6 +369,7 @@ void ChartManager::clearSeries(const ChartWidget *except, unsigned int id) {
 }
 
 void ChartManager::timeAdvanced(parser::nanoseconds time) {
+  NETSIMULYZER_TRACE_SCOPE("ChartManager::timeAdvanced");
   auto handleEvent = [time, this](auto &&e) {
     // Strip off qualifiers, etc
     // so T holds just the type
@@ -279,63 +379,12 @@ void ChartManager::timeAdvanced(parser::nanoseconds time) {
     if (e.time > time)
       return false;
 
-    if constexpr (std::is_same_v<T, parser::XYSeriesAddValue>) {
-      const auto &s = std::get<XYSeriesTie>(series[e.seriesId]);
-      if (s.model.xAxis.boundMode == parser::ValueAxis::BoundMode::HighestValue) {
-        updateRange(s.xAxis, e.point.x);
-      }
-      if (s.model.yAxis.boundMode == parser::ValueAxis::BoundMode::HighestValue) {
-        updateRange(s.yAxis, e.point.y);
-      }
-      updateCollectionRanges(e.seriesId, e.point.x, e.point.y);
-      s.qtSeries->append(e.point.x, e.point.y);
-      undoEvents.emplace_back(undo::XYSeriesAddValue{e});
-      events.pop_front();
-      return true;
-    }
-
-    if constexpr (std::is_same_v<T, parser::XYSeriesAddValues>) {
-      const auto &s = std::get<XYSeriesTie>(series[e.seriesId]);
-
-      for (const auto &point : e.points) {
-        if (s.model.xAxis.boundMode == parser::ValueAxis::BoundMode::HighestValue) {
-          updateRange(s.xAxis, point.x);
-        }
-        if (s.model.yAxis.boundMode == parser::ValueAxis::BoundMode::HighestValue) {
-          updateRange(s.yAxis, point.y);
-        }
-
-        updateCollectionRanges(e.seriesId, point.x, point.y);
-        s.qtSeries->append(point.x, point.y);
-      }
-
-      undoEvents.emplace_back(undo::XYSeriesAddValues{e});
-      events.pop_front();
-      return true;
-    }
-
-    if constexpr (std::is_same_v<T, parser::XYSeriesClear>) {
-      const auto &s = std::get<XYSeriesTie>(series[e.seriesId]);
-      auto points = s.qtSeries->pointsVector();
-      s.qtSeries->clear();
-
-      undoEvents.emplace_back(undo::XYSeriesClear{e, std::move(points)});
-      events.pop_front();
-      return true;
-    }
-
     if constexpr (std::is_same_v<T, parser::CategorySeriesAddValue>) {
       // Not const since we change the lastUpdatedTime
       auto &s = std::get<CategoryValueTie>(series[e.seriesId]);
-      if (s.model.xAxis.boundMode == parser::ValueAxis::BoundMode::HighestValue) {
-        updateRange(s.xAxis, e.value);
-      }
-
-      // Y axis on category charts is a fixed size
-
       s.lastUpdatedTime = time;
-      s.qtSeries->append(e.value, e.category);
-      updateCollectionRanges(e.seriesId, e.value, e.category);
+      appendCategoryValue(s, e.value, e.category);
+      scheduleAutoUpdate(s);
       undoEvents.emplace_back(undo::CategorySeriesAddValue{e});
       events.pop_front();
       return true;
@@ -351,20 +400,20 @@ void ChartManager::timeAdvanced(parser::nanoseconds time) {
 
   // Add "Fake Events" to keep the category value series moving
   // TODO: Maybe move to parse time
-  for (auto &[key, s] : series) {
-    // Only CategoryValueSeries may have auto-appended values
-    if (!std::holds_alternative<CategoryValueTie>(s))
-      continue;
+  std::vector<unsigned int> updated;
+  while (!autoUpdates.empty() && autoUpdates.top().due <= time) {
+    const auto next = autoUpdates.top();
+    autoUpdates.pop();
 
-    auto &value = std::get<CategoryValueTie>(s);
-    if (!value.model.autoUpdate)
-      continue;
+    auto &value = std::get<CategoryValueTie>(series[next.seriesId]);
 
-    const auto &points = value.qtSeries->pointsVector();
-    if (points.empty())
+    // The series was updated again after this entry was scheduled,
+    // a later entry covers it
+    if (value.lastUpdatedTime + value.model.autoUpdateInterval != next.due)
       continue;
 
-    if (time - value.lastUpdatedTime < value.model.autoUpdateInterval)
+    const auto &points = value.points;
+    if (points.empty())
       continue;
 
     const auto lastValue = points.last();
@@ -372,20 +421,23 @@ void ChartManager::timeAdvanced(parser::nanoseconds time) {
     fakeEvent.time = time;
     fakeEvent.value = lastValue.x() + value.model.autoUpdateIncrement;
     fakeEvent.category = static_cast<unsigned int>(lastValue.y());
-    fakeEvent.seriesId = key;
-
-    if (value.model.xAxis.boundMode == parser::ValueAxis::BoundMode::HighestValue) {
-      updateRange(value.xAxis, fakeEvent.value);
-    }
-
-    // Y axis on category charts is a fixed size
+    fakeEvent.seriesId = next.seriesId;
 
-    value.qtSeries->append(fakeEvent.value, fakeEvent.category);
-    updateCollectionRanges(fakeEvent.seriesId, fakeEvent.value, fakeEvent.category);
+    appendCategoryValue(value, fakeEvent.value, fakeEvent.category);
     undoEvents.emplace_back(undo::CategorySeriesAddValue{fakeEvent});
 
     value.lastUpdatedTime = time;
+    updated.emplace_back(next.seriesId);
   }
+
+  // Schedule after the loop, so a series with a short
+  // interval is not updated more than once per step
+  for (const auto id : updated)
+    scheduleAutoUpdate(std::get<CategoryValueTie>(series[id]));
+
+  const auto categoryChanged = flushCategorySeries();
+  if (seekXYSeries(time) || categoryChanged)
+    emit seriesChanged();
 }
 
 void ChartManager::timeRewound(parser::nanoseconds time) {
@@ -401,52 +453,169 @@ void ChartManager::timeRewound(parser::nanoseconds time) {
     if (time > e.event.time)
       return false;
 
-    if constexpr (std::is_same_v<T, undo::XYSeriesAddValue>) {
-      auto &s = std::get<XYSeriesTie>(series[e.event.seriesId]);
+    if constexpr (std::is_same_v<T, undo::CategorySeriesAddValue>) {
+      auto &s = std::get<CategoryValueTie>(series[e.event.seriesId]);
 
-      s.qtSeries->remove(s.qtSeries->count() - 1);
+      s.points.removeLast();
+      s.removedPoints++;
+      markFlush(e.event.seriesId);
 
       events.emplace_front(e.event);
       return true;
     }
 
-    if constexpr (std::is_same_v<T, undo::XYSeriesAddValues>) {
-      auto &s = std::get<XYSeriesTie>(series[e.event.seriesId]);
-      const auto count = e.event.points.size();
+    return false;
+  };
 
-      s.qtSeries->removePoints(s.qtSeries->count() - count, count);
+  while (!undoEvents.empty() && std::visit(handleUndoEvent, undoEvents.back())) {
+    undoEvents.pop_back();
+  }
 
-      events.emplace_front(e.event);
-      return true;
-    }
+  const auto categoryChanged = flushCategorySeries();
+  if (seekXYSeries(time) || categoryChanged)
+    emit seriesChanged();
+}
 
-    if constexpr (std::is_same_v<T, undo::XYSeriesClear>) {
-      auto &s = std::get<XYSeriesTie>(series[e.event.seriesId]);
-      s.qtSeries->replace(e.points);
+void ChartManager::scheduleAutoUpdate(const CategoryValueTie &tie) {
+  if (!tie.model.autoUpdate)
+    return;
 
-      events.emplace_front(e.event);
-      return true;
-    }
+  autoUpdates.push(AutoUpdate{tie.lastUpdatedTime + tie.model.autoUpdateInterval, tie.model.id});
+}
 
-    if constexpr (std::is_same_v<T, undo::CategorySeriesAddValue>) {
-      auto &s = std::get<CategoryValueTie>(series[e.event.seriesId]);
+void ChartManager::appendCategoryValue(CategoryValueTie &tie, double value, unsigned int category) {
+  tie.points.append({value, static_cast<double>(category)});
+  tie.addedX.add(value);
+  tie.addedY.add(category);
+  markFlush(tie.model.id);
+}
 
-      s.qtSeries->remove(s.qtSeries->count() - 1);
+void ChartManager::markFlush(unsigned int id) {
+  auto &tie = std::get<CategoryValueTie>(series[id]);
+  if (tie.flushPending)
+    return;
 
-      events.emplace_front(e.event);
-      return true;
-    }
+  tie.flushPending = true;
+  pendingCategorySeries.emplace_back(id);
+}
 
+bool ChartManager::flushCategorySeries() {
+  if (pendingCategorySeries.empty())
     return false;
-  };
 
-  while (!undoEvents.empty() && std::visit(handleUndoEvent, undoEvents.back())) {
-    undoEvents.pop_back();
+  for (const auto id : pendingCategorySeries) {
+    auto &s = std::get<CategoryValueTie>(series[id]);
+    s.flushPending = false;
+
+    if (s.model.xAxis.boundMode == parser::ValueAxis::BoundMode::HighestValue)
+      updateRange(s.xRange, s.xAxis, s.addedX);
+
+    // Y axis on category charts is a fixed size
+
+    updateCollectionRanges(id, s.addedX, s.addedY);
+    s.addedX = {};
+    s.addedY = {};
+
+    // A single signal for the whole step, rather than one per point
+    if (s.qtSeries)
+      s.qtSeries->replace(s.points);
   }
+
+  pendingCategorySeries.clear();
+  return true;
+}
+
+void ChartManager::markSeek(unsigned int id) {
+  auto &tie = std::get<XYSeriesTie>(series[id]);
+  if (tie.seekPending)
+    return;
+
+  tie.seekPending = true;
+  pendingSeeks.emplace_back(id);
+}
+
+bool ChartManager::seekXYSeries(parser::nanoseconds time) {
+  NETSIMULYZER_TRACE_SCOPE("ChartManager::seekXYSeries");
+
+  // Only visit the series with events between the previous time & `time`
+  while (xySeriesChangesApplied < xySeriesChanges.size() && xySeriesChanges[xySeriesChangesApplied].time <= time) {
+    markSeek(xySeriesChanges[xySeriesChangesApplied].seriesId);
+    xySeriesChangesApplied++;
+  }
+
+  while (xySeriesChangesApplied > 0u && xySeriesChanges[xySeriesChangesApplied - 1u].time > time) {
+    xySeriesChangesApplied--;
+    markSeek(xySeriesChanges[xySeriesChangesApplied].seriesId);
+  }
+
+  // Series derived from a changed series have points at the same times.
+  // Indexed, since derived series may be derived from as well
+  for (std::size_t i = 0u; i < pendingSeeks.size(); i++) {
+    const auto derived = derivedSeries.find(pendingSeeks[i]);
+    if (derived == derivedSeries.end())
+      continue;
+
+    for (const auto id : derived->second)
+      markSeek(id);
+  }
+
+  for (const auto id : pendingSeeks) {
+    auto &s = std::get<XYSeriesTie>(series[id]);
+    s.seekPending = false;
+
+    const auto visible = s.data.visibleRange(time);
+
+    // Ranges only grow to fit the newly added points.
+    // Include points cleared within the same step, since they were still added
+    Bounds addedX;
+    Bounds addedY;
+    for (auto i = s.visible.end; i < visible.end; i++) {
+      addedX.add(s.data.xAt(i));
+      addedY.add(s.data.yAt(i));
+    }
+    s.visible = visible;
+
+    // Changing the range of a displayed axis refreshes the series as well
+    if (s.model.xAxis.boundMode == parser::ValueAxis::BoundMode::HighestValue)
+      updateRange(s.xRange, s.xAxis, addedX);
+    if (s.model.yAxis.boundMode == parser::ValueAxis::BoundMode::HighestValue)
+      updateRange(s.yRange, s.yAxis, addedY);
+    updateCollectionRanges(id, addedX, addedY);
+
+    refreshSeries(s);
+  }
+
+  const auto changed = !pendingSeeks.empty();
+  pendingSeeks.clear();
+  return changed;
+}
+
+void ChartManager::refreshSeries(XYSeriesTie &tie) {
+  if (tie.decimator.update(tie.data, tie.visible))
+    tie.qtSeries->replace(tie.decimator.points());
+}
+
+void ChartManager::refreshViewedSeries() {
+  for (const auto id : viewedSeries)
+    refreshSeries(std::get<XYSeriesTie>(series[id]));
+}
+
+void ChartManager::updateStatistics() {
+  if (statisticsSeries.empty())
+    return;
+
+  // Points leave the window as time passes,
+  // so these change even without new points
+  for (const auto id : statisticsSeries) {
+    auto &s = std::get<XYSeriesTie>(series[id]);
+    s.statistics.seek(s.data, s.visible, currentTime);
+  }
+
+  emit statisticsChanged();
 }
 
 void ChartManager::spawnWidget(QMainWindow *parent) {
-  auto newWidget = new ChartWidget{parent, *this, dropdownElements};
+  auto newWidget = new ChartWidget{parent, *this, *seriesModel};
   parent->addDockWidget(Qt::RightDockWidgetArea, newWidget);
 
   chartWidgets.emplace_back(newWidget);
@@ -466,22 +635,17 @@ void ChartManager::widgetClosed(ChartWidget *widget) {
   chartWidgets.erase(std::remove(chartWidgets.begin(), chartWidgets.end(), widget), chartWidgets.end());
 }
 
-void ChartManager::updateCollectionRanges(uint32_t seriesId, double x, double y) {
-  for (auto &iterator : series) {
-    // Only update collections
-    if (!std::holds_alternative<ChartManager::SeriesCollectionTie>(iterator.second))
-      continue;
+void ChartManager::updateCollectionRanges(uint32_t seriesId, const Bounds &x, const Bounds &y) {
+  if (x.empty() && y.empty())
+    return;
 
-    auto &collection = std::get<ChartManager::SeriesCollectionTie>(iterator.second);
+  for (const auto collectionId : inCollections(seriesId)) {
+    auto &collection = std::get<ChartManager::SeriesCollectionTie>(series[collectionId]);
 
-    // Only update the collection's ranges if it actually contains the series
-    if (std::find(collection.model.series.begin(), collection.model.series.end(), seriesId) !=
-        collection.model.series.end()) {
-      if (collection.model.xAxis.boundMode == parser::ValueAxis::BoundMode::HighestValue)
-        updateRange(collection.xAxis, x);
-      if (collection.model.yAxis.boundMode == parser::ValueAxis::BoundMode::HighestValue)
-        updateRange(collection.yAxis, y);
-    }
+    if (collection.model.xAxis.boundMode == parser::ValueAxis::BoundMode::HighestValue)
+      updateRange(collection.xRange, collection.xAxis, x);
+    if (collection.model.yAxis.boundMode == parser::ValueAxis::BoundMode::HighestValue)
+      updateRange(collection.yRange, collection.yAxis, y);
   }
 }
 
@@ -513,34 +677,97 @@ void ChartManager::seriesSelected(const ChartWidget *widget, unsigned int select
     // Clear all the collections this series belongs to as well
     // Only XYSeries may belong to collections
     const auto &tieModel = std::get<XYSeriesTie>(tie).model;
-    const auto collections = inCollections(tieModel.id);
+    const auto &collections = inCollections(tieModel.id);
     for (const auto id : collections)
       clearSeries(widget, id);
   }
 }
 
+void ChartManager::materializeSeries(unsigned int id) {
+  // Only called once no other widget holds the series
+  std::visit(
+      [this](auto &tie) {
+        materialize(tie);
+      },
+      getSeries(id));
+}
+
+void ChartManager::seriesDeselected(unsigned int deselected) {
+  if (deselected == PlaceholderId)
+    return;
+
+  const auto iterator = series.find(deselected);
+  if (iterator == series.end())
+    return;
+
+  std::visit(
+      [this](auto &tie) {
+        release(tie);
+      },
+      iterator->second);
+}
+
 void ChartManager::timeChanged(parser::nanoseconds time, parser::nanoseconds increment) {
+  currentTime = time;
   if (increment > 0LL)
     timeAdvanced(time);
   else
     timeRewound(time);
+
+  updateStatistics();
 }
 
 void ChartManager::enqueueEvents(const std::vector<parser::ChartEvent> &e) {
-  events.insert(events.end(), e.begin(), e.end());
+  for (const auto &event : e) {
+    // XY series events are loaded into their series' store,
+    // the rest are played back in order
+    if (const auto addValue = std::get_if<parser::XYSeriesAddValue>(&event)) {
+      // Events apply in order, so one may never apply before the event ahead of it
+      lastXYSeriesTime = std::max(lastXYSeriesTime, addValue->time);
+
+      auto &s = std::get<XYSeriesTie>(getSeries(addValue->seriesId));
+      s.data.append(lastXYSeriesTime, addValue->point.x, addValue->point.y);
+      xySeriesChanges.emplace_back(XYSeriesChange{lastXYSeriesTime, addValue->seriesId});
+    } else if (const auto addValues = std::get_if<parser::XYSeriesAddValues>(&event)) {
+      lastXYSeriesTime = std::max(lastXYSeriesTime, addValues->time);
+
+      auto &s = std::get<XYSeriesTie>(getSeries(addValues->seriesId));
+      for (const auto &point : addValues->points)
+        s.data.append(lastXYSeriesTime, point.x, point.y);
+      xySeriesChanges.emplace_back(XYSeriesChange{lastXYSeriesTime, addValues->seriesId});
+    } else if (const auto clear = std::get_if<parser::XYSeriesClear>(&event)) {
+      lastXYSeriesTime = std::max(lastXYSeriesTime, clear->time);
+
+      std::get<XYSeriesTie>(getSeries(clear->seriesId)).data.clear(lastXYSeriesTime);
+      xySeriesChanges.emplace_back(XYSeriesChange{lastXYSeriesTime, clear->seriesId});
+    } else
+      events.emplace_back(event);
+  }
 }
 void ChartManager::addSeries(const std::vector<parser::XYSeries> &xySeries,
                              const std::vector<parser::SeriesCollection> &collections,
                              const std::vector<parser::CategoryValueSeries> &categoryValueSeries) {
+  std::vector<DropdownValue> dropdownElements;
+  dropdownElements.reserve(collections.size() + xySeries.size() + categoryValueSeries.size());
 
   for (const auto &collection : collections) {
     series.emplace(collection.id, makeTie(collection));
+    nextDerivedId = std::max(nextDerivedId, collection.id + 1u);
     dropdownElements.emplace_back(
         DropdownValue{QString::fromStdString(collection.name), SeriesType::Collection, collection.id});
+
+    for (const auto seriesId : collection.series) {
+      auto &membership = collectionMembership[seriesId];
+
+      // Guard against a series listed in the same collection twice
+      if (std::find(membership.begin(), membership.end(), collection.id) == membership.end())
+        membership.emplace_back(collection.id);
+    }
   }
 
   for (const auto &xy : xySeries) {
     series.emplace(xy.id, makeTie(xy));
+    nextDerivedId = std::max(nextDerivedId, xy.id + 1u);
 
     if (xy.visible) {
       dropdownElements.emplace_back(DropdownValue{QString::fromStdString(xy.name), SeriesType::XY, xy.id});
@@ -549,6 +776,7 @@ void ChartManager::addSeries(const std::vector<parser::XYSeries> &xySeries,
 
   for (const auto &category : categoryValueSeries) {
     series.emplace(category.id, makeTie(category));
+    nextDerivedId = std::max(nextDerivedId, category.id + 1u);
 
     if (category.visible) {
       dropdownElements.emplace_back(
@@ -556,13 +784,107 @@ void ChartManager::addSeries(const std::vector<parser::XYSeries> &xySeries,
     }
   }
 
-  setChildrenSeries(dropdownElements);
+  seriesModel->setSeries(dropdownElements);
 }
 void ChartManager::setSortOrder(SettingsManager::ChartDropdownSortOrder value) {
   sortOrder = value;
-  for (const auto widget : chartWidgets) {
-    widget->setSortOrder(sortOrder);
+  seriesModel->setSortOrder(sortOrder);
+}
+
+void ChartManager::setDecimation(SettingsManager::ChartDecimation value) {
+  decimation = value;
+  for (auto &[key, s] : series) {
+    if (std::holds_alternative<XYSeriesTie>(s))
+      std::get<XYSeriesTie>(s).decimator.setMethod(decimation);
   }
+
+  refreshViewedSeries();
+}
+
+void ChartManager::setOpenGLView(bool enable) {
+  for (const auto widget : chartWidgets)
+    widget->setOpenGLView(enable);
+}
+
+void ChartManager::setStatisticsWindow(parser::nanoseconds value) {
+  statisticsWindow = value;
+
+  for (const auto id : statisticsSeries)
+    std::get<XYSeriesTie>(series[id]).statistics.setWindow(statisticsWindow);
+  updateStatistics();
+}
+
+void ChartManager::watchStatistics(unsigned int id) {
+  auto &tie = std::get<XYSeriesTie>(getSeries(id));
+  if (tie.statistics.getWindow() != statisticsWindow)
+    tie.statistics.setWindow(statisticsWindow);
+
+  tie.statistics.seek(tie.data, tie.visible, currentTime);
+  statisticsSeries.insert(id);
+}
+
+void ChartManager::unwatchStatistics(unsigned int id) {
+  statisticsSeries.erase(id);
+}
+
+unsigned int ChartManager::deriveSeries(unsigned int sourceId, SeriesStatistics::Statistic statistic) {
+  const auto key = std::make_tuple(sourceId, statistic, statisticsWindow);
+  if (const auto existing = derivedIds.find(key); existing != derivedIds.end())
+    return existing->second;
+
+  const auto &source = std::get<XYSeriesTie>(getSeries(sourceId));
+  const auto id = nextDerivedId++;
+
+  const auto window = statisticsWindow > 0LL ? QString::number(statisticsWindow / MILLISECOND) + " ms" : "All Points";
+  const auto suffix = (" - " + SeriesStatistics::name(statistic) + " (" + window + ")").toStdString();
+
+  auto model = source.model;
+  model.id = id;
+  model.name += suffix;
+  model.legend += suffix;
+  model.visible = true;
+  model.connection = parser::XYSeries::Connection::Line;
+  model.labelMode = parser::XYSeries::LabelMode::Hidden;
+
+  // Grow to fit the statistic, rather than the source values
+  model.yAxis.boundMode = parser::ValueAxis::BoundMode::HighestValue;
+  model.yAxis.min = 0.0;
+  model.yAxis.max = 0.0;
+  if (statistic == SeriesStatistics::Statistic::Count || statistic == SeriesStatistics::Statistic::Variance) {
+    model.yAxis.name = SeriesStatistics::name(statistic).toStdString();
+    model.yAxis.scale = parser::ValueAxis::Scale::Linear;
+  }
+
+  auto tie = makeTie(model);
+  tie.data = SeriesStatistics::derive(source.data, statistic, statisticsWindow);
+  tie.visible = tie.data.visibleRange(currentTime);
+
+  Bounds addedX;
+  Bounds addedY;
+  for (std::size_t i = 0u; i < tie.visible.end; i++) {
+    addedX.add(tie.data.xAt(i));
+    addedY.add(tie.data.yAt(i));
+  }
+  if (tie.model.xAxis.boundMode == parser::ValueAxis::BoundMode::HighestValue)
+    updateRange(tie.xRange, nullptr, addedX);
+  updateRange(tie.yRange, nullptr, addedY);
+
+  // `source` may not be used past here, adding a series may move it
+  series.emplace(id, std::move(tie));
+  derivedSeries[sourceId].emplace_back(id);
+  derivedIds.emplace(key, id);
+
+  seriesModel->addSeries(DropdownValue{QString::fromStdString(model.name), SeriesType::XY, id});
+
+  return id;
+}
+
+void ChartManager::setSeriesView(unsigned int id, const SeriesDecimator::View &view) {
+  auto &tie = std::get<XYSeriesTie>(getSeries(id));
+  tie.decimator.setView(view);
+  viewedSeries.insert(id);
+
+  refreshSeries(tie);
 }
 
 } // namespace netsimulyzer
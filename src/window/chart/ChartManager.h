@@ -32,6 +32,10 @@
  */
 
 #pragma once
+#include "SeriesDecimator.h"
+#include "SeriesStatistics.h"
+#include "SeriesStore.h"
+#include "src/util/common-times.h"
 #include "src/util/undo-events.h"
 #include <QComboBox>
 #include <QFrame>
@@ -39,23 +43,33 @@
 #include <QLayout>
 #include <QMainWindow>
 #include <QObject>
+#include <QPointF>
 #include <QString>
+#include <QVector>
 #include <QtCharts/QAbstractAxis>
 #include <QtCharts/QCategoryAxis>
 #include <QtCharts/QChartView>
 #include <QtCharts/QLineSeries>
 #include <QtCharts/QValueAxis>
+#include <cstddef>
 #include <cstdint>
 #include <deque>
+#include <functional>
+#include <limits>
+#include <map>
 #include <model.h>
 #include <optional>
+#include <queue>
 #include <src/settings/SettingsManager.h>
+#include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <variant>
 
 namespace netsimulyzer {
 
 class ChartWidget;
+class SeriesPickerModel;
 
 class ChartManager : public QObject {
   Q_OBJECT
@@ -63,25 +77,109 @@ class ChartManager : public QObject {
 public:
   enum class SeriesType : int { XY, CategoryValue, Collection };
 
+  /**
+   * The extent of a set of values.
+   * Either those added to a series during one step, or an axis range
+   */
+  struct Bounds {
+    double min{std::numeric_limits<double>::max()};
+    double max{std::numeric_limits<double>::lowest()};
+
+    /**
+     * Extend the bounds to include `value`
+     *
+     * @param value
+     * The added value
+     */
+    void add(double value);
+
+    /**
+     * @return
+     * True if no values were added
+     */
+    [[nodiscard]] bool empty() const;
+  };
+
+  /*
+   * The Qt objects of a tie are only created while
+   * a `ChartWidget` displays the series, otherwise they are null.
+   * Axis ranges are tracked on the tie, so they may be
+   * restored when the axes are created again.
+   */
+
   struct SeriesCollectionTie {
     parser::SeriesCollection model;
-    QtCharts::QAbstractAxis *xAxis;
-    QtCharts::QAbstractAxis *yAxis;
+    QtCharts::QAbstractAxis *xAxis{nullptr};
+    QtCharts::QAbstractAxis *yAxis{nullptr};
+    Bounds xRange;
+    Bounds yRange;
   };
 
   struct XYSeriesTie {
     parser::XYSeries model;
-    QtCharts::QXYSeries *qtSeries;
-    QtCharts::QAbstractAxis *xAxis;
-    QtCharts::QAbstractAxis *yAxis;
+
+    /**
+     * Only holds the reduced points from `decimator`
+     */
+    QtCharts::QXYSeries *qtSeries{nullptr};
+    QtCharts::QAbstractAxis *xAxis{nullptr};
+    QtCharts::QAbstractAxis *yAxis{nullptr};
+    Bounds xRange;
+    Bounds yRange;
+
+    /**
+     * Every point the series will hold, built from its events at load time
+     */
+    SeriesStore data;
+
+    /**
+     * The points of `data` shown at the current time
+     */
+    SeriesStore::Range visible;
+    SeriesDecimator decimator{SettingsManager::ChartDecimation::MinMax};
+
+    /**
+     * Aggregates over the window ending at the current time.
+     * Only kept up to date while the series is in `statisticsSeries`
+     */
+    SeriesStatistics statistics;
+
+    /**
+     * Flag indicating the series is in `pendingSeeks`
+     */
+    bool seekPending{false};
   };
 
   struct CategoryValueTie {
     parser::CategoryValueSeries model;
-    QtCharts::QXYSeries *qtSeries;
-    QtCharts::QAbstractAxis *xAxis;
-    QtCharts::QCategoryAxis *yAxis;
+    QtCharts::QXYSeries *qtSeries{nullptr};
+    QtCharts::QAbstractAxis *xAxis{nullptr};
+    QtCharts::QCategoryAxis *yAxis{nullptr};
+    Bounds xRange;
     parser::nanoseconds lastUpdatedTime;
+
+    /**
+     * Every point currently in the series.
+     * Handed to `qtSeries` once per step, if it exists
+     */
+    QVector<QPointF> points;
+
+    /**
+     * The values added since the last flush
+     */
+    Bounds addedX;
+    Bounds addedY;
+
+    /**
+     * Flag indicating the series is in `pendingCategorySeries`
+     */
+    bool flushPending{false};
+
+    /**
+     * The number of points removed from `points` by rewinds.
+     * Lets views holding a copy of `points` see when it no longer matches
+     */
+    std::size_t removedPoints{0u};
   };
 
   struct DropdownValue {
@@ -95,21 +193,163 @@ public:
   const static unsigned int PlaceholderId{0u};
 
 private:
+  /**
+   * The time an XY series event applies, and the series it applies to
+   */
+  struct XYSeriesChange {
+    parser::nanoseconds time;
+    unsigned int seriesId;
+  };
+
   SettingsManager settings;
+
+  /**
+   * Pending events for series not kept in a `SeriesStore`
+   */
   std::deque<parser::ChartEvent> events;
   std::deque<undo::ChartUndoEvent> undoEvents;
 
+  /**
+   * Every XY series event, in the order they apply.
+   * Used to find the series affected by a change in time
+   */
+  std::vector<XYSeriesChange> xySeriesChanges;
+
+  /**
+   * The number of `xySeriesChanges` applied as of the current time
+   */
+  std::size_t xySeriesChangesApplied{0u};
+
+  /**
+   * The time of the last XY series event loaded
+   */
+  parser::nanoseconds lastXYSeriesTime{0LL};
+
+  /**
+   * IDs of the XY series with a change applied or undone since the last seek
+   */
+  std::vector<unsigned int> pendingSeeks;
+
+  /**
+   * IDs of the Category Value series with points added or removed since the last flush
+   */
+  std::vector<unsigned int> pendingCategorySeries;
+
+  /**
+   * When an auto updating Category Value series is next due for a value
+   */
+  struct AutoUpdate {
+    parser::nanoseconds due;
+    unsigned int seriesId;
+
+    bool operator>(const AutoUpdate &other) const {
+      return due > other.due;
+    }
+  };
+
+  /**
+   * Auto updating Category Value series, soonest due first.
+   * An entry is stale, and skipped, if its series was updated after it was scheduled
+   */
+  std::priority_queue<AutoUpdate, std::vector<AutoUpdate>, std::greater<>> autoUpdates;
+
   std::unordered_map<uint32_t, TieVariant> series;
   SettingsManager::ChartDropdownSortOrder sortOrder{
       settings.get<SettingsManager::ChartDropdownSortOrder>(SettingsManager::Key::ChartDropdownSortOrder).value()};
-  std::vector<DropdownValue> dropdownElements;
+  SettingsManager::ChartDecimation decimation{
+      settings.get<SettingsManager::ChartDecimation>(SettingsManager::Key::ChartDecimation).value()};
+
+  /**
+   * Every series offered by the `ChartWidget`s.
+   * Shared between them, so each series is only sorted & indexed once
+   */
+  SeriesPickerModel *seriesModel;
   std::vector<ChartWidget *> chartWidgets;
 
+  /**
+   * Series ID -> IDs of the collections containing it.
+   * Built in `addSeries()`, series in no collections are absent
+   */
+  std::unordered_map<unsigned int, std::vector<unsigned int>> collectionMembership;
+
+  /**
+   * IDs of the XY series with a view set by a `ChartWidget`
+   */
+  std::unordered_set<unsigned int> viewedSeries;
+
+  /**
+   * The time the series were last moved to
+   */
+  parser::nanoseconds currentTime{0LL};
+
+  /**
+   * The length of the window statistics are taken over. 0 for every visible point
+   */
+  parser::nanoseconds statisticsWindow{
+      static_cast<parser::nanoseconds>(settings.get<int>(SettingsManager::Key::ChartStatisticsWindow).value()) *
+      MILLISECOND};
+
+  /**
+   * IDs of the XY series a `ChartWidget` shows statistics for
+   */
+  std::unordered_set<unsigned int> statisticsSeries;
+
+  /**
+   * Source series ID -> IDs of the series derived from it
+   */
+  std::unordered_map<unsigned int, std::vector<unsigned int>> derivedSeries;
+
+  /**
+   * (Source series ID, statistic, window) -> ID of the derived series
+   */
+  std::map<std::tuple<unsigned int, SeriesStatistics::Statistic, parser::nanoseconds>, unsigned int> derivedIds;
+
+  /**
+   * The ID given to the next derived series.
+   * Past the largest loaded ID, so the two never collide
+   */
+  unsigned int nextDerivedId{PlaceholderId + 1u};
+
   XYSeriesTie makeTie(const parser::XYSeries &model);
   SeriesCollectionTie makeTie(const parser::SeriesCollection &model);
   CategoryValueTie makeTie(const parser::CategoryValueSeries &model);
-  void updateCollectionRanges(uint32_t seriesId, double x, double y);
-  void setChildrenSeries(const std::vector<DropdownValue> &values);
+
+  /**
+   * Create the Qt series & axes for `tie`, if they do not already exist.
+   * Collections create the Qt objects for their members as well
+   *
+   * @param tie
+   * The series about to be displayed
+   */
+  void materialize(XYSeriesTie &tie);
+  void materialize(SeriesCollectionTie &tie);
+  void materialize(CategoryValueTie &tie);
+
+  /**
+   * Delete the Qt series & axes of `tie`.
+   * Collections delete the Qt objects of their members as well
+   *
+   * @param tie
+   * The series no longer displayed
+   */
+  void release(XYSeriesTie &tie);
+  void release(SeriesCollectionTie &tie);
+  void release(CategoryValueTie &tie);
+
+  /**
+   * Extend the axes of every collection containing
+   * the series identified by `seriesId`
+   *
+   * @param seriesId
+   * The ID of the series with added values
+   *
+   * @param x
+   * The extent of the added X values
+   *
+   * @param y
+   * The extent of the added Y values
+   */
+  void updateCollectionRanges(uint32_t seriesId, const Bounds &x, const Bounds &y);
 
   /**
    * Finds all the collections the series
@@ -121,7 +361,7 @@ private:
    * @return
    * The IDs of all the collections `id` is in
    */
-  std::vector<unsigned int> inCollections(unsigned int id);
+  [[nodiscard]] const std::vector<unsigned int> &inCollections(unsigned int id) const;
 
   /**
    * Clear the series identified by `id` from
@@ -138,6 +378,87 @@ private:
   void timeAdvanced(parser::nanoseconds time);
   void timeRewound(parser::nanoseconds time);
 
+  /**
+   * Add a point to the Category Value series `tie`,
+   * and queue it for the next `flushCategorySeries()`
+   *
+   * @param tie
+   * The series to add to
+   *
+   * @param value
+   * The X value of the new point
+   *
+   * @param category
+   * The ID of the category of the new point
+   */
+  void appendCategoryValue(CategoryValueTie &tie, double value, unsigned int category);
+
+  /**
+   * Schedule the next auto update for `tie`, based on its `lastUpdatedTime`.
+   * Does nothing if the series does not auto update
+   *
+   * @param tie
+   * The series which was just updated
+   */
+  void scheduleAutoUpdate(const CategoryValueTie &tie);
+
+  /**
+   * Queue the Category Value series identified by `id` for the next `flushCategorySeries()`
+   *
+   * @param id
+   * The ID of the changed series
+   */
+  void markFlush(unsigned int id);
+
+  /**
+   * Hand the points of each changed Category Value series to QtCharts
+   * in a single call, and extend the axes once for all the added values
+   *
+   * @return
+   * True if any series changed
+   */
+  bool flushCategorySeries();
+
+  /**
+   * Queue the XY series identified by `id` for the next `seekXYSeries()`
+   *
+   * @param id
+   * The ID of the changed series
+   */
+  void markSeek(unsigned int id);
+
+  /**
+   * Move every XY series with events between the last seek & `time`
+   * to the points they show at `time`. Each displayed series
+   * is updated with at most one `replace()`
+   *
+   * @param time
+   * The current simulation time
+   *
+   * @return
+   * True if any series changed
+   */
+  bool seekXYSeries(parser::nanoseconds time);
+
+  /**
+   * Push the reduced points of `tie` to its QtCharts series,
+   * if they changed since the last refresh
+   *
+   * @param tie
+   * The displayed series to refresh
+   */
+  void refreshSeries(XYSeriesTie &tie);
+
+  /**
+   * Refresh every series in `viewedSeries`
+   */
+  void refreshViewedSeries();
+
+  /**
+   * Move the statistics of every series in `statisticsSeries` to the current time
+   */
+  void updateStatistics();
+
 public:
   explicit ChartManager(QWidget *parent);
 
@@ -165,10 +486,121 @@ public:
                  const std::vector<parser::CategoryValueSeries> &categoryValueSeries);
   TieVariant &getSeries(uint32_t seriesId);
 
+  /**
+   * Signal a widget is about to display the series identified by `selected`.
+   * Clears the series from other widgets
+   *
+   * @param widget
+   * The widget displaying the series
+   *
+   * @param selected
+   * The ID of the series to display
+   */
   void seriesSelected(const ChartWidget *widget, unsigned int selected);
+
+  /**
+   * Create the QtCharts objects for the series identified by `id`,
+   * so it may be shown on a `QChart`
+   *
+   * @param id
+   * The ID of the series to display
+   */
+  void materializeSeries(unsigned int id);
+
+  /**
+   * Signal a widget has removed the series identified by `deselected`
+   * from its chart. Deletes the Qt objects of the series
+   *
+   * @param deselected
+   * The ID of the series no longer displayed
+   */
+  void seriesDeselected(unsigned int deselected);
   void timeChanged(parser::nanoseconds time, parser::nanoseconds increment);
   void enqueueEvents(const std::vector<parser::ChartEvent> &e);
   void setSortOrder(SettingsManager::ChartDropdownSortOrder value);
+
+  /**
+   * Change the method used to reduce XY series for display
+   *
+   * @param value
+   * The new decimation method
+   */
+  void setDecimation(SettingsManager::ChartDecimation value);
+
+  /**
+   * Switch every widget between QtCharts & `GLChartView`
+   *
+   * @param enable
+   * True to draw charts with `GLChartView`
+   */
+  void setOpenGLView(bool enable);
+
+  /**
+   * Change the length of the window statistics are taken over.
+   * Series already derived keep the window they were built with
+   *
+   * @param value
+   * The new window length. 0 for every visible point
+   */
+  void setStatisticsWindow(parser::nanoseconds value);
+
+  /**
+   * Keep the statistics of the XY series identified by `id` up to date
+   *
+   * @param id
+   * The ID of the XY series to show statistics for
+   */
+  void watchStatistics(unsigned int id);
+
+  /**
+   * Stop updating the statistics of the XY series identified by `id`
+   *
+   * @param id
+   * The ID of the XY series to stop showing statistics for
+   */
+  void unwatchStatistics(unsigned int id);
+
+  /**
+   * Add an XY series of `statistic` over the XY series identified by `sourceId`,
+   * using the current statistics window. Adds it to the dropdowns
+   * of every widget, unless the same series was already derived
+   *
+   * @param sourceId
+   * The ID of the XY series to take the statistic of
+   *
+   * @param statistic
+   * The statistic to plot
+   *
+   * @return
+   * The ID of the derived series
+   */
+  unsigned int deriveSeries(unsigned int sourceId, SeriesStatistics::Statistic statistic);
+
+  /**
+   * Set the part of the XY series identified by `id` that
+   * a widget displays, and fill its QtCharts series with
+   * the points reduced for that view
+   *
+   * @param id
+   * The ID of the XY series being displayed
+   *
+   * @param view
+   * The visible X range & width of the plot area
+   */
+  void setSeriesView(unsigned int id, const SeriesDecimator::View &view);
+
+signals:
+  /**
+   * Emitted at most once per time change,
+   * if the points of any series changed
+   */
+  void seriesChanged();
+
+  /**
+   * Emitted after every time change while
+   * any series in `statisticsSeries` is shown
+   */
+  void statisticsChanged();
 };
 
 } // namespace netsimulyzer
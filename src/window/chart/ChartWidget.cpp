@@ -34,19 +34,22 @@
 #include "ChartWidget.h"
 #include <QConstOverload>
 #include <QGraphicsLayout>
-#include <QStandardItemModel>
 #include <QString>
+#include <QStringList>
 #include <QtCharts/QCategoryAxis>
 #include <QtCharts/QLogValueAxis>
 #include <QtCharts/QScatterSeries>
 #include <QtCharts/QSplineSeries>
+#include <QtCharts/QValueAxis>
+#include <algorithm>
+#include <cmath>
 #include <utility>
 
 namespace netsimulyzer {
 
-void ChartWidget::seriesSelected(int index) {
+void ChartWidget::seriesSelected(unsigned int id) {
   clearChart();
-  auto selectedSeriesId = ui.comboBoxSeries->itemData(index).toUInt();
+  const auto selectedSeriesId = id;
 
   manager.seriesSelected(this, selectedSeriesId);
   currentSeries = selectedSeriesId;
@@ -58,7 +61,19 @@ void ChartWidget::seriesSelected(int index) {
   }
 
   auto &s = manager.getSeries(selectedSeriesId);
+  watchStatistics(selectedSeriesId);
+
+  if (openGLView) {
+    setWindowTitle(std::visit(
+        [](const auto &tie) {
+          return QString::fromStdString(tie.model.name);
+        },
+        s));
+    glView->showSeries(selectedSeriesId);
+    return;
+  }
 
+  manager.materializeSeries(selectedSeriesId);
   if (std::holds_alternative<ChartManager::XYSeriesTie>(s))
     showSeries(std::get<ChartManager::XYSeriesTie>(s));
   else if (std::holds_alternative<ChartManager::SeriesCollectionTie>(s))
@@ -82,6 +97,10 @@ void ChartWidget::showSeries(const ChartManager::XYSeriesTie &tie) {
   // been added to the chart...
   tie.qtSeries->attachAxis(tie.xAxis);
   tie.qtSeries->attachAxis(tie.yAxis);
+
+  displayedSeries.emplace_back(tie.model.id);
+  watchXAxis(tie.xAxis);
+  updateViews();
 }
 
 void ChartWidget::showSeries(const ChartManager::SeriesCollectionTie &tie) {
@@ -95,6 +114,7 @@ void ChartWidget::showSeries(const ChartManager::SeriesCollectionTie &tie) {
     if (std::holds_alternative<ChartManager::XYSeriesTie>(seriesVariant)) {
       const auto &xySeries = std::get<ChartManager::XYSeriesTie>(seriesVariant);
       chart.addSeries(xySeries.qtSeries);
+      displayedSeries.emplace_back(seriesId);
     }
   }
 
@@ -105,6 +125,9 @@ void ChartWidget::showSeries(const ChartManager::SeriesCollectionTie &tie) {
     chartSeries->attachAxis(tie.xAxis);
     chartSeries->attachAxis(tie.yAxis);
   }
+
+  watchXAxis(tie.xAxis);
+  updateViews();
 }
 
 void ChartWidget::showSeries(const ChartManager::CategoryValueTie &tie) {
@@ -125,6 +148,9 @@ void ChartWidget::showSeries(const ChartManager::CategoryValueTie &tie) {
 }
 
 void ChartWidget::clearChart() {
+  QObject::disconnect(xAxisConnection);
+  displayedSeries.clear();
+
   // Remove old axes
   auto currentAxes = chart.axes();
 
@@ -137,19 +163,121 @@ void ChartWidget::clearChart() {
     }
 
     chart.removeSeries(activeSeries);
-    // The chart claims ownership of the series when it's attached
-    activeSeries->setParent(&manager);
   }
 
   for (const auto &axis : currentAxes) {
     chart.removeAxis(axis);
-
-    // Reclaim ownership of the axis
-    // Since the chart takes it when it is attached
-    axis->setParent(&manager);
   }
 
+  // The manager deletes the removed series & axes
+  manager.seriesDeselected(currentSeries);
   chart.setTitle("");
+
+  glView->clear();
+
+  for (const auto id : statisticsSeries)
+    manager.unwatchStatistics(id);
+  statisticsSeries.clear();
+  ui.labelStatistics->clear();
+  ui.labelStatistics->setVisible(false);
+  ui.comboBoxStatistic->setEnabled(false);
+}
+
+void ChartWidget::watchXAxis(QtCharts::QAbstractAxis *axis) {
+  if (const auto valueAxis = qobject_cast<QtCharts::QValueAxis *>(axis))
+    xAxisConnection =
+        QObject::connect(valueAxis, &QtCharts::QValueAxis::rangeChanged, this, &ChartWidget::updateViews);
+  else if (const auto logAxis = qobject_cast<QtCharts::QLogValueAxis *>(axis))
+    xAxisConnection =
+        QObject::connect(logAxis, &QtCharts::QLogValueAxis::rangeChanged, this, &ChartWidget::updateViews);
+}
+
+void ChartWidget::updateViews() {
+  if (displayedSeries.empty())
+    return;
+
+  const auto axes = chart.axes(Qt::Horizontal);
+  if (axes.isEmpty())
+    return;
+
+  SeriesDecimator::View view{};
+  if (const auto valueAxis = qobject_cast<QtCharts::QValueAxis *>(axes.front())) {
+    view.min = valueAxis->min();
+    view.max = valueAxis->max();
+    view.logarithmic = false;
+  } else if (const auto logAxis = qobject_cast<QtCharts::QLogValueAxis *>(axes.front())) {
+    view.min = logAxis->min();
+    view.max = logAxis->max();
+    view.logarithmic = true;
+  } else
+    return;
+
+  // Reduce to physical pixels, so high DPI displays don't lose detail
+  const auto width = chart.plotArea().width() * ui.chartView->devicePixelRatioF();
+  view.columns = std::max(1, static_cast<int>(std::ceil(width)));
+
+  for (const auto id : displayedSeries)
+    manager.setSeriesView(id, view);
+}
+
+void ChartWidget::watchStatistics(unsigned int id) {
+  const auto &s = manager.getSeries(id);
+  if (std::holds_alternative<ChartManager::XYSeriesTie>(s)) {
+    statisticsSeries.emplace_back(id);
+
+    // Only single series may be derived from
+    ui.comboBoxStatistic->setEnabled(true);
+  } else if (const auto collection = std::get_if<ChartManager::SeriesCollectionTie>(&s)) {
+    for (const auto seriesId : collection->model.series) {
+      if (std::holds_alternative<ChartManager::XYSeriesTie>(manager.getSeries(seriesId)))
+        statisticsSeries.emplace_back(seriesId);
+    }
+  }
+
+  for (const auto seriesId : statisticsSeries)
+    manager.watchStatistics(seriesId);
+
+  ui.labelStatistics->setVisible(!statisticsSeries.empty());
+  updateStatistics();
+}
+
+void ChartWidget::updateStatistics() {
+  using Statistic = SeriesStatistics::Statistic;
+  if (statisticsSeries.empty())
+    return;
+
+  QStringList lines;
+  for (const auto id : statisticsSeries) {
+    const auto &tie = std::get<ChartManager::XYSeriesTie>(manager.getSeries(id));
+
+    QStringList values;
+    for (auto i = static_cast<int>(Statistic::Count); i <= static_cast<int>(Statistic::Percentile99); i++) {
+      const auto statistic = static_cast<Statistic>(i);
+      values << SeriesStatistics::name(statistic) + ": " + QString::number(tie.statistics.value(statistic), 'g', 6);
+    }
+
+    // Only name the series when there may be more than one
+    auto line = values.join("  ");
+    if (statisticsSeries.size() > 1u)
+      line.prepend(QString::fromStdString(tie.model.name) + " - ");
+    lines << line;
+  }
+
+  ui.labelStatistics->setText(lines.join('\n'));
+}
+
+void ChartWidget::plotStatistic(int index) {
+  const auto statistic = ui.comboBoxStatistic->itemData(index);
+
+  // Leave the placeholder selected, so the same statistic may be picked again
+  ui.comboBoxStatistic->setCurrentIndex(0);
+  if (!statistic.isValid() || statisticsSeries.size() != 1u)
+    return;
+
+  const auto id =
+      manager.deriveSeries(statisticsSeries.front(), static_cast<SeriesStatistics::Statistic>(statistic.toInt()));
+  ui.seriesPicker->setCurrentSeries(id);
+  seriesSelected(id);
 }
 
 void ChartWidget::closeEvent(QCloseEvent *event) {
@@ -159,8 +287,8 @@ void ChartWidget::closeEvent(QCloseEvent *event) {
   QDockWidget::closeEvent(event);
 }
 
-ChartWidget::ChartWidget(QWidget *parent, ChartManager &manager, std::vector<ChartManager::DropdownValue> initialSeries)
-    : QDockWidget(parent), manager(manager), dropdownValues(std::move(initialSeries)) {
+ChartWidget::ChartWidget(QWidget *parent, ChartManager &manager, SeriesPickerModel &seriesModel)
+    : QDockWidget(parent), manager(manager) {
   ui.setupUi(this);
   setWindowTitle("Chart Widget");
 
@@ -173,138 +301,56 @@ ChartWidget::ChartWidget(QWidget *parent, ChartManager &manager, std::vector<Cha
 
   ui.chartView->setChart(&chart);
 
-  sortDropdown();
-  populateDropdown();
+  glView = new GLChartView{ui.dockWidgetContents, manager};
+  ui.verticalLayout->insertWidget(ui.verticalLayout->indexOf(ui.chartView) + 1, glView);
+  ui.chartView->setVisible(!openGLView);
+  glView->setVisible(openGLView);
 
-  QObject::connect(ui.comboBoxSeries, qOverload<int>(&QComboBox::currentIndexChanged), this,
-                   &ChartWidget::seriesSelected);
+  // Resizing the widget changes how many points fit across the plot
+  QObject::connect(&chart, &QtCharts::QChart::plotAreaChanged, this, &ChartWidget::updateViews);
 
-  setFloating(false);
-  setVisible(true);
-}
-
-void ChartWidget::addSeries(ChartManager::DropdownValue dropdownValue) {
-  dropdownValues.emplace_back(dropdownValue);
-}
-
-void ChartWidget::setSeries(std::vector<ChartManager::DropdownValue> values) {
-  dropdownValues = std::move(values);
-  sortDropdown();
-  populateDropdown();
-}
+  ui.seriesPicker->setModel(seriesModel);
+  QObject::connect(ui.seriesPicker, &SeriesPicker::seriesPicked, this, &ChartWidget::seriesSelected);
 
-void ChartWidget::sortDropdown() {
-  using SortOrder = SettingsManager::ChartDropdownSortOrder;
-  using DropdownValue = ChartManager::DropdownValue;
-
-  switch (sortOrder) {
-  case SortOrder::Alphabetical:
-    std::sort(dropdownValues.begin(), dropdownValues.end(), [](const DropdownValue &left, const DropdownValue &right) {
-      return QString::localeAwareCompare(left.name, right.name) < 0;
-    });
-    break;
-  case SortOrder::Type:
-    // Sort by type
-    std::sort(dropdownValues.begin(), dropdownValues.end(), [](const auto &left, const auto &right) -> bool {
-      return static_cast<int>(left.type) < static_cast<int>(right.type);
-    });
-
-    // Sort Alphabetically within types
-    std::sort(dropdownValues.begin(), dropdownValues.end(), [](const auto &left, const auto &right) -> bool {
-      // Do not reorder along type boundaries
-      // since we know the elements are in type order
-      // should hold the boundaries in place
-      if (left.type != right.type) {
-        return false;
-      }
-      return QString::localeAwareCompare(left.name, right.name) < 0;
-    });
-
-    break;
-  case SortOrder::Id:
-    std::sort(dropdownValues.begin(), dropdownValues.end(), [](const auto &left, const auto &right) -> bool {
-      return left.id < right.id;
-    });
-    break;
-  case SortOrder::None:
-    // Intentionally Blank
-    break;
-  default:
-    std::cerr << "Unrecognised SortOrder: " << static_cast<int>(sortOrder) << '\n';
-    std::abort();
-    break;
+  ui.comboBoxStatistic->addItem("Plot Statistic");
+  for (auto i = static_cast<int>(SeriesStatistics::Statistic::Count);
+       i <= static_cast<int>(SeriesStatistics::Statistic::Percentile99); i++) {
+    ui.comboBoxStatistic->addItem(SeriesStatistics::name(static_cast<SeriesStatistics::Statistic>(i)), i);
   }
-}
-
-void ChartWidget::populateDropdown() {
-  using SortOrder = SettingsManager::ChartDropdownSortOrder;
-
-  const auto previousSeries = currentSeries;
-  ui.comboBoxSeries->clear();
-  ui.comboBoxSeries->addItem("Select Series", ChartManager::PlaceholderId);
-
-  // We need the item model to set flags
-  auto model = qobject_cast<QStandardItemModel *>(ui.comboBoxSeries->model());
-
-  // Starter for Type sort order labels
-  ChartManager::SeriesType lastType;
-  if (sortOrder == SortOrder::Type && !dropdownValues.empty()) {
-    lastType = dropdownValues.begin()->type;
-    switch (lastType) {
-    case ChartManager::SeriesType::XY:
-      ui.comboBoxSeries->addItem("XYSeries");
-      break;
-    case ChartManager::SeriesType::CategoryValue:
-      ui.comboBoxSeries->addItem("CategoryValueSeries");
-      break;
-    case ChartManager::SeriesType::Collection:
-      ui.comboBoxSeries->addItem("Collections");
-      break;
-    }
+  ui.comboBoxStatistic->setEnabled(false);
+  ui.labelStatistics->setVisible(false);
 
-    auto item = model->item(ui.comboBoxSeries->count() - 1);
-    item->setFlags(item->flags() & ~Qt::ItemIsEnabled);
-  }
+  QObject::connect(ui.comboBoxStatistic, qOverload<int>(&QComboBox::activated), this, &ChartWidget::plotStatistic);
+  QObject::connect(&manager, &ChartManager::statisticsChanged, this, &ChartWidget::updateStatistics);
 
-  for (const auto &dropDownValue : dropdownValues) {
-    // If we're sorting by type, add in labels for each type we encounter
-    if (sortOrder == SortOrder::Type && lastType != dropDownValue.type) {
-      switch (dropDownValue.type) {
-      case ChartManager::SeriesType::XY:
-        ui.comboBoxSeries->addItem("XYSeries");
-        break;
-      case ChartManager::SeriesType::CategoryValue:
-        ui.comboBoxSeries->addItem("CategoryValueSeries");
-        break;
-      case ChartManager::SeriesType::Collection:
-        ui.comboBoxSeries->addItem("Collections");
-        break;
-      }
-      auto item = model->item(ui.comboBoxSeries->count() - 1);
-      item->setFlags(item->flags() & ~Qt::ItemIsEnabled);
-      ui.comboBoxSeries->show();
-    }
-    lastType = dropDownValue.type;
-    ui.comboBoxSeries->addItem(dropDownValue.name, dropDownValue.id);
-  }
-  ui.comboBoxSeries->setCurrentIndex(ui.comboBoxSeries->findData(previousSeries));
+  setFloating(false);
+  setVisible(true);
 }
 
 void ChartWidget::reset() {
   clearChart();
-  dropdownValues.clear();
-  populateDropdown();
+
+  // The series no longer exist, so the manager need not be told
+  currentSeries = ChartManager::PlaceholderId;
+  ui.seriesPicker->setCurrentSeries(currentSeries);
+  setWindowTitle("Chart Widget");
 }
 
-void ChartWidget::setSortOrder(SettingsManager::ChartDropdownSortOrder value) {
-  sortOrder = value;
-  sortDropdown();
-  populateDropdown();
+void ChartWidget::setOpenGLView(bool enable) {
+  if (enable == openGLView)
+    return;
+
+  clearChart();
+  openGLView = enable;
+  ui.chartView->setVisible(!openGLView);
+  glView->setVisible(openGLView);
+
+  seriesSelected(currentSeries);
 }
 
 void ChartWidget::clearSelected() {
-  clearChart();
-  ui.comboBoxSeries->setCurrentIndex(0);
+  ui.seriesPicker->setCurrentSeries(ChartManager::PlaceholderId);
+  seriesSelected(ChartManager::PlaceholderId);
 }
 
 unsigned int ChartWidget::getCurrentSeries() const {
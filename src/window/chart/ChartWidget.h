@@ -34,6 +34,8 @@
 #pragma once
 
 #include "ChartManager.h"
+#include "GLChartView.h"
+#include "SeriesPickerModel.h"
 #include "ui_ChartWidget.h"
 #include <QDockWidget>
 #include <QString>
@@ -51,11 +53,36 @@ class ChartWidget : public QDockWidget {
   QtCharts::QChart chart;
   Ui::ChartWidget ui{};
   unsigned int currentSeries{ChartManager::PlaceholderId};
-  std::vector<ChartManager::DropdownValue> dropdownValues;
-  SettingsManager::ChartDropdownSortOrder sortOrder =
-      settings.get<SettingsManager::ChartDropdownSortOrder>(SettingsManager::Key::ChartDropdownSortOrder).value();
 
-  void seriesSelected(int index);
+  /**
+   * Draws the selected series instead of `ui.chartView` while `openGLView` is set
+   */
+  GLChartView *glView;
+  bool openGLView = settings.get<bool>(SettingsManager::Key::ChartOpenGLView).value();
+
+  /**
+   * IDs of the XY series currently on the chart
+   */
+  std::vector<unsigned int> displayedSeries;
+
+  /**
+   * Connection to the range signal of the displayed X axis
+   */
+  QMetaObject::Connection xAxisConnection;
+
+  /**
+   * IDs of the XY series statistics are shown for
+   */
+  std::vector<unsigned int> statisticsSeries;
+
+  /**
+   * Display the series identified by `id`,
+   * replacing the current one
+   *
+   * @param id
+   * The ID of the series to display, or `PlaceholderId` to display nothing
+   */
+  void seriesSelected(unsigned int id);
   void showSeries(const ChartManager::XYSeriesTie &tie);
   void showSeries(const ChartManager::SeriesCollectionTie &tie);
   void showSeries(const ChartManager::CategoryValueTie &tie);
@@ -65,17 +92,69 @@ class ChartWidget : public QDockWidget {
    */
   void clearChart();
 
+  /**
+   * Follow changes to the range of `axis`,
+   * so the displayed series may be reduced for the new range
+   *
+   * @param axis
+   * The X axis of the displayed series
+   */
+  void watchXAxis(QtCharts::QAbstractAxis *axis);
+
+  /**
+   * Tell the manager what part of the displayed XY series are visible.
+   * Called when the chart is zoomed, scrolled or resized
+   */
+  void updateViews();
+
+  /**
+   * Show the statistics of the selected XY series,
+   * or each XY series in the selected collection
+   *
+   * @param id
+   * The ID of the selected series
+   */
+  void watchStatistics(unsigned int id);
+
+  /**
+   * Refresh the statistics text from the manager
+   */
+  void updateStatistics();
+
+  /**
+   * Add a series of the statistic at `index` in the statistic dropdown,
+   * taken over the selected series, and select it
+   *
+   * @param index
+   * The index of the chosen statistic in the dropdown
+   */
+  void plotStatistic(int index);
+
 protected:
   void closeEvent(QCloseEvent *event) override;
 
 public:
-  ChartWidget(QWidget *parent, ChartManager &manager, std::vector<ChartManager::DropdownValue> initialSeries);
-  void addSeries(ChartManager::DropdownValue dropdownValue);
-  void setSeries(std::vector<ChartManager::DropdownValue> values);
-  void sortDropdown();
-  void populateDropdown();
+  /**
+   * @param parent
+   * The widget that contains this one
+   *
+   * @param manager
+   * The manager holding the series
+   *
+   * @param seriesModel
+   * The series offered for selection, shared by every widget of `manager`
+   */
+  ChartWidget(QWidget *parent, ChartManager &manager, SeriesPickerModel &seriesModel);
   void reset();
-  void setSortOrder(SettingsManager::ChartDropdownSortOrder value);
+
+  /**
+   * Switch between the QtCharts & OpenGL views,
+   * showing the selected series in the new view
+   *
+   * @param enable
+   * True to draw with `GLChartView`
+   */
+  void setOpenGLView(bool enable);
 
   /**
    * Unselects the current series
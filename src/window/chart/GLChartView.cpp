@@ -0,0 +1,829 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#include "GLChartView.h"
+#include <QClipboard>
+#include <QColor>
+#include <QFile>
+#include <QFileDialog>
+#include <QFont>
+#include <QFontMetrics>
+#include <QGuiApplication>
+#include <QImage>
+#include <QMenu>
+#include <QMessageBox>
+#include <QOpenGLContext>
+#include <QPalette>
+#include <QTextStream>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <variant>
+
+namespace {
+
+/**
+ * Space between the plot, labels & the edge of the widget, in pixels
+ */
+const auto padding = 8;
+
+/**
+ * Length of the tick marks on each axis, in pixels
+ */
+const auto tickLength = 5;
+
+/**
+ * Size of the points of scatter series, in pixels
+ */
+const auto pointSize = 5.0f;
+
+/**
+ * Smallest number of points a buffer is allocated with
+ */
+const std::size_t minimumCapacity = 256u;
+
+/**
+ * Convert a series value to axis space
+ *
+ * @param value
+ * The value to convert
+ *
+ * @param logarithmic
+ * If the axis has a logarithmic scale.
+ * Values at or below zero are pushed off the bottom of these axes
+ *
+ * @return
+ * `value` for linear axes, the base 10 log of `value` for logarithmic ones
+ */
+double toAxis(double value, bool logarithmic) {
+  if (!logarithmic)
+    return value;
+
+  return std::log10(std::max(value, std::numeric_limits<double>::min()));
+}
+
+double fromAxis(double value, bool logarithmic) {
+  if (!logarithmic)
+    return value;
+
+  return std::pow(10.0, value);
+}
+
+/**
+ * Set the range of `axis` to `range`, converted to axis space
+ *
+ * @param axis
+ * The axis to change
+ *
+ * @param range
+ * The range of the series values
+ */
+template <class Axis>
+void setRange(Axis &axis, const netsimulyzer::ChartManager::Bounds &range) {
+  auto min = range.min;
+  auto max = range.max;
+
+  if (axis.logarithmic) {
+    if (max <= 0.0) {
+      min = 1.0;
+      max = 10.0;
+    } else if (min <= 0.0)
+      min = max / 1000.0;
+  }
+
+  axis.min = toAxis(min, axis.logarithmic);
+  axis.max = toAxis(max, axis.logarithmic);
+
+  // Leave room to draw a series with a single value
+  if (!(axis.max > axis.min)) {
+    axis.min -= 0.5;
+    axis.max += 0.5;
+  }
+}
+
+/**
+ * Pick evenly spaced values to label along an axis,
+ * with steps of 1, 2 or 5 times a power of ten.
+ * Logarithmic axes spanning more than a decade are labeled at powers of ten
+ *
+ * @param min
+ * The start of the axis, in axis space
+ *
+ * @param max
+ * The end of the axis, in axis space
+ *
+ * @param logarithmic
+ * If the axis has a logarithmic scale
+ *
+ * @param maxTicks
+ * The most ticks that fit along the axis
+ *
+ * @return
+ * The values to place ticks at, in axis space
+ */
+std::vector<double> ticks(double min, double max, bool logarithmic, int maxTicks) {
+  std::vector<double> values;
+  const auto span = max - min;
+  if (!(span > 0.0) || maxTicks < 1)
+    return values;
+
+  double step;
+  if (logarithmic && span >= 1.0)
+    step = std::ceil(span / maxTicks);
+  else {
+    const auto rough = span / maxTicks;
+    const auto magnitude = std::pow(10.0, std::floor(std::log10(rough)));
+    const auto residual = rough / magnitude;
+
+    if (residual > 5.0)
+      step = 10.0 * magnitude;
+    else if (residual > 2.0)
+      step = 5.0 * magnitude;
+    else if (residual > 1.0)
+      step = 2.0 * magnitude;
+    else
+      step = magnitude;
+  }
+
+  for (auto value = std::ceil(min / step) * step; value <= max + step * 1e-9; value += step) {
+    // Avoid labels like '1.38778e-17' for zero
+    values.emplace_back(std::abs(value) < step * 1e-9 ? 0.0 : value);
+  }
+
+  return values;
+}
+
+} // namespace
+
+namespace netsimulyzer {
+
+void GLChartView::followSeries() {
+  if (manualView || currentSeries == ChartManager::PlaceholderId)
+    return;
+
+  std::visit(
+      [this](const auto &tie) {
+        using T = std::decay_t<decltype(tie)>;
+
+        setRange(xAxis, tie.xRange);
+
+        // Category axes have a fixed range
+        if constexpr (!std::is_same_v<T, ChartManager::CategoryValueTie>)
+          setRange(yAxis, tie.yRange);
+      },
+      manager.getSeries(currentSeries));
+}
+
+void GLChartView::uploadSeries() {
+  for (const auto id : drawnSeries) {
+    auto &buffer = buffers[id];
+
+    std::visit(
+        [this, &buffer](const auto &tie) {
+          using T = std::decay_t<decltype(tie)>;
+
+          if constexpr (!std::is_same_v<T, ChartManager::SeriesCollectionTie>)
+            upload(buffer, tie);
+        },
+        manager.getSeries(id));
+  }
+}
+
+void GLChartView::upload(SeriesBuffer &buffer, const ChartManager::XYSeriesTie &tie) {
+  // Points in the store never change, so everything uploaded stays valid,
+  // even once rewound out of view
+  const auto end = tie.visible.end;
+  if (buffer.uploaded >= end)
+    return;
+
+  // Use the scale of the displayed axes, which belong to the collection
+  // when the series is shown as part of one
+  const auto xLog = xAxis.logarithmic;
+  const auto yLog = yAxis.logarithmic;
+
+  if (buffer.uploaded == 0u)
+    buffer.origin = {toAxis(tie.data.xAt(0u), xLog), toAxis(tie.data.yAt(0u), yLog)};
+
+  std::vector<glm::vec2> points;
+  points.reserve(end - buffer.uploaded);
+  for (auto i = buffer.uploaded; i < end; i++) {
+    points.emplace_back(toAxis(tie.data.xAt(i), xLog) - buffer.origin.x,
+                        toAxis(tie.data.yAt(i), yLog) - buffer.origin.y);
+  }
+
+  write(buffer, buffer.uploaded, points);
+}
+
+void GLChartView::upload(SeriesBuffer &buffer, const ChartManager::CategoryValueTie &tie) {
+  // Points removed by a rewind may be replaced by different ones,
+  // so start over
+  if (buffer.removedPoints != tie.removedPoints) {
+    buffer.removedPoints = tie.removedPoints;
+    buffer.uploaded = 0u;
+  }
+
+  const auto &values = tie.points;
+  const auto end = static_cast<std::size_t>(values.size());
+  if (buffer.uploaded >= end)
+    return;
+
+  const auto xLog = xAxis.logarithmic;
+  if (buffer.uploaded == 0u)
+    buffer.origin = {toAxis(values.front().x(), xLog), 0.0};
+
+  std::vector<glm::vec2> points;
+  points.reserve(end - buffer.uploaded);
+  for (auto i = buffer.uploaded; i < end; i++) {
+    const auto &value = values[static_cast<int>(i)];
+    points.emplace_back(toAxis(value.x(), xLog) - buffer.origin.x, value.y());
+  }
+
+  write(buffer, buffer.uploaded, points);
+}
+
+void GLChartView::write(SeriesBuffer &buffer, std::size_t offset, const std::vector<glm::vec2> &points) {
+  if (buffer.vao == 0u) {
+    glGenVertexArrays(1, &buffer.vao);
+    glBindVertexArray(buffer.vao);
+    glEnableVertexAttribArray(0);
+  } else
+    glBindVertexArray(buffer.vao);
+
+  const auto needed = offset + points.size();
+  if (needed > buffer.capacity) {
+    const auto capacity = std::max({needed, buffer.capacity * 2u, minimumCapacity});
+
+    unsigned int grown;
+    glGenBuffers(1, &grown);
+    glBindBuffer(GL_ARRAY_BUFFER, grown);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(capacity * sizeof(glm::vec2)), nullptr, GL_DYNAMIC_DRAW);
+
+    // Keep the points already written, without a trip through the CPU
+    if (offset > 0u) {
+      glBindBuffer(GL_COPY_READ_BUFFER, buffer.vbo);
+      glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_ARRAY_BUFFER, 0, 0,
+                          static_cast<GLsizeiptr>(offset * sizeof(glm::vec2)));
+      glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    }
+
+    glDeleteBuffers(1, &buffer.vbo);
+    buffer.vbo = grown;
+    buffer.capacity = capacity;
+
+    // Point the attribute at the new buffer
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2), nullptr);
+  } else
+    glBindBuffer(GL_ARRAY_BUFFER, buffer.vbo);
+
+  glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(offset * sizeof(glm::vec2)),
+                  static_cast<GLsizeiptr>(points.size() * sizeof(glm::vec2)), points.data());
+
+  glBindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  buffer.uploaded = needed;
+}
+
+void GLChartView::freeBuffers() {
+  for (auto &[id, buffer] : buffers) {
+    glDeleteBuffers(1, &buffer.vbo);
+    glDeleteVertexArrays(1, &buffer.vao);
+  }
+
+  buffers.clear();
+}
+
+void GLChartView::cleanup() {
+  if (!shader)
+    return;
+
+  makeCurrent();
+  freeBuffers();
+  shader.reset();
+  doneCurrent();
+}
+
+QRect GLChartView::plotArea() const {
+  const QFontMetrics metrics{font()};
+  const auto lineHeight = metrics.height();
+
+  // Keep the plot steady as the labels change
+  auto labelWidth = metrics.horizontalAdvance(QStringLiteral("-8.88888e+88"));
+  if (!yAxis.categories.empty()) {
+    labelWidth = 0;
+    for (const auto &[value, name] : yAxis.categories)
+      labelWidth = std::max(labelWidth, metrics.horizontalAdvance(name));
+  }
+
+  const auto left = padding + lineHeight + padding + labelWidth + tickLength;
+  const auto top = padding + lineHeight * 3 / 2 + padding;
+  const auto right = padding + labelWidth / 2;
+
+  // Tick labels, axis title & legend
+  const auto bottom = tickLength + lineHeight + padding + lineHeight + padding + lineHeight + padding;
+
+  return {left, top, std::max(1, width() - left - right), std::max(1, height() - top - bottom)};
+}
+
+glm::mat4 GLChartView::transform(const SeriesBuffer &buffer) const {
+  // Work in doubles, then only the small values
+  // relative to the view are converted
+  const auto xScale = 2.0 / (xAxis.max - xAxis.min);
+  const auto yScale = 2.0 / (yAxis.max - yAxis.min);
+
+  glm::mat4 matrix{1.0f};
+  matrix[0][0] = static_cast<float>(xScale);
+  matrix[1][1] = static_cast<float>(yScale);
+  matrix[3][0] = static_cast<float>((buffer.origin.x - xAxis.min) * xScale - 1.0);
+  matrix[3][1] = static_cast<float>((buffer.origin.y - yAxis.min) * yScale - 1.0);
+
+  return matrix;
+}
+
+void GLChartView::drawSeries(const QRect &area) {
+  // OpenGL counts from the bottom of the widget, in physical pixels
+  const auto ratio = devicePixelRatioF();
+  const auto x = static_cast<int>(area.x() * ratio);
+  const auto y = static_cast<int>((height() - area.y() - area.height()) * ratio);
+  const auto w = static_cast<int>(area.width() * ratio);
+  const auto h = static_cast<int>(area.height() * ratio);
+
+  glViewport(x, y, w, h);
+  glEnable(GL_SCISSOR_TEST);
+  glScissor(x, y, w, h);
+  glDisable(GL_DEPTH_TEST);
+  glDisable(GL_CULL_FACE);
+  glDisable(GL_BLEND);
+  glPointSize(pointSize * static_cast<float>(ratio));
+
+  shader->bind();
+  for (const auto id : drawnSeries) {
+    const auto &buffer = buffers[id];
+    if (buffer.uploaded == 0u)
+      continue;
+
+    std::size_t begin = 0u;
+    std::size_t end = buffer.uploaded;
+    GLenum mode = GL_LINE_STRIP;
+    parser::Ns3Color3 color;
+
+    const auto &s = manager.getSeries(id);
+    if (const auto xy = std::get_if<ChartManager::XYSeriesTie>(&s)) {
+      begin = xy->visible.begin;
+      end = std::min(end, xy->visible.end);
+      color = xy->model.color;
+
+      if (xy->model.connection == parser::XYSeries::Connection::None)
+        mode = GL_POINTS;
+    } else if (const auto category = std::get_if<ChartManager::CategoryValueTie>(&s))
+      color = category->model.color;
+
+    if (end <= begin)
+      continue;
+
+    shader->uniform("transform", transform(buffer));
+    shader->uniform("color", glm::vec3{color.red, color.green, color.blue} / 255.0f);
+
+    glBindVertexArray(buffer.vao);
+    glDrawArrays(mode, static_cast<GLint>(begin), static_cast<GLsizei>(end - begin));
+  }
+
+  glBindVertexArray(0);
+  shader->unbind();
+  glDisable(GL_SCISSOR_TEST);
+}
+
+void GLChartView::drawAxes(QPainter &painter, const QRect &area) {
+  const QFontMetrics metrics{painter.font()};
+  const auto lineHeight = metrics.height();
+  const auto gridColor = palette().color(QPalette::Midlight);
+  const auto textColor = palette().color(QPalette::Text);
+
+  const auto xPixel = [&area, this](double value) {
+    return area.left() + (value - xAxis.min) / (xAxis.max - xAxis.min) * area.width();
+  };
+  const auto yPixel = [&area, this](double value) {
+    return area.bottom() - (value - yAxis.min) / (yAxis.max - yAxis.min) * area.height();
+  };
+
+  // X Axis
+  for (const auto value : ticks(xAxis.min, xAxis.max, xAxis.logarithmic, std::max(1, area.width() / 100))) {
+    const auto x = xPixel(value);
+    painter.setPen(gridColor);
+    painter.drawLine(QPointF{x, static_cast<qreal>(area.top())}, QPointF{x, static_cast<qreal>(area.bottom())});
+
+    painter.setPen(textColor);
+    painter.drawLine(QPointF{x, static_cast<qreal>(area.bottom())},
+                     QPointF{x, static_cast<qreal>(area.bottom() + tickLength)});
+
+    const auto label = QString::number(fromAxis(value, xAxis.logarithmic), 'g', 6);
+    const QRectF labelRect{x - 100.0, static_cast<qreal>(area.bottom() + tickLength), 200.0,
+                           static_cast<qreal>(lineHeight)};
+    painter.drawText(labelRect, Qt::AlignHCenter | Qt::AlignTop, label);
+  }
+
+  // Y Axis
+  std::vector<std::pair<double, QString>> yLabels = yAxis.categories;
+  if (yLabels.empty()) {
+    for (const auto value : ticks(yAxis.min, yAxis.max, yAxis.logarithmic, std::max(1, area.height() / 50)))
+      yLabels.emplace_back(value, QString::number(fromAxis(value, yAxis.logarithmic), 'g', 6));
+  }
+
+  for (const auto &[value, label] : yLabels) {
+    if (value < yAxis.min || value > yAxis.max)
+      continue;
+
+    const auto y = yPixel(value);
+    painter.setPen(gridColor);
+    painter.drawLine(QPointF{static_cast<qreal>(area.left()), y}, QPointF{static_cast<qreal>(area.right()), y});
+
+    painter.setPen(textColor);
+    painter.drawLine(QPointF{static_cast<qreal>(area.left() - tickLength), y},
+                     QPointF{static_cast<qreal>(area.left()), y});
+
+    const QRectF labelRect{0.0, y - lineHeight, static_cast<qreal>(area.left() - tickLength - 2),
+                           static_cast<qreal>(lineHeight * 2)};
+    painter.drawText(labelRect, Qt::AlignRight | Qt::AlignVCenter, label);
+  }
+
+  painter.setPen(textColor);
+  painter.drawRect(area);
+
+  // Axis titles
+  const QRect xTitleRect{area.left(), area.bottom() + tickLength + lineHeight + padding, area.width(), lineHeight};
+  painter.drawText(xTitleRect, Qt::AlignCenter, xAxis.title);
+
+  painter.save();
+  painter.translate(padding, area.center().y());
+  painter.rotate(-90.0);
+  painter.drawText(QRect{-area.height() / 2, 0, area.height(), lineHeight}, Qt::AlignCenter, yAxis.title);
+  painter.restore();
+
+  // Chart title
+  auto titleFont = painter.font();
+  titleFont.setBold(true);
+  painter.save();
+  painter.setFont(titleFont);
+  painter.drawText(QRect{0, padding, width(), area.top() - padding * 2}, Qt::AlignCenter, title);
+  painter.restore();
+}
+
+void GLChartView::drawLegend(QPainter &painter, const QRect &area) {
+  const QFontMetrics metrics{painter.font()};
+  const auto lineHeight = metrics.height();
+  const auto swatchSize = lineHeight / 2;
+
+  std::vector<std::pair<QString, QColor>> entries;
+  for (const auto id : drawnSeries) {
+    std::visit(
+        [&entries](const auto &tie) {
+          using T = std::decay_t<decltype(tie)>;
+
+          if constexpr (!std::is_same_v<T, ChartManager::SeriesCollectionTie>) {
+            const auto &color = tie.model.color;
+            entries.emplace_back(QString::fromStdString(tie.model.legend),
+                                 QColor::fromRgb(color.red, color.green, color.blue));
+          }
+        },
+        manager.getSeries(id));
+  }
+
+  auto totalWidth = 0;
+  for (const auto &[name, color] : entries)
+    totalWidth += swatchSize + padding / 2 + metrics.horizontalAdvance(name) + padding * 2;
+
+  auto x = std::max(padding, area.center().x() - totalWidth / 2);
+  const auto y = area.bottom() + tickLength + (lineHeight + padding) * 2;
+
+  painter.setPen(palette().color(QPalette::Text));
+  for (const auto &[name, color] : entries) {
+    painter.fillRect(QRect{x, y + (lineHeight - swatchSize) / 2, swatchSize, swatchSize}, color);
+    x += swatchSize + padding / 2;
+
+    const auto nameWidth = metrics.horizontalAdvance(name);
+    painter.drawText(QRect{x, y, nameWidth, lineHeight}, Qt::AlignLeft | Qt::AlignVCenter, name);
+    x += nameWidth + padding * 2;
+  }
+}
+
+void GLChartView::zoom(double xFactor, double yFactor) {
+  manualView = true;
+
+  const auto xCenter = (xAxis.min + xAxis.max) / 2.0;
+  const auto xHalf = (xAxis.max - xAxis.min) / 2.0 / xFactor;
+  xAxis.min = xCenter - xHalf;
+  xAxis.max = xCenter + xHalf;
+
+  const auto yCenter = (yAxis.min + yAxis.max) / 2.0;
+  const auto yHalf = (yAxis.max - yAxis.min) / 2.0 / yFactor;
+  yAxis.min = yCenter - yHalf;
+  yAxis.max = yCenter + yHalf;
+
+  update();
+}
+
+void GLChartView::moveView(double dx, double dy) {
+  manualView = true;
+
+  const auto area = plotArea();
+  const auto xShift = dx / area.width() * (xAxis.max - xAxis.min);
+  const auto yShift = dy / area.height() * (yAxis.max - yAxis.min);
+
+  xAxis.min += xShift;
+  xAxis.max += xShift;
+  yAxis.min += yShift;
+  yAxis.max += yShift;
+
+  update();
+}
+
+void GLChartView::resetView() {
+  manualView = false;
+
+  // Category axes are not followed, so restore them here
+  if (!yAxis.categories.empty()) {
+    yAxis.min = yAxis.categories.front().first - 0.1;
+    yAxis.max = yAxis.categories.back().first + 0.1;
+  }
+
+  followSeries();
+  update();
+}
+
+void GLChartView::initializeGL() {
+  if (!initializeOpenGLFunctions()) {
+    std::cerr << "Failed OpenGL functions\n";
+    std::abort();
+  }
+
+  // The context is replaced when the widget moves to another window,
+  // e.g. when the dock is floated, so rebuild everything then
+  QObject::connect(context(), &QOpenGLContext::aboutToBeDestroyed, this, &GLChartView::cleanup);
+
+  QFile vertexFile{":shader/shaders/chart.vert"};
+  if (!vertexFile.open(QFile::ReadOnly | QFile::Text)) {
+    QMessageBox::critical(nullptr, "Failed to open shader file", "Failed to open shader file chart.vert");
+    std::abort();
+  }
+  const auto vertexSrc = QTextStream{&vertexFile}.readAll().toStdString();
+
+  QFile fragmentFile{":shader/shaders/chart.frag"};
+  if (!fragmentFile.open(QFile::ReadOnly | QFile::Text)) {
+    QMessageBox::critical(nullptr, "Failed to open shader file", "Failed to open shader file chart.frag");
+    std::abort();
+  }
+  const auto fragmentSrc = QTextStream{&fragmentFile}.readAll().toStdString();
+
+  shader = std::make_unique<Shader>();
+  shader->init(vertexSrc, fragmentSrc);
+}
+
+void GLChartView::paintGL() {
+  followSeries();
+
+  QPainter painter{this};
+  painter.fillRect(rect(), palette().color(QPalette::Base));
+
+  if (currentSeries == ChartManager::PlaceholderId)
+    return;
+
+  const auto area = plotArea();
+  drawAxes(painter, area);
+
+  painter.beginNativePainting();
+  uploadSeries();
+  drawSeries(area);
+  painter.endNativePainting();
+
+  drawLegend(painter, area);
+}
+
+void GLChartView::keyPressEvent(QKeyEvent *event) {
+  const auto ctrl = event->modifiers() & Qt::KeyboardModifier::ControlModifier;
+  const auto alt = event->modifiers() & Qt::KeyboardModifier::AltModifier;
+
+  switch (event->key()) {
+  case Qt::Key_Plus:
+    [[fallthrough]];
+  case Qt::Key_Equal: // Allow the + key next to Backspace to be used (without Shift)
+    if (ctrl) // Horizontal zoom
+      zoom(zoomFactor, 1.0);
+    else if (alt) // Vertical Zoom
+      zoom(1.0, zoomFactor);
+    else // Horizontal & Vertical zoom
+      zoom(zoomFactor, zoomFactor);
+    break;
+  case Qt::Key_Minus:
+    if (ctrl) // Horizontal zoom
+      zoom(1.0 / zoomFactor, 1.0);
+    else if (alt) // Vertical Zoom
+      zoom(1.0, 1.0 / zoomFactor);
+    else // Horizontal & Vertical zoom
+      zoom(1.0 / zoomFactor, 1.0 / zoomFactor);
+    break;
+  case Qt::Key_R:
+    resetView();
+    break;
+  case Qt::Key_Left:
+    moveView(-scrollMagnitude, 0.0);
+    break;
+  case Qt::Key_Right:
+    moveView(scrollMagnitude, 0.0);
+    break;
+  case Qt::Key_Up:
+    moveView(0.0, scrollMagnitude);
+    break;
+  case Qt::Key_Down:
+    moveView(0.0, -scrollMagnitude);
+    break;
+  default:
+    QOpenGLWidget::keyPressEvent(event);
+    break;
+  }
+}
+
+void GLChartView::mousePressEvent(QMouseEvent *event) {
+  QOpenGLWidget::mousePressEvent(event);
+
+  // Only allow moves with Left Mouse
+  if (!(event->buttons() & Qt::LeftButton))
+    return;
+
+  mouseDown = true;
+  lastMousePosition = event->pos();
+}
+
+void GLChartView::mouseMoveEvent(QMouseEvent *event) {
+  QOpenGLWidget::mouseMoveEvent(event);
+  if (!mouseDown)
+    return;
+
+  const auto delta = lastMousePosition - event->pos();
+
+  // Invert delta Y otherwise the movement on the Y axis will
+  // be inverted relative to mouse movements
+  moveView(delta.x(), -delta.y());
+  lastMousePosition = event->pos();
+}
+
+void GLChartView::mouseReleaseEvent(QMouseEvent *event) {
+  QOpenGLWidget::mouseReleaseEvent(event);
+
+  // If the event was fired but LeftMouse is still down
+  if (event->buttons() & Qt::LeftButton)
+    return;
+
+  mouseDown = false;
+}
+
+void GLChartView::wheelEvent(QWheelEvent *event) {
+  const auto delta = event->angleDelta().y();
+  if (delta == 0) {
+    QOpenGLWidget::wheelEvent(event);
+    return;
+  }
+
+  const auto ctrl = event->modifiers() & Qt::KeyboardModifier::ControlModifier;
+  const auto alt = event->modifiers() & Qt::KeyboardModifier::AltModifier;
+  const auto factor = delta > 0 ? zoomFactor : 1.0 / zoomFactor;
+
+  if (ctrl) // Horizontal zoom
+    zoom(factor, 1.0);
+  else if (alt) // Vertical Zoom
+    zoom(1.0, factor);
+  else // Horizontal & Vertical zoom
+    zoom(factor, factor);
+
+  event->accept();
+}
+
+void GLChartView::contextMenuEvent(QContextMenuEvent *event) {
+  QMenu menu;
+  menu.addAction("Save Chart Image", [this]() {
+    const auto image = grabFramebuffer();
+    const auto fileName = QFileDialog::getSaveFileName(this, "Save Chart Image", "", "Images (*.png *.jpeg)");
+    if (fileName.isEmpty()) {
+      return;
+    }
+    image.save(fileName);
+  });
+
+  menu.addAction("Copy Chart Image to Clipboard", [this]() {
+    const auto image = grabFramebuffer();
+    auto clipboard = QGuiApplication::clipboard();
+    clipboard->setImage(image);
+  });
+
+  menu.exec(event->globalPos());
+}
+
+GLChartView::GLChartView(QWidget *parent, ChartManager &manager) : QOpenGLWidget(parent), manager(manager) {
+  setFocusPolicy(Qt::StrongFocus);
+
+  // New points are uploaded the next time the chart is drawn
+  QObject::connect(&manager, &ChartManager::seriesChanged, this, [this]() {
+    if (!drawnSeries.empty())
+      update();
+  });
+}
+
+GLChartView::~GLChartView() {
+  cleanup();
+}
+
+void GLChartView::showSeries(unsigned int id) {
+  clear();
+  if (id == ChartManager::PlaceholderId)
+    return;
+
+  currentSeries = id;
+  const auto makeAxis = [](const parser::ValueAxis &model) {
+    Axis axis;
+    axis.title = QString::fromStdString(model.name);
+    axis.logarithmic = model.scale == parser::ValueAxis::Scale::Logarithmic;
+    return axis;
+  };
+
+  const auto &s = manager.getSeries(id);
+  if (const auto xy = std::get_if<ChartManager::XYSeriesTie>(&s)) {
+    title = QString::fromStdString(xy->model.name);
+    xAxis = makeAxis(xy->model.xAxis);
+    yAxis = makeAxis(xy->model.yAxis);
+    drawnSeries.emplace_back(id);
+  } else if (const auto collection = std::get_if<ChartManager::SeriesCollectionTie>(&s)) {
+    title = QString::fromStdString(collection->model.name);
+    xAxis = makeAxis(collection->model.xAxis);
+    yAxis = makeAxis(collection->model.yAxis);
+
+    for (const auto seriesId : collection->model.series) {
+      if (std::holds_alternative<ChartManager::XYSeriesTie>(manager.getSeries(seriesId)))
+        drawnSeries.emplace_back(seriesId);
+    }
+  } else if (const auto category = std::get_if<ChartManager::CategoryValueTie>(&s)) {
+    title = QString::fromStdString(category->model.name);
+    xAxis = makeAxis(category->model.xAxis);
+
+    yAxis.title = QString::fromStdString(category->model.yAxis.name);
+    for (const auto &value : category->model.yAxis.values)
+      yAxis.categories.emplace_back(static_cast<double>(value.id), QString::fromStdString(value.name));
+
+    // Give slight padding before/after the min/max values
+    if (!yAxis.categories.empty()) {
+      yAxis.min = yAxis.categories.front().first - 0.1;
+      yAxis.max = yAxis.categories.back().first + 0.1;
+    }
+    drawnSeries.emplace_back(id);
+  }
+
+  followSeries();
+  update();
+}
+
+void GLChartView::clear() {
+  if (!buffers.empty()) {
+    makeCurrent();
+    freeBuffers();
+    doneCurrent();
+  }
+
+  currentSeries = ChartManager::PlaceholderId;
+  drawnSeries.clear();
+  title.clear();
+  xAxis = {};
+  yAxis = {};
+  manualView = false;
+  update();
+}
+
+} // namespace netsimulyzer
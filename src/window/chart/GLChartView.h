@@ -0,0 +1,275 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+
+#include "ChartManager.h"
+#include "src/render/shader/Shader.h"
+#include <QContextMenuEvent>
+#include <QKeyEvent>
+#include <QMouseEvent>
+#include <QOpenGLFunctions_3_3_Core>
+#include <QOpenGLWidget>
+#include <QPainter>
+#include <QPoint>
+#include <QRect>
+#include <QString>
+#include <QWheelEvent>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <memory>
+#include <model.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace netsimulyzer {
+
+/**
+ * Chart view which draws series straight from GPU vertex buffers.
+ *
+ * Points are uploaded once, as they become visible, and the
+ * view is zoomed & moved by changing the transform uniform.
+ * Axes, labels & the legend are painted over the plot with `QPainter`.
+ *
+ * Has the same controls as `ControlsChartView`
+ */
+class GLChartView : public QOpenGLWidget, protected QOpenGLFunctions_3_3_Core {
+  Q_OBJECT
+
+  /**
+   * A displayed axis, with values in axis space.
+   * For logarithmic axes, axis space is the base 10 log of the value
+   */
+  struct Axis {
+    QString title;
+    bool logarithmic{false};
+
+    /**
+     * The values & names of a category axis.
+     * Empty for value axes
+     */
+    std::vector<std::pair<double, QString>> categories;
+
+    double min{0.0};
+    double max{1.0};
+  };
+
+  /**
+   * The GPU copy of the points of a series
+   */
+  struct SeriesBuffer {
+    unsigned int vao{0u};
+    unsigned int vbo{0u};
+
+    /**
+     * The number of points `vbo` has room for
+     */
+    std::size_t capacity{0u};
+
+    /**
+     * The number of points written to `vbo`
+     */
+    std::size_t uploaded{0u};
+
+    /**
+     * Subtracted from each point before it is converted to a float,
+     * so large values keep their precision
+     */
+    glm::dvec2 origin{0.0};
+
+    /**
+     * The `removedPoints` of the Category Value series when last uploaded
+     */
+    std::size_t removedPoints{0u};
+  };
+
+  ChartManager &manager;
+  std::unique_ptr<Shader> shader;
+
+  /**
+   * The ID of the series, or collection, selected for display
+   */
+  unsigned int currentSeries{ChartManager::PlaceholderId};
+
+  /**
+   * The IDs of the XY & Category Value series drawn.
+   * The selected series, or the members of the selected collection
+   */
+  std::vector<unsigned int> drawnSeries;
+  std::unordered_map<unsigned int, SeriesBuffer> buffers;
+
+  QString title;
+  Axis xAxis;
+  Axis yAxis;
+
+  /**
+   * Flag indicating the user moved or zoomed the chart.
+   * Until then, the axes follow the range of the series
+   */
+  bool manualView{false};
+
+  /**
+   * Flag that tracks if the left mouse button is down
+   */
+  bool mouseDown{false};
+
+  /**
+   * Last tracked position of the mouse cursor.
+   * Only relevant while the mouse is down
+   */
+  QPoint lastMousePosition;
+
+  /**
+   * The amount to scale the graph when zooming
+   */
+  const double zoomFactor = 2.0;
+
+  /**
+   * The amount to move the chart scrolling, in pixels
+   */
+  const double scrollMagnitude = 10.0;
+
+  /**
+   * Set the axis ranges to the ranges of the selected series
+   */
+  void followSeries();
+
+  /**
+   * Copy the newly visible points of each drawn series to its buffer
+   */
+  void uploadSeries();
+  void upload(SeriesBuffer &buffer, const ChartManager::XYSeriesTie &tie);
+  void upload(SeriesBuffer &buffer, const ChartManager::CategoryValueTie &tie);
+
+  /**
+   * Write `points` to `buffer` starting at point `offset`,
+   * growing it if necessary
+   *
+   * @param buffer
+   * The buffer to write to
+   *
+   * @param offset
+   * The index of the first point to write
+   *
+   * @param points
+   * The points to write, already in axis space & relative to `buffer.origin`
+   */
+  void write(SeriesBuffer &buffer, std::size_t offset, const std::vector<glm::vec2> &points);
+
+  /**
+   * Delete the buffers of every series.
+   * The context must be current
+   */
+  void freeBuffers();
+
+  /**
+   * Delete every OpenGL object, before the context is destroyed
+   */
+  void cleanup();
+
+  /**
+   * @return
+   * The area the series are drawn in, in widget coordinates
+   */
+  [[nodiscard]] QRect plotArea() const;
+
+  /**
+   * Build the matrix from the points in `buffer` to clip space
+   *
+   * @param buffer
+   * The buffer about to be drawn
+   */
+  [[nodiscard]] glm::mat4 transform(const SeriesBuffer &buffer) const;
+
+  void drawSeries(const QRect &area);
+  void drawAxes(QPainter &painter, const QRect &area);
+  void drawLegend(QPainter &painter, const QRect &area);
+
+  /**
+   * Zoom both axes about the center of the plot
+   *
+   * @param xFactor
+   * The amount to scale the X axis. Values above 1 zoom in
+   *
+   * @param yFactor
+   * The amount to scale the Y axis. Values above 1 zoom in
+   */
+  void zoom(double xFactor, double yFactor);
+
+  /**
+   * Move the view by a number of pixels
+   *
+   * @param dx
+   * Pixels to move right
+   *
+   * @param dy
+   * Pixels to move up
+   */
+  void moveView(double dx, double dy);
+
+  /**
+   * Follow the series ranges again, after a manual zoom or move
+   */
+  void resetView();
+
+protected:
+  void initializeGL() override;
+  void paintGL() override;
+  void keyPressEvent(QKeyEvent *event) override;
+  void mousePressEvent(QMouseEvent *event) override;
+  void mouseMoveEvent(QMouseEvent *event) override;
+  void mouseReleaseEvent(QMouseEvent *event) override;
+  void wheelEvent(QWheelEvent *event) override;
+  void contextMenuEvent(QContextMenuEvent *event) override;
+
+public:
+  GLChartView(QWidget *parent, ChartManager &manager);
+  ~GLChartView() override;
+
+  /**
+   * Display the series or collection identified by `id`.
+   * Replaces any displayed series
+   *
+   * @param id
+   * The ID of the series to show
+   */
+  void showSeries(unsigned int id);
+
+  /**
+   * Remove the displayed series, and free its buffers
+   */
+  void clear();
+};
+
+} // namespace netsimulyzer
@@ -0,0 +1,152 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#include "QuantileSketch.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/**
+ * Magnitudes at or below this are counted as zero,
+ * rather than given a bucket of their own
+ */
+const auto minimumMagnitude = 1e-12;
+
+} // namespace
+
+namespace netsimulyzer {
+
+void QuantileSketch::Buckets::add(int key) {
+  if (counts.empty()) {
+    offset = key;
+    counts.emplace_back(0u);
+  } else if (key < offset) {
+    counts.insert(counts.begin(), static_cast<std::size_t>(offset - key), 0u);
+    offset = key;
+  } else if (key >= offset + static_cast<int>(counts.size()))
+    counts.resize(static_cast<std::size_t>(key - offset + 1), 0u);
+
+  counts[static_cast<std::size_t>(key - offset)]++;
+}
+
+void QuantileSketch::Buckets::remove(int key) {
+  const auto index = key - offset;
+  if (index < 0 || index >= static_cast<int>(counts.size()) || counts[static_cast<std::size_t>(index)] == 0u)
+    return;
+
+  counts[static_cast<std::size_t>(index)]--;
+}
+
+int QuantileSketch::key(double magnitude) const {
+  return static_cast<int>(std::ceil(std::log(magnitude) / logGamma));
+}
+
+double QuantileSketch::value(int key) const {
+  // The middle of the bucket, relative to its bounds
+  return 2.0 * std::pow(gamma, key) / (gamma + 1.0);
+}
+
+QuantileSketch::QuantileSketch(double relativeAccuracy)
+    : gamma((1.0 + relativeAccuracy) / (1.0 - relativeAccuracy)), logGamma(std::log(gamma)) {
+}
+
+void QuantileSketch::add(double value) {
+  // An infinity has no bucket & NaN would be counted as zero
+  if (!std::isfinite(value))
+    return;
+
+  if (value > minimumMagnitude)
+    positive.add(key(value));
+  else if (value < -minimumMagnitude)
+    negative.add(key(-value));
+  else
+    zeroCount++;
+
+  total++;
+}
+
+void QuantileSketch::remove(double value) {
+  if (total == 0u || !std::isfinite(value))
+    return;
+
+  if (value > minimumMagnitude)
+    positive.remove(key(value));
+  else if (value < -minimumMagnitude)
+    negative.remove(key(-value));
+  else if (zeroCount > 0u)
+    zeroCount--;
+
+  total--;
+}
+
+void QuantileSketch::clear() {
+  positive = {};
+  negative = {};
+  zeroCount = 0u;
+  total = 0u;
+}
+
+double QuantileSketch::quantile(double q) const {
+  if (total == 0u)
+    return 0.0;
+
+  const auto rank = static_cast<std::uint64_t>(std::clamp(q, 0.0, 1.0) * static_cast<double>(total - 1u));
+  std::uint64_t seen = 0u;
+
+  // Largest negative magnitudes are the smallest values
+  for (auto i = negative.counts.size(); i > 0u; i--) {
+    seen += negative.counts[i - 1u];
+    if (seen > rank)
+      return -value(negative.offset + static_cast<int>(i - 1u));
+  }
+
+  seen += zeroCount;
+  if (seen > rank)
+    return 0.0;
+
+  for (std::size_t i = 0u; i < positive.counts.size(); i++) {
+    seen += positive.counts[i];
+    if (seen > rank)
+      return value(positive.offset + static_cast<int>(i));
+  }
+
+  // Only reached if counts were lost, return the largest bucket
+  return positive.counts.empty() ? 0.0 : value(positive.offset + static_cast<int>(positive.counts.size() - 1u));
+}
+
+std::uint64_t QuantileSketch::count() const {
+  return total;
+}
+
+} // namespace netsimulyzer
@@ -0,0 +1,125 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace netsimulyzer {
+
+/**
+ * Streaming quantile estimate with a bounded relative error.
+ *
+ * Values are counted in logarithmically sized buckets
+ * (as in DDSketch), so any quantile is within `relativeAccuracy`
+ * of the true value. Unlike most sketches, values may be removed,
+ * which lets the sketch follow a sliding window.
+ */
+class QuantileSketch {
+  /**
+   * Counts for a contiguous range of bucket keys, grown as needed
+   */
+  struct Buckets {
+    int offset{0};
+    std::vector<std::uint64_t> counts;
+
+    void add(int key);
+    void remove(int key);
+  };
+
+  double gamma;
+  double logGamma;
+
+  /**
+   * Buckets for the magnitude of positive & negative values.
+   * Values too close to zero to be bucketed are counted in `zeroCount`
+   */
+  Buckets positive;
+  Buckets negative;
+  std::uint64_t zeroCount{0u};
+  std::uint64_t total{0u};
+
+  [[nodiscard]] int key(double magnitude) const;
+
+  /**
+   * @param key
+   * A bucket key
+   *
+   * @return
+   * The value all values in the bucket `key` are estimated as
+   */
+  [[nodiscard]] double value(int key) const;
+
+public:
+  /**
+   * @param relativeAccuracy
+   * The largest relative error of a returned quantile, in (0, 1)
+   */
+  explicit QuantileSketch(double relativeAccuracy = 0.01);
+
+  /**
+   * Add a value to the sketch. Non-finite values are ignored
+   *
+   * @param value
+   * The value to add
+   */
+  void add(double value);
+
+  /**
+   * Remove a value previously passed to `add()`
+   *
+   * @param value
+   * The value to remove
+   */
+  void remove(double value);
+
+  /**
+   * Remove every value
+   */
+  void clear();
+
+  /**
+   * @param q
+   * The quantile to estimate, in [0, 1]
+   *
+   * @return
+   * The estimated value at `q`, or 0 if the sketch is empty
+   */
+  [[nodiscard]] double quantile(double q) const;
+
+  [[nodiscard]] std::uint64_t count() const;
+};
+
+} // namespace netsimulyzer
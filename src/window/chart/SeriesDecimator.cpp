@@ -0,0 +1,300 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#include "SeriesDecimator.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace netsimulyzer {
+
+bool SeriesDecimator::View::operator==(const SeriesDecimator::View &other) const {
+  return min == other.min && max == other.max && columns == other.columns && logarithmic == other.logarithmic;
+}
+
+bool SeriesDecimator::View::operator!=(const SeriesDecimator::View &other) const {
+  return !(*this == other);
+}
+
+double SeriesDecimator::position(double x) const {
+  if (view->logarithmic)
+    return (std::log10(x) - std::log10(view->min)) / (std::log10(view->max) - std::log10(view->min));
+
+  return (x - view->min) / (view->max - view->min);
+}
+
+bool SeriesDecimator::foldColumns(const SeriesStore &store) {
+  auto changed = false;
+
+  for (; processed < range.end; processed++) {
+    // The X values are sorted, so once we're past
+    // the visible range, every remaining point is too
+    if (after != npos) {
+      processed = range.end;
+      break;
+    }
+
+    const auto x = store.xAt(processed);
+    changed = true;
+
+    if (x < view->min) {
+      before = processed;
+      continue;
+    }
+    if (x > view->max) {
+      after = processed;
+      continue;
+    }
+
+    const auto index = std::min(static_cast<std::size_t>(position(x) * static_cast<double>(columns.size())),
+                                columns.size() - 1u);
+    auto &column = columns[index];
+
+    if (column.first == npos) {
+      column.first = column.last = column.min = column.max = processed;
+      continue;
+    }
+
+    const auto y = store.yAt(processed);
+    column.last = processed;
+    if (y < store.yAt(column.min))
+      column.min = processed;
+    if (y > store.yAt(column.max))
+      column.max = processed;
+  }
+
+  return changed;
+}
+
+bool SeriesDecimator::buildMinMax(const SeriesStore &store) {
+  auto changed = false;
+
+  if (invalid) {
+    columns.assign(static_cast<std::size_t>(view->columns), Column{});
+    before = npos;
+    after = npos;
+
+    // Skip straight to the visible range
+    processed = store.lowerBoundX(view->min, range);
+    if (processed > range.begin)
+      before = processed - 1u;
+
+    invalid = false;
+    changed = true;
+  }
+
+  changed |= foldColumns(store);
+  if (!changed)
+    return false;
+
+  reduced.clear();
+  reduced.reserve(static_cast<int>(columns.size() * 4u + 2u));
+
+  if (before != npos)
+    reduced.append({store.xAt(before), store.yAt(before)});
+
+  for (const auto &column : columns) {
+    if (column.first == npos)
+      continue;
+
+    // Keep the entry & exit points as well as the extremes,
+    // so the line still connects to the neighbouring columns.
+    // Emit them in series order, without duplicates
+    std::array<std::size_t, 4> indices{column.first, column.min, column.max, column.last};
+    std::sort(indices.begin(), indices.end());
+    const auto end = std::unique(indices.begin(), indices.end());
+
+    for (auto i = indices.begin(); i != end; i++)
+      reduced.append({store.xAt(*i), store.yAt(*i)});
+  }
+
+  if (after != npos)
+    reduced.append({store.xAt(after), store.yAt(after)});
+
+  return true;
+}
+
+bool SeriesDecimator::buildLargestTriangle(const SeriesStore &store) {
+  // Points appended after the visible range do not change anything
+  if (!invalid && after != npos)
+    return false;
+
+  // The buckets shift with each appended point,
+  // so there is nothing to fold. Recalculate the visible range
+  const auto begin = store.lowerBoundX(view->min, range);
+  const auto end = store.upperBoundX(view->max, {begin, range.end});
+  const auto count = end - begin;
+  const auto threshold = std::max(std::size_t{3u}, static_cast<std::size_t>(view->columns) * 2u);
+
+  before = begin > range.begin ? begin - 1u : npos;
+  after = end < range.end ? end : npos;
+  invalid = false;
+
+  reduced.clear();
+  reduced.reserve(static_cast<int>(std::min(count, threshold) + 2u));
+
+  if (before != npos)
+    reduced.append({store.xAt(before), store.yAt(before)});
+
+  if (count <= threshold) {
+    for (auto i = begin; i < end; i++)
+      reduced.append({store.xAt(i), store.yAt(i)});
+  } else {
+    // The first & last points are always kept,
+    // the rest are split into `threshold - 2` buckets
+    const auto bucketSize = static_cast<double>(count - 2u) / static_cast<double>(threshold - 2u);
+    auto bucketStart = [begin, bucketSize](std::size_t bucket) {
+      return begin + 1u + static_cast<std::size_t>(static_cast<double>(bucket) * bucketSize);
+    };
+
+    auto selected = begin;
+    reduced.append({store.xAt(selected), store.yAt(selected)});
+
+    for (auto bucket = 0u; bucket < threshold - 2u; bucket++) {
+      const auto first = bucketStart(bucket);
+      const auto last = std::min(bucketStart(bucket + 1u), end - 1u);
+
+      // Average of the next bucket, which is only the final point for the last bucket
+      const auto nextFirst = last;
+      const auto nextLast = std::min(bucketStart(bucket + 2u), end);
+      auto averageX = 0.0;
+      auto averageY = 0.0;
+      for (auto i = nextFirst; i < nextLast; i++) {
+        averageX += position(store.xAt(i));
+        averageY += store.yAt(i);
+      }
+      const auto nextCount = static_cast<double>(std::max(nextLast - nextFirst, std::size_t{1u}));
+      averageX /= nextCount;
+      averageY /= nextCount;
+
+      // Keep the point forming the largest triangle
+      // with the previous selection & the next average
+      const auto selectedX = position(store.xAt(selected));
+      const auto selectedY = store.yAt(selected);
+      auto largestArea = -1.0;
+      auto largest = first;
+      for (auto i = first; i < last; i++) {
+        const auto area = std::abs((selectedX - averageX) * (store.yAt(i) - selectedY) -
+                                   (selectedX - position(store.xAt(i))) * (averageY - selectedY));
+        if (area > largestArea) {
+          largestArea = area;
+          largest = i;
+        }
+      }
+
+      selected = largest;
+      reduced.append({store.xAt(selected), store.yAt(selected)});
+    }
+
+    reduced.append({store.xAt(end - 1u), store.yAt(end - 1u)});
+  }
+
+  if (after != npos)
+    reduced.append({store.xAt(after), store.yAt(after)});
+
+  return true;
+}
+
+SeriesDecimator::SeriesDecimator(SeriesDecimator::Method method) : method(method) {
+}
+
+void SeriesDecimator::setMethod(SeriesDecimator::Method value) {
+  if (method == value)
+    return;
+
+  method = value;
+  invalidate();
+}
+
+void SeriesDecimator::setView(const SeriesDecimator::View &value) {
+  if (view && *view == value)
+    return;
+
+  view = value;
+  invalidate();
+}
+
+void SeriesDecimator::clearView() {
+  view.reset();
+  columns.clear();
+  columns.shrink_to_fit();
+  reduced.clear();
+  reduced.squeeze();
+  invalidate();
+}
+
+bool SeriesDecimator::hasView() const {
+  return view.has_value();
+}
+
+void SeriesDecimator::invalidate() {
+  invalid = true;
+  processed = 0u;
+}
+
+bool SeriesDecimator::update(const SeriesStore &store, SeriesStore::Range visible) {
+  if (!view)
+    return false;
+
+  if (!invalid && visible == range)
+    return false;
+
+  // Points may only be folded in, not taken back out
+  if (visible.begin != range.begin || visible.end < range.end)
+    invalidate();
+  range = visible;
+
+  // Pass everything through if the points
+  // cannot be bucketed by their X values
+  if (!store.isSortedX(range) || view->columns < 1 || !(view->max > view->min) ||
+      (view->logarithmic && view->min <= 0.0)) {
+    reduced = store.points(range);
+    invalid = false;
+    return true;
+  }
+
+  switch (method) {
+  case Method::MinMax:
+    return buildMinMax(store);
+  case Method::LargestTriangleThreeBuckets:
+    return buildLargestTriangle(store);
+  }
+
+  return false;
+}
+
+const QVector<QPointF> &SeriesDecimator::points() const {
+  return reduced;
+}
+
+} // namespace netsimulyzer
@@ -0,0 +1,241 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+
+#include "SeriesStore.h"
+#include <QPointF>
+#include <QVector>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <src/settings/SettingsManager.h>
+#include <vector>
+
+namespace netsimulyzer {
+
+/**
+ * Reduces the visible range of a `SeriesStore` to
+ * the points that are actually distinguishable on screen.
+ *
+ * The reduction depends on the visible X range & the
+ * number of pixel columns the plot area spans,
+ * so it is recalculated when the view changes.
+ * Points appended to the store are folded into the
+ * existing reduction where the method allows.
+ *
+ * Stores with unsorted X values are not reduced,
+ * since neither method may be applied to them.
+ */
+class SeriesDecimator {
+public:
+  using Method = SettingsManager::ChartDecimation;
+
+  /**
+   * The part of the series shown by a chart
+   */
+  struct View {
+    /**
+     * The lowest visible X value
+     */
+    double min;
+
+    /**
+     * The highest visible X value
+     */
+    double max;
+
+    /**
+     * The number of pixel columns the plot area spans
+     */
+    int columns;
+
+    /**
+     * If the X axis is a log scale, columns are spaced logarithmically
+     */
+    bool logarithmic;
+
+    bool operator==(const View &other) const;
+    bool operator!=(const View &other) const;
+  };
+
+private:
+  constexpr static auto npos = std::numeric_limits<std::size_t>::max();
+
+  /**
+   * The indices of the notable points in one pixel column
+   */
+  struct Column {
+    std::size_t first{npos};
+    std::size_t last{npos};
+    std::size_t min{npos};
+    std::size_t max{npos};
+  };
+
+  Method method;
+  std::optional<View> view;
+
+  /**
+   * Per-column summary of the visible points.
+   * Only used by the `MinMax` method
+   */
+  std::vector<Column> columns;
+
+  /**
+   * The last point before the visible range.
+   * Kept so lines run off the edge of the plot
+   */
+  std::size_t before{npos};
+
+  /**
+   * The first point after the visible range.
+   * Kept so lines run off the edge of the plot
+   */
+  std::size_t after{npos};
+
+  /**
+   * The range of store points `reduced` is built from
+   */
+  SeriesStore::Range range;
+
+  /**
+   * The index of the next point in `range` to fold into `columns`
+   */
+  std::size_t processed{0u};
+
+  /**
+   * Flag indicating `reduced` must be rebuilt from scratch
+   */
+  bool invalid{true};
+
+  QVector<QPointF> reduced;
+
+  /**
+   * Convert an X value to its position across the plot area
+   *
+   * @param x
+   * The X value to convert
+   *
+   * @return
+   * The position, where 0 is the left edge & 1 is the right
+   */
+  [[nodiscard]] double position(double x) const;
+
+  /**
+   * Fold the points [processed, range.end) into `columns`
+   *
+   * @return
+   * True if any of the points were visible
+   */
+  bool foldColumns(const SeriesStore &store);
+
+  /**
+   * Bring `reduced` up to date by keeping the first, last,
+   * lowest & highest point of each pixel column
+   *
+   * @return
+   * True if `reduced` changed
+   */
+  bool buildMinMax(const SeriesStore &store);
+
+  /**
+   * Bring `reduced` up to date using Largest-Triangle-Three-Buckets,
+   * with two buckets per pixel column
+   *
+   * @return
+   * True if `reduced` changed
+   */
+  bool buildLargestTriangle(const SeriesStore &store);
+
+public:
+  explicit SeriesDecimator(Method method);
+
+  /**
+   * Change the reduction method.
+   * Forces a rebuild on the next `update()`
+   *
+   * @param value
+   * The new method to use
+   */
+  void setMethod(Method value);
+
+  /**
+   * Set the part of the series that is visible.
+   * A different view forces a rebuild on the next `update()`
+   *
+   * @param value
+   * The new visible part of the series
+   */
+  void setView(const View &value);
+
+  /**
+   * Stop reducing the series, and free the reduced points.
+   * `update()` does nothing until a new view is set
+   */
+  void clearView();
+
+  /**
+   * @return
+   * True if a view is set, meaning the series is being displayed
+   */
+  [[nodiscard]] bool hasView() const;
+
+  /**
+   * Forces a rebuild on the next `update()`
+   */
+  void invalidate();
+
+  /**
+   * Bring the reduced points up to date with the `visible` points of `store`.
+   * If `visible` only grew at its end, the new points are folded into
+   * the existing reduction where the method allows
+   *
+   * @param store
+   * The full resolution points of the series
+   *
+   * @param visible
+   * The points of `store` currently shown
+   *
+   * @return
+   * True if the reduced points changed
+   */
+  bool update(const SeriesStore &store, SeriesStore::Range visible);
+
+  /**
+   * @return
+   * The reduced points as of the last `update()`
+   */
+  [[nodiscard]] const QVector<QPointF> &points() const;
+};
+
+} // namespace netsimulyzer
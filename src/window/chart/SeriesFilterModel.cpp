@@ -0,0 +1,118 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#include "SeriesFilterModel.h"
+#include <algorithm>
+
+namespace netsimulyzer {
+
+void SeriesFilterModel::refresh() {
+  matched.assign(model.entryCount(), false);
+  matches.clear();
+
+  if (!query.isEmpty()) {
+    matches = model.search(query);
+    for (const auto entry : matches)
+      matched[entry] = true;
+  }
+
+  invalidateFilter();
+}
+
+bool SeriesFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const {
+  if (query.isEmpty())
+    return true;
+
+  // Groups & the placeholder are only kept if
+  // they have a matching child, see `recursiveFilteringEnabled`
+  const auto entry = model.entryAt(model.index(sourceRow, 0, sourceParent));
+
+  // The model may be reset before `refresh()` runs
+  if (entry < 0 || static_cast<std::size_t>(entry) >= matched.size())
+    return false;
+
+  return matched[static_cast<std::size_t>(entry)];
+}
+
+SeriesFilterModel::SeriesFilterModel(QObject *parent, SeriesPickerModel &model)
+    : QSortFilterProxyModel(parent), model(model) {
+  setRecursiveFilteringEnabled(true);
+  setSourceModel(&model);
+
+  // Added series must be searched before the proxy asks about them,
+  // so the entry is known to `matched`
+  QObject::connect(&model, &SeriesPickerModel::modelAboutToBeReset, this, [this]() {
+    matched.clear();
+    matches.clear();
+  });
+  QObject::connect(&model, &SeriesPickerModel::modelReset, this, &SeriesFilterModel::refresh);
+  QObject::connect(&model, &SeriesPickerModel::rowsAboutToBeInserted, this, [this]() {
+    const auto entry = this->model.entryCount() - 1u;
+    matched.resize(this->model.entryCount(), false);
+
+    if (!query.isEmpty() && this->model.matches(entry, query)) {
+      matched[entry] = true;
+      matches.emplace_back(entry);
+    }
+  });
+
+  refresh();
+}
+
+void SeriesFilterModel::setQuery(const QString &text) {
+  const auto folded = text.toCaseFolded();
+  if (folded == query)
+    return;
+
+  // Every name containing the longer text contains the shorter one,
+  // so only the current matches need checking
+  if (!query.isEmpty() && folded.contains(query)) {
+    query = folded;
+    matches.erase(std::remove_if(matches.begin(), matches.end(),
+                                 [this](std::size_t entry) {
+                                   if (model.matches(entry, query))
+                                     return false;
+
+                                   matched[entry] = false;
+                                   return true;
+                                 }),
+                  matches.end());
+    invalidateFilter();
+    return;
+  }
+
+  query = folded;
+  refresh();
+}
+
+} // namespace netsimulyzer
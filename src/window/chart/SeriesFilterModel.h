@@ -0,0 +1,94 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+
+#include "SeriesPickerModel.h"
+#include <QModelIndex>
+#include <QObject>
+#include <QSortFilterProxyModel>
+#include <QString>
+#include <cstddef>
+#include <vector>
+
+namespace netsimulyzer {
+
+/**
+ * Hides the series of a `SeriesPickerModel` not matching a search.
+ * Each `ChartWidget` has its own, over the shared model.
+ *
+ * Groups are kept while any of their series match
+ */
+class SeriesFilterModel : public QSortFilterProxyModel {
+  Q_OBJECT
+
+  SeriesPickerModel &model;
+
+  /**
+   * The case folded search text. Empty matches everything
+   */
+  QString query;
+
+  /**
+   * Entry index -> if that entry matches `query`
+   */
+  std::vector<bool> matched;
+
+  /**
+   * Indices of the entries in `matched`.
+   * Narrowed in place when the search text is extended
+   */
+  std::vector<std::size_t> matches;
+
+  /**
+   * Search the full model again for `query`.
+   * Used when the model's series change
+   */
+  void refresh();
+
+protected:
+  [[nodiscard]] bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+
+public:
+  SeriesFilterModel(QObject *parent, SeriesPickerModel &model);
+
+  /**
+   * Only show the series with names containing `text`, ignoring case
+   *
+   * @param text
+   * The text to search for
+   */
+  void setQuery(const QString &text);
+};
+
+} // namespace netsimulyzer
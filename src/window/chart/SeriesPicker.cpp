@@ -0,0 +1,153 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#include "SeriesPicker.h"
+#include <QCoreApplication>
+#include <QEvent>
+#include <QKeyEvent>
+#include <QVBoxLayout>
+#include <algorithm>
+
+void SeriesPicker::showPopup() {
+  if (!model)
+    return;
+
+  search->clear();
+  tree->expandAll();
+
+  popup->resize(std::max(width(), 300), 400);
+  popup->move(mapToGlobal(QPoint{0, height()}));
+  popup->show();
+  search->setFocus();
+}
+
+void SeriesPicker::pick(const QModelIndex &index) {
+  const auto id = filter->data(index, netsimulyzer::SeriesPickerModel::IdRole);
+
+  // Groups have no ID
+  if (!id.isValid())
+    return;
+
+  popup->hide();
+  setCurrentSeries(id.toUInt());
+  emit seriesPicked(currentSeries);
+}
+
+void SeriesPicker::pickFirst() {
+  using netsimulyzer::SeriesPickerModel;
+
+  // Groups are only one level deep
+  for (auto row = 0; row < filter->rowCount({}); row++) {
+    const auto index = filter->index(row, 0, {});
+    if (filter->data(index, SeriesPickerModel::IdRole).isValid()) {
+      pick(index);
+      return;
+    }
+
+    if (filter->rowCount(index) > 0) {
+      pick(filter->index(0, 0, index));
+      return;
+    }
+  }
+}
+
+bool SeriesPicker::eventFilter(QObject *watched, QEvent *event) {
+  // Let the arrow keys move from the search into the tree
+  if (watched == search && event->type() == QEvent::KeyPress) {
+    const auto key = static_cast<QKeyEvent *>(event)->key();
+    if (key == Qt::Key_Down || key == Qt::Key_Up || key == Qt::Key_PageDown || key == Qt::Key_PageUp) {
+      tree->setFocus();
+      QCoreApplication::sendEvent(tree, event);
+      return true;
+    }
+  }
+
+  return QPushButton::eventFilter(watched, event);
+}
+
+SeriesPicker::SeriesPicker(QWidget *parent)
+    : QPushButton(parent), popup(new QFrame{this, Qt::Popup}), search(new QLineEdit{popup}),
+      tree(new QTreeView{popup}) {
+  setText("Select Series");
+
+  popup->setFrameShape(QFrame::StyledPanel);
+  auto layout = new QVBoxLayout{popup};
+  layout->setContentsMargins(2, 2, 2, 2);
+  layout->setSpacing(2);
+  layout->addWidget(search);
+  layout->addWidget(tree);
+
+  search->setPlaceholderText("Search");
+  search->setClearButtonEnabled(true);
+  search->installEventFilter(this);
+
+  tree->setHeaderHidden(true);
+  tree->setUniformRowHeights(true);
+  tree->setEditTriggers(QAbstractItemView::NoEditTriggers);
+  tree->setSelectionMode(QAbstractItemView::SingleSelection);
+
+  QObject::connect(this, &QPushButton::clicked, this, &SeriesPicker::showPopup);
+  QObject::connect(search, &QLineEdit::returnPressed, this, &SeriesPicker::pickFirst);
+  QObject::connect(search, &QLineEdit::textChanged, this, [this](const QString &text) {
+    if (!filter)
+      return;
+
+    filter->setQuery(text);
+    tree->expandAll();
+  });
+  QObject::connect(tree, &QTreeView::clicked, this, &SeriesPicker::pick);
+  QObject::connect(tree, &QTreeView::activated, this, &SeriesPicker::pick);
+}
+
+void SeriesPicker::setModel(netsimulyzer::SeriesPickerModel &value) {
+  model = &value;
+  filter = new netsimulyzer::SeriesFilterModel{this, value};
+  tree->setModel(filter);
+
+  // Names may change when series are loaded
+  QObject::connect(model, &netsimulyzer::SeriesPickerModel::modelReset, this, [this]() {
+    setText(model->nameOf(currentSeries));
+  });
+
+  setText(model->nameOf(currentSeries));
+}
+
+void SeriesPicker::setCurrentSeries(unsigned int id) {
+  currentSeries = id;
+  if (model)
+    setText(model->nameOf(id));
+}
+
+unsigned int SeriesPicker::getCurrentSeries() const {
+  return currentSeries;
+}
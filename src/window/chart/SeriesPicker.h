@@ -0,0 +1,119 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+
+#include "SeriesFilterModel.h"
+#include "SeriesPickerModel.h"
+#include <QFrame>
+#include <QLineEdit>
+#include <QModelIndex>
+#include <QPushButton>
+#include <QTreeView>
+
+// Unfortunately I can't have this in the
+// visualizer namespace and use it with
+// the Qt Creator designer
+
+/**
+ * Button showing the selected series, which opens
+ * a searchable tree of every series when clicked.
+ *
+ * Only the rows in view are created, so it stays
+ * responsive with tens of thousands of series
+ */
+class SeriesPicker : public QPushButton {
+  Q_OBJECT
+
+  netsimulyzer::SeriesPickerModel *model{nullptr};
+  netsimulyzer::SeriesFilterModel *filter{nullptr};
+  unsigned int currentSeries{netsimulyzer::ChartManager::PlaceholderId};
+
+  QFrame *popup;
+  QLineEdit *search;
+  QTreeView *tree;
+
+  void showPopup();
+
+  /**
+   * Select the series at `index`, if it is not a group
+   *
+   * @param index
+   * An index of `filter`
+   */
+  void pick(const QModelIndex &index);
+
+  /**
+   * Select the first series matching the search
+   */
+  void pickFirst();
+
+protected:
+  bool eventFilter(QObject *watched, QEvent *event) override;
+
+public:
+  /**
+   * Default Qt Widget constructor
+   *
+   * @param parent
+   * The widget that contains this one
+   */
+  explicit SeriesPicker(QWidget *parent);
+
+  /**
+   * Set the series offered by the picker.
+   * Must be called before the picker is shown
+   *
+   * @param value
+   * The shared model of every series
+   */
+  void setModel(netsimulyzer::SeriesPickerModel &value);
+
+  /**
+   * Show `id` as the selected series, without emitting `seriesPicked()`
+   *
+   * @param id
+   * The ID of the series to show
+   */
+  void setCurrentSeries(unsigned int id);
+  [[nodiscard]] unsigned int getCurrentSeries() const;
+
+signals:
+  /**
+   * Emitted when a series, or the placeholder, is picked from the popup
+   *
+   * @param id
+   * The ID of the picked series
+   */
+  void seriesPicked(unsigned int id);
+};
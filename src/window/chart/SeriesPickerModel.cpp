@@ -0,0 +1,362 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#include "SeriesPickerModel.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+
+namespace {
+
+/**
+ * Pack three characters into a key for `SeriesPickerModel::trigrams`
+ */
+quint64 trigram(QChar first, QChar second, QChar third) {
+  return (static_cast<quint64>(first.unicode()) << 32u) | (static_cast<quint64>(second.unicode()) << 16u) |
+         static_cast<quint64>(third.unicode());
+}
+
+QString groupName(netsimulyzer::ChartManager::SeriesType type) {
+  switch (type) {
+  case netsimulyzer::ChartManager::SeriesType::XY:
+    return "XYSeries";
+  case netsimulyzer::ChartManager::SeriesType::CategoryValue:
+    return "CategoryValueSeries";
+  case netsimulyzer::ChartManager::SeriesType::Collection:
+    return "Collections";
+  }
+
+  return {};
+}
+
+} // namespace
+
+namespace netsimulyzer {
+
+bool SeriesPickerModel::grouped() const {
+  return sortOrder == SettingsManager::ChartDropdownSortOrder::Type;
+}
+
+bool SeriesPickerModel::before(std::size_t left, std::size_t right) const {
+  using SortOrder = SettingsManager::ChartDropdownSortOrder;
+
+  switch (sortOrder) {
+  case SortOrder::Alphabetical:
+    [[fallthrough]];
+  case SortOrder::Type: {
+    // Types are already split into groups
+    const auto comparison = entries[left].sortKey.compare(entries[right].sortKey);
+    if (comparison != 0)
+      return comparison < 0;
+  } break;
+  case SortOrder::Id:
+    return entries[left].value.id < entries[right].value.id;
+  case SortOrder::None:
+    break;
+  default:
+    std::cerr << "Unrecognised SortOrder: " << static_cast<int>(sortOrder) << '\n';
+    std::abort();
+  }
+
+  // Keep the order series were added in
+  return left < right;
+}
+
+void SeriesPickerModel::sortRows() {
+  const auto compare = [this](std::size_t left, std::size_t right) {
+    return before(left, right);
+  };
+
+  rows.clear();
+  groups.clear();
+
+  if (grouped()) {
+    for (const auto type :
+         {ChartManager::SeriesType::XY, ChartManager::SeriesType::CategoryValue, ChartManager::SeriesType::Collection}) {
+      Group group{type, {}};
+      for (std::size_t i = 0u; i < entries.size(); i++) {
+        if (entries[i].value.type == type)
+          group.members.emplace_back(i);
+      }
+
+      if (group.members.empty())
+        continue;
+
+      std::sort(group.members.begin(), group.members.end(), compare);
+      groups.emplace_back(std::move(group));
+    }
+    return;
+  }
+
+  rows.reserve(entries.size());
+  for (std::size_t i = 0u; i < entries.size(); i++)
+    rows.emplace_back(i);
+
+  std::sort(rows.begin(), rows.end(), compare);
+}
+
+void SeriesPickerModel::addEntry(const ChartManager::DropdownValue &value) {
+  const auto entry = entries.size();
+  entries.emplace_back(Entry{value, collator.sortKey(value.name), value.name.toCaseFolded()});
+  entryById[value.id] = entry;
+
+  const auto &folded = entries.back().folded;
+  for (auto i = 0; i + 2 < folded.size(); i++) {
+    auto &posting = trigrams[trigram(folded[i], folded[i + 1], folded[i + 2])];
+
+    // A name may repeat a trigram, only list the entry once
+    if (posting.empty() || posting.back() != entry)
+      posting.emplace_back(entry);
+  }
+}
+
+SeriesPickerModel::SeriesPickerModel(QObject *parent, SettingsManager::ChartDropdownSortOrder sortOrder)
+    : QAbstractItemModel(parent), sortOrder(sortOrder) {
+}
+
+void SeriesPickerModel::setSeries(const std::vector<ChartManager::DropdownValue> &values) {
+  beginResetModel();
+  entries.clear();
+  entryById.clear();
+  trigrams.clear();
+
+  entries.reserve(values.size());
+  for (const auto &value : values)
+    addEntry(value);
+
+  sortRows();
+  endResetModel();
+}
+
+void SeriesPickerModel::addSeries(const ChartManager::DropdownValue &value) {
+  addEntry(value);
+  const auto entry = entries.size() - 1u;
+  const auto compare = [this](std::size_t left, std::size_t right) {
+    return before(left, right);
+  };
+
+  if (!grouped()) {
+    const auto position = std::upper_bound(rows.begin(), rows.end(), entry, compare);
+
+    // Skip the placeholder
+    const auto row = 1 + static_cast<int>(std::distance(rows.begin(), position));
+    beginInsertRows({}, row, row);
+    rows.insert(position, entry);
+    endInsertRows();
+    return;
+  }
+
+  auto group = std::find_if(groups.begin(), groups.end(), [&value](const Group &g) {
+    return g.type == value.type;
+  });
+
+  if (group == groups.end()) {
+    // Groups are kept in type order
+    const auto position = std::find_if(groups.begin(), groups.end(), [&value](const Group &g) {
+      return static_cast<int>(g.type) > static_cast<int>(value.type);
+    });
+
+    const auto row = 1 + static_cast<int>(std::distance(groups.begin(), position));
+    beginInsertRows({}, row, row);
+    groups.insert(position, Group{value.type, {entry}});
+    endInsertRows();
+    return;
+  }
+
+  const auto groupRow = 1 + static_cast<int>(std::distance(groups.begin(), group));
+  const auto position = std::upper_bound(group->members.begin(), group->members.end(), entry, compare);
+  const auto row = static_cast<int>(std::distance(group->members.begin(), position));
+
+  beginInsertRows(index(groupRow, 0, {}), row, row);
+  group->members.insert(position, entry);
+  endInsertRows();
+}
+
+void SeriesPickerModel::setSortOrder(SettingsManager::ChartDropdownSortOrder value) {
+  if (value == sortOrder)
+    return;
+
+  beginResetModel();
+  sortOrder = value;
+  sortRows();
+  endResetModel();
+}
+
+QString SeriesPickerModel::nameOf(unsigned int id) const {
+  if (id == ChartManager::PlaceholderId)
+    return "Select Series";
+
+  const auto entry = entryById.find(id);
+  if (entry == entryById.end())
+    return {};
+
+  return entries[entry->second].value.name;
+}
+
+std::vector<std::size_t> SeriesPickerModel::search(const QString &query) const {
+  std::vector<std::size_t> result;
+
+  // Too short to use the index
+  if (query.size() < 3) {
+    for (std::size_t i = 0u; i < entries.size(); i++) {
+      if (matches(i, query))
+        result.emplace_back(i);
+    }
+    return result;
+  }
+
+  // Every match contains every trigram of `query`,
+  // so only check the entries with the least common one
+  const std::vector<std::size_t> *candidates = nullptr;
+  for (auto i = 0; i + 2 < query.size(); i++) {
+    const auto posting = trigrams.find(trigram(query[i], query[i + 1], query[i + 2]));
+    if (posting == trigrams.end())
+      return result;
+
+    if (!candidates || posting->second.size() < candidates->size())
+      candidates = &posting->second;
+  }
+
+  for (const auto entry : *candidates) {
+    if (matches(entry, query))
+      result.emplace_back(entry);
+  }
+
+  return result;
+}
+
+bool SeriesPickerModel::matches(std::size_t entry, const QString &query) const {
+  return entries[entry].folded.contains(query);
+}
+
+int SeriesPickerModel::entryAt(const QModelIndex &index) const {
+  if (!index.isValid())
+    return -1;
+
+  // Child of a group
+  if (index.internalId() != 0u) {
+    const auto type = static_cast<ChartManager::SeriesType>(index.internalId() - 1u);
+    const auto group = std::find_if(groups.begin(), groups.end(), [type](const Group &g) {
+      return g.type == type;
+    });
+    if (group == groups.end())
+      return -1;
+
+    return static_cast<int>(group->members[static_cast<std::size_t>(index.row())]);
+  }
+
+  if (index.row() == 0 || grouped())
+    return -1;
+
+  return static_cast<int>(rows[static_cast<std::size_t>(index.row() - 1)]);
+}
+
+std::size_t SeriesPickerModel::entryCount() const {
+  return entries.size();
+}
+
+QModelIndex SeriesPickerModel::index(int row, int column, const QModelIndex &parent) const {
+  if (!hasIndex(row, column, parent))
+    return {};
+
+  if (!parent.isValid())
+    return createIndex(row, column, quintptr{0u});
+
+  // Children hold the type of their group, rather than its row,
+  // so they stay valid as groups are added
+  const auto &group = groups[static_cast<std::size_t>(parent.row() - 1)];
+  return createIndex(row, column, static_cast<quintptr>(group.type) + 1u);
+}
+
+QModelIndex SeriesPickerModel::parent(const QModelIndex &child) const {
+  if (!child.isValid() || child.internalId() == 0u)
+    return {};
+
+  const auto type = static_cast<ChartManager::SeriesType>(child.internalId() - 1u);
+  const auto group = std::find_if(groups.begin(), groups.end(), [type](const Group &g) {
+    return g.type == type;
+  });
+  if (group == groups.end())
+    return {};
+
+  return createIndex(1 + static_cast<int>(std::distance(groups.begin(), group)), 0, quintptr{0u});
+}
+
+int SeriesPickerModel::rowCount(const QModelIndex &parent) const {
+  if (!parent.isValid())
+    return 1 + static_cast<int>(grouped() ? groups.size() : rows.size());
+
+  if (parent.internalId() != 0u || !grouped() || parent.row() == 0)
+    return 0;
+
+  return static_cast<int>(groups[static_cast<std::size_t>(parent.row() - 1)].members.size());
+}
+
+int SeriesPickerModel::columnCount(const QModelIndex &) const {
+  return 1;
+}
+
+QVariant SeriesPickerModel::data(const QModelIndex &index, int role) const {
+  if (!index.isValid() || (role != Qt::DisplayRole && role != IdRole))
+    return {};
+
+  const auto entry = entryAt(index);
+  if (entry >= 0) {
+    const auto &value = entries[static_cast<std::size_t>(entry)].value;
+    return role == Qt::DisplayRole ? QVariant{value.name} : QVariant{value.id};
+  }
+
+  if (index.row() == 0 && index.internalId() == 0u)
+    return role == Qt::DisplayRole ? QVariant{nameOf(ChartManager::PlaceholderId)}
+                                   : QVariant{ChartManager::PlaceholderId};
+
+  // Group
+  if (role == Qt::DisplayRole)
+    return groupName(groups[static_cast<std::size_t>(index.row() - 1)].type);
+
+  return {};
+}
+
+Qt::ItemFlags SeriesPickerModel::flags(const QModelIndex &index) const {
+  if (!index.isValid())
+    return Qt::NoItemFlags;
+
+  // Groups may be expanded, but not picked
+  if (index.internalId() == 0u && index.row() > 0 && grouped())
+    return Qt::ItemIsEnabled;
+
+  return Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+}
+
+} // namespace netsimulyzer
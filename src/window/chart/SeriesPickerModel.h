@@ -0,0 +1,218 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+
+#include "ChartManager.h"
+#include <QAbstractItemModel>
+#include <QCollator>
+#include <QCollatorSortKey>
+#include <QModelIndex>
+#include <QObject>
+#include <QString>
+#include <QVariant>
+#include <QtGlobal>
+#include <cstddef>
+#include <src/settings/SettingsManager.h>
+#include <unordered_map>
+#include <vector>
+
+namespace netsimulyzer {
+
+/**
+ * Every series a `ChartWidget` may display, shared by all of them.
+ *
+ * The first row is always the 'Select Series' placeholder.
+ * With the `Type` sort order, the remaining rows are groups
+ * for each type of series, each holding its series. Otherwise,
+ * the series are listed directly.
+ *
+ * Names are given a collation key once, when the series is added,
+ * and indexed by their three character substrings for searching.
+ */
+class SeriesPickerModel : public QAbstractItemModel {
+  Q_OBJECT
+
+public:
+  /**
+   * Role holding the ID of the series of an item.
+   * Group items have none
+   */
+  static const int IdRole = Qt::UserRole;
+
+private:
+  struct Entry {
+    ChartManager::DropdownValue value;
+    QCollatorSortKey sortKey;
+
+    /**
+     * The name, with case folded, for searching
+     */
+    QString folded;
+  };
+
+  /**
+   * A group of series of the same type, for the `Type` sort order
+   */
+  struct Group {
+    ChartManager::SeriesType type;
+
+    /**
+     * Indices into `entries`, in display order
+     */
+    std::vector<std::size_t> members;
+  };
+
+  QCollator collator;
+  SettingsManager::ChartDropdownSortOrder sortOrder;
+  std::vector<Entry> entries;
+
+  /**
+   * Series ID -> index into `entries`
+   */
+  std::unordered_map<unsigned int, std::size_t> entryById;
+
+  /**
+   * Indices into `entries`, in display order.
+   * Used by every sort order besides `Type`
+   */
+  std::vector<std::size_t> rows;
+
+  /**
+   * Used by the `Type` sort order
+   */
+  std::vector<Group> groups;
+
+  /**
+   * Three case folded characters -> indices into `entries`
+   * with names containing them, in increasing order
+   */
+  std::unordered_map<quint64, std::vector<std::size_t>> trigrams;
+
+  [[nodiscard]] bool grouped() const;
+
+  /**
+   * @param left
+   * An index into `entries`
+   *
+   * @param right
+   * An index into `entries`
+   *
+   * @return
+   * True if `left` is displayed before `right`
+   * within the same list of rows
+   */
+  [[nodiscard]] bool before(std::size_t left, std::size_t right) const;
+
+  /**
+   * Rebuild `rows` & `groups` from `entries`
+   */
+  void sortRows();
+
+  /**
+   * Append an entry for `value` & index its name
+   */
+  void addEntry(const ChartManager::DropdownValue &value);
+
+public:
+  SeriesPickerModel(QObject *parent, SettingsManager::ChartDropdownSortOrder sortOrder);
+
+  /**
+   * Replace every series in the model
+   *
+   * @param values
+   * The series to list
+   */
+  void setSeries(const std::vector<ChartManager::DropdownValue> &values);
+
+  /**
+   * Insert a single series in place, without resetting the model
+   *
+   * @param value
+   * The series to add
+   */
+  void addSeries(const ChartManager::DropdownValue &value);
+  void setSortOrder(SettingsManager::ChartDropdownSortOrder value);
+
+  /**
+   * @param id
+   * The ID of the series to name
+   *
+   * @return
+   * The name of the series identified by `id`,
+   * or the placeholder text for `PlaceholderId`
+   */
+  [[nodiscard]] QString nameOf(unsigned int id) const;
+
+  /**
+   * Find the series with names containing `query`, ignoring case
+   *
+   * @param query
+   * The case folded text to search for
+   *
+   * @return
+   * The indices of the matching entries, in increasing order
+   */
+  [[nodiscard]] std::vector<std::size_t> search(const QString &query) const;
+
+  /**
+   * @param entry
+   * An entry index
+   *
+   * @param query
+   * Case folded text
+   *
+   * @return
+   * True if the name of `entry` contains `query`
+   */
+  [[nodiscard]] bool matches(std::size_t entry, const QString &query) const;
+
+  /**
+   * @param index
+   * An index of this model
+   *
+   * @return
+   * The entry index of the series at `index`, or -1 for groups & the placeholder
+   */
+  [[nodiscard]] int entryAt(const QModelIndex &index) const;
+  [[nodiscard]] std::size_t entryCount() const;
+
+  [[nodiscard]] QModelIndex index(int row, int column, const QModelIndex &parent) const override;
+  [[nodiscard]] QModelIndex parent(const QModelIndex &child) const override;
+  [[nodiscard]] int rowCount(const QModelIndex &parent) const override;
+  [[nodiscard]] int columnCount(const QModelIndex &parent) const override;
+  [[nodiscard]] QVariant data(const QModelIndex &index, int role) const override;
+  [[nodiscard]] Qt::ItemFlags flags(const QModelIndex &index) const override;
+};
+
+} // namespace netsimulyzer
@@ -0,0 +1,226 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#include "SeriesStatistics.h"
+#include <algorithm>
+#include <cmath>
+
+namespace netsimulyzer {
+
+QString SeriesStatistics::name(SeriesStatistics::Statistic statistic) {
+  switch (statistic) {
+  case Statistic::Count:
+    return "Count";
+  case Statistic::Sum:
+    return "Sum";
+  case Statistic::Min:
+    return "Minimum";
+  case Statistic::Max:
+    return "Maximum";
+  case Statistic::Mean:
+    return "Mean";
+  case Statistic::Variance:
+    return "Variance";
+  case Statistic::Median:
+    return "Median";
+  case Statistic::Percentile95:
+    return "95th Percentile";
+  case Statistic::Percentile99:
+    return "99th Percentile";
+  }
+
+  return {};
+}
+
+SeriesStore SeriesStatistics::derive(const SeriesStore &source, SeriesStatistics::Statistic statistic,
+                                     parser::nanoseconds window) {
+  SeriesStore result;
+  SeriesStatistics statistics{window};
+
+  const auto &clears = source.clearEvents();
+  auto nextClear = clears.begin();
+
+  // The first point after the last clear
+  std::size_t begin = 0u;
+
+  for (std::size_t i = 0u; i < source.size(); i++) {
+    for (; nextClear != clears.end() && nextClear->index <= i; nextClear++) {
+      result.clear(nextClear->time);
+      begin = nextClear->index;
+    }
+
+    const auto time = source.timeAt(i);
+    statistics.seek(source, {begin, i + 1u}, time);
+    result.append(time, source.xAt(i), statistics.value(statistic));
+  }
+
+  // Clears after the last point
+  for (; nextClear != clears.end(); nextClear++)
+    result.clear(nextClear->time);
+
+  return result;
+}
+
+void SeriesStatistics::add(std::size_t index, double value) {
+  // An infinity or NaN would poison every aggregate until the next reset
+  if (!std::isfinite(value))
+    return;
+
+  n++;
+  sum += value;
+
+  // Welford's method, which stays accurate for long windows
+  const auto delta = value - mean;
+  mean += delta / static_cast<double>(n);
+  m2 += delta * (value - mean);
+
+  // A point may never be the minimum while a later, smaller one is in the window
+  while (!minimums.empty() && minimums.back().value >= value)
+    minimums.pop_back();
+  minimums.emplace_back(Extreme{index, value});
+
+  while (!maximums.empty() && maximums.back().value <= value)
+    maximums.pop_back();
+  maximums.emplace_back(Extreme{index, value});
+
+  sketch.add(value);
+}
+
+void SeriesStatistics::remove(std::size_t index, double value) {
+  // Never added, see `add()`
+  if (!std::isfinite(value))
+    return;
+
+  if (n <= 1u) {
+    reset();
+    return;
+  }
+
+  n--;
+  sum -= value;
+
+  // Undo a step of Welford's method
+  const auto previousMean = mean;
+  mean -= (value - mean) / static_cast<double>(n);
+  m2 = std::max(0.0, m2 - (value - mean) * (value - previousMean));
+
+  while (!minimums.empty() && minimums.front().index <= index)
+    minimums.pop_front();
+  while (!maximums.empty() && maximums.front().index <= index)
+    maximums.pop_front();
+
+  sketch.remove(value);
+}
+
+void SeriesStatistics::reset() {
+  n = 0u;
+  sum = 0.0;
+  mean = 0.0;
+  m2 = 0.0;
+  minimums.clear();
+  maximums.clear();
+  sketch.clear();
+}
+
+SeriesStatistics::SeriesStatistics(parser::nanoseconds window) : window(window) {
+}
+
+void SeriesStatistics::setWindow(parser::nanoseconds value) {
+  window = value;
+  reset();
+  current = {};
+}
+
+parser::nanoseconds SeriesStatistics::getWindow() const {
+  return window;
+}
+
+void SeriesStatistics::seek(const SeriesStore &data, SeriesStore::Range visible, parser::nanoseconds time) {
+  // Points may only be removed in the order they were added,
+  // so anything but moving forward starts over
+  if (time < lastTime || visible.begin < current.begin || visible.end < current.end) {
+    reset();
+
+    const auto start = window > 0LL ? data.upperBoundTime(time - window, visible) : visible.begin;
+    current = {start, start};
+  }
+  lastTime = time;
+
+  // The first point in the window
+  auto first = std::max(current.begin, visible.begin);
+  if (window > 0LL) {
+    while (first < visible.end && data.timeAt(first) <= time - window)
+      first++;
+  }
+
+  // Add first, so the removals below only touch points in the aggregates
+  for (auto i = std::max(current.end, first); i < visible.end; i++)
+    add(i, data.yAt(i));
+
+  const auto removeEnd = std::min(current.end, first);
+  for (auto i = current.begin; i < removeEnd; i++)
+    remove(i, data.yAt(i));
+
+  current = {first, visible.end};
+}
+
+double SeriesStatistics::value(SeriesStatistics::Statistic statistic) const {
+  if (n == 0u)
+    return 0.0;
+
+  switch (statistic) {
+  case Statistic::Count:
+    return static_cast<double>(n);
+  case Statistic::Sum:
+    return sum;
+  case Statistic::Min:
+    return minimums.front().value;
+  case Statistic::Max:
+    return maximums.front().value;
+  case Statistic::Mean:
+    return mean;
+  case Statistic::Variance:
+    // Population variance, as the window holds every point in it
+    return m2 / static_cast<double>(n);
+  case Statistic::Median:
+    return sketch.quantile(0.5);
+  case Statistic::Percentile95:
+    return sketch.quantile(0.95);
+  case Statistic::Percentile99:
+    return sketch.quantile(0.99);
+  }
+
+  return 0.0;
+}
+
+} // namespace netsimulyzer
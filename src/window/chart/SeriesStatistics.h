@@ -0,0 +1,190 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+
+#include "QuantileSketch.h"
+#include "SeriesStore.h"
+#include <QString>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <model.h>
+
+namespace netsimulyzer {
+
+/**
+ * Aggregates of the Y values of an XY series over a trailing time window.
+ *
+ * Points are added as they enter the window & removed as they
+ * leave it, so following playback costs O(1) amortized per point.
+ * Rewinding rebuilds the aggregates from the points in the window.
+ */
+class SeriesStatistics {
+public:
+  enum class Statistic : int { Count, Sum, Min, Max, Mean, Variance, Median, Percentile95, Percentile99 };
+
+  /**
+   * @param statistic
+   * The statistic to name
+   *
+   * @return
+   * A name for `statistic` fit to show the user
+   */
+  static QString name(Statistic statistic);
+
+  /**
+   * Build a series of `statistic` over the window ending at each point of `source`.
+   * Each point keeps the time & X value of the source point it ends at,
+   * and the clears of `source` are kept as well
+   *
+   * @param source
+   * The series to take the statistic of
+   *
+   * @param statistic
+   * The statistic used as the Y value of each point
+   *
+   * @param window
+   * The length of the window. 0 to include every point since the last clear
+   *
+   * @return
+   * A new series, with a point for each point of `source`
+   */
+  static SeriesStore derive(const SeriesStore &source, Statistic statistic, parser::nanoseconds window);
+
+private:
+  /**
+   * A candidate for the minimum/maximum of the window,
+   * once every point before it has left
+   */
+  struct Extreme {
+    std::size_t index;
+    double value;
+  };
+
+  parser::nanoseconds window;
+
+  /**
+   * The points in the aggregates
+   */
+  SeriesStore::Range current;
+
+  /**
+   * The time of the last `seek()`
+   */
+  parser::nanoseconds lastTime{0LL};
+
+  std::uint64_t n{0u};
+  double sum{0.0};
+  double mean{0.0};
+
+  /**
+   * Sum of squared differences from `mean`
+   */
+  double m2{0.0};
+
+  /**
+   * Increasing/decreasing values, for the minimum/maximum of the window
+   */
+  std::deque<Extreme> minimums;
+  std::deque<Extreme> maximums;
+  QuantileSketch sketch;
+
+  /**
+   * Add a point to the aggregates.
+   * Points with a non-finite value are skipped
+   *
+   * @param index
+   * The index of the point to add
+   *
+   * @param value
+   * The Y value of the point to add
+   */
+  void add(std::size_t index, double value);
+
+  /**
+   * Remove a point from the aggregates.
+   * Points must be removed in the order they were added
+   *
+   * @param index
+   * The index of the point to remove
+   *
+   * @param value
+   * The Y value of the point to remove
+   */
+  void remove(std::size_t index, double value);
+  void reset();
+
+public:
+  /**
+   * @param window
+   * The length of the window. 0 to include every visible point
+   */
+  explicit SeriesStatistics(parser::nanoseconds window = 0LL);
+
+  /**
+   * Change the length of the window.
+   * The aggregates are rebuilt on the next `seek()`
+   *
+   * @param value
+   * The length of the window. 0 to include every visible point
+   */
+  void setWindow(parser::nanoseconds value);
+  [[nodiscard]] parser::nanoseconds getWindow() const;
+
+  /**
+   * Update the aggregates to the points of `data` in the window ending at `time`
+   *
+   * @param data
+   * The points of the series
+   *
+   * @param visible
+   * The points of `data` shown at `time`
+   *
+   * @param time
+   * The end of the window
+   */
+  void seek(const SeriesStore &data, SeriesStore::Range visible, parser::nanoseconds time);
+
+  /**
+   * @param statistic
+   * The statistic to get
+   *
+   * @return
+   * The value of `statistic` over the window,
+   * or 0 if the window holds no points
+   */
+  [[nodiscard]] double value(Statistic statistic) const;
+};
+
+} // namespace netsimulyzer
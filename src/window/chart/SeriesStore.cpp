@@ -0,0 +1,131 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#include "SeriesStore.h"
+#include <algorithm>
+#include <iterator>
+
+namespace netsimulyzer {
+
+bool SeriesStore::Range::operator==(const SeriesStore::Range &other) const {
+  return begin == other.begin && end == other.end;
+}
+
+bool SeriesStore::Range::operator!=(const SeriesStore::Range &other) const {
+  return !(*this == other);
+}
+
+void SeriesStore::append(parser::nanoseconds eventTime, double xValue, double yValue) {
+  if (!x.empty() && xValue < x.back())
+    descents.emplace_back(x.size());
+
+  time.emplace_back(eventTime);
+  x.emplace_back(xValue);
+  y.emplace_back(yValue);
+}
+
+void SeriesStore::clear(parser::nanoseconds eventTime) {
+  clears.emplace_back(Clear{eventTime, x.size()});
+}
+
+SeriesStore::Range SeriesStore::visibleRange(parser::nanoseconds currentTime) const {
+  Range range;
+  range.end = static_cast<std::size_t>(
+      std::distance(time.begin(), std::upper_bound(time.begin(), time.end(), currentTime)));
+
+  // The last clear applied by `currentTime` hides everything before it
+  const auto clear = std::upper_bound(clears.begin(), clears.end(), currentTime,
+                                      [](parser::nanoseconds value, const Clear &c) {
+                                        return value < c.time;
+                                      });
+  if (clear != clears.begin())
+    range.begin = std::min(std::prev(clear)->index, range.end);
+
+  return range;
+}
+
+QVector<QPointF> SeriesStore::points(SeriesStore::Range range) const {
+  QVector<QPointF> result;
+  result.reserve(static_cast<int>(range.end - range.begin));
+
+  for (auto i = range.begin; i < range.end; i++)
+    result.append({x[i], y[i]});
+
+  return result;
+}
+
+std::size_t SeriesStore::lowerBoundX(double value, SeriesStore::Range range) const {
+  const auto first = std::next(x.begin(), static_cast<std::ptrdiff_t>(range.begin));
+  const auto last = std::next(x.begin(), static_cast<std::ptrdiff_t>(range.end));
+  return static_cast<std::size_t>(std::distance(x.begin(), std::lower_bound(first, last, value)));
+}
+
+std::size_t SeriesStore::upperBoundX(double value, SeriesStore::Range range) const {
+  const auto first = std::next(x.begin(), static_cast<std::ptrdiff_t>(range.begin));
+  const auto last = std::next(x.begin(), static_cast<std::ptrdiff_t>(range.end));
+  return static_cast<std::size_t>(std::distance(x.begin(), std::upper_bound(first, last, value)));
+}
+
+bool SeriesStore::isSortedX(SeriesStore::Range range) const {
+  // A descent at `range.begin` compares against a point outside of the range
+  const auto descent = std::upper_bound(descents.begin(), descents.end(), range.begin);
+  return descent == descents.end() || *descent >= range.end;
+}
+
+std::size_t SeriesStore::upperBoundTime(parser::nanoseconds value, SeriesStore::Range range) const {
+  const auto first = std::next(time.begin(), static_cast<std::ptrdiff_t>(range.begin));
+  const auto last = std::next(time.begin(), static_cast<std::ptrdiff_t>(range.end));
+  return static_cast<std::size_t>(std::distance(time.begin(), std::upper_bound(first, last, value)));
+}
+
+const std::vector<SeriesStore::Clear> &SeriesStore::clearEvents() const {
+  return clears;
+}
+
+std::size_t SeriesStore::size() const {
+  return x.size();
+}
+
+parser::nanoseconds SeriesStore::timeAt(std::size_t index) const {
+  return time[index];
+}
+
+double SeriesStore::xAt(std::size_t index) const {
+  return x[index];
+}
+
+double SeriesStore::yAt(std::size_t index) const {
+  return y[index];
+}
+
+} // namespace netsimulyzer
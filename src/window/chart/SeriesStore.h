@@ -0,0 +1,204 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+
+#include <QPointF>
+#include <QVector>
+#include <cstddef>
+#include <model.h>
+#include <vector>
+
+namespace netsimulyzer {
+
+/**
+ * Full resolution storage for every point an XY series will ever hold.
+ *
+ * Built from the series' events at load time. Each point
+ * keeps the time of the event that appended it, and clear events
+ * are recorded as the point index they take effect at, so the points
+ * shown at any simulation time are found with binary searches
+ * rather than by replaying events.
+ *
+ * Columns are stored separately, so the searches & the
+ * reductions in `SeriesDecimator` only touch the columns they need.
+ */
+class SeriesStore {
+public:
+  /**
+   * A range of point indices, [begin, end)
+   */
+  struct Range {
+    std::size_t begin{0u};
+    std::size_t end{0u};
+
+    bool operator==(const Range &other) const;
+    bool operator!=(const Range &other) const;
+  };
+
+  /**
+   * A clear event, which hides every point before `index`
+   */
+  struct Clear {
+    parser::nanoseconds time;
+    std::size_t index;
+  };
+
+private:
+
+  std::vector<parser::nanoseconds> time;
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<Clear> clears;
+
+  /**
+   * The indices of points whose X value is less than the point before it.
+   * A range with none of these may have its X values binary searched
+   */
+  std::vector<std::size_t> descents;
+
+public:
+  /**
+   * Add a point to the end of the series.
+   * Times must be appended in non-decreasing order
+   *
+   * @param eventTime
+   * The time the point is added to the series
+   *
+   * @param xValue
+   * The X coordinate of the new point
+   *
+   * @param yValue
+   * The Y coordinate of the new point
+   */
+  void append(parser::nanoseconds eventTime, double xValue, double yValue);
+
+  /**
+   * Record the series being cleared after all currently appended points.
+   * Times must be appended in non-decreasing order
+   *
+   * @param eventTime
+   * The time the series is cleared
+   */
+  void clear(parser::nanoseconds eventTime);
+
+  /**
+   * Find the points shown at `currentTime`.
+   * Those are the points appended at or before `currentTime`,
+   * following the last clear at or before `currentTime`
+   *
+   * @param currentTime
+   * The simulation time to find the points for
+   *
+   * @return
+   * The range of points shown at `currentTime`
+   */
+  [[nodiscard]] Range visibleRange(parser::nanoseconds currentTime) const;
+
+  /**
+   * Copy the points in `range` into a form QtCharts accepts
+   *
+   * @param range
+   * The points to copy
+   *
+   * @return
+   * A copy of the points in the range
+   */
+  [[nodiscard]] QVector<QPointF> points(Range range) const;
+
+  /**
+   * Find the first point in `range` with an X value not less than `value`.
+   * Only meaningful when `isSortedX(range)` is true
+   *
+   * @param value
+   * The X value to search for
+   *
+   * @param range
+   * The points to search
+   *
+   * @return
+   * The index of the found point, or `range.end` if every point is less than `value`
+   */
+  [[nodiscard]] std::size_t lowerBoundX(double value, Range range) const;
+
+  /**
+   * Find the first point in `range` with an X value greater than `value`.
+   * Only meaningful when `isSortedX(range)` is true
+   *
+   * @param value
+   * The X value to search for
+   *
+   * @param range
+   * The points to search
+   *
+   * @return
+   * The index of the found point, or `range.end` if no point is greater than `value`
+   */
+  [[nodiscard]] std::size_t upperBoundX(double value, Range range) const;
+
+  /**
+   * @param range
+   * The points to check
+   *
+   * @return
+   * True if every point in `range` has an X value not less than the point before it
+   */
+  [[nodiscard]] bool isSortedX(Range range) const;
+
+  /**
+   * Find the first point in `range` appended after `value`
+   *
+   * @param value
+   * The time to search for
+   *
+   * @param range
+   * The points to search
+   *
+   * @return
+   * The index of the found point, or `range.end` if every point was appended at or before `value`
+   */
+  [[nodiscard]] std::size_t upperBoundTime(parser::nanoseconds value, Range range) const;
+
+  /**
+   * @return
+   * Every clear event, in the order they apply
+   */
+  [[nodiscard]] const std::vector<Clear> &clearEvents() const;
+
+  [[nodiscard]] std::size_t size() const;
+  [[nodiscard]] parser::nanoseconds timeAt(std::size_t index) const;
+  [[nodiscard]] double xAt(std::size_t index) const;
+  [[nodiscard]] double yAt(std::size_t index) const;
+};
+
+} // namespace netsimulyzer
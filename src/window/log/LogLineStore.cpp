@@ -0,0 +1,121 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#include "LogLineStore.h"
+#include <cstddef>
+
+namespace netsimulyzer {
+
+void LogLineStore::append(unsigned int streamId, parser::nanoseconds time, const std::string &value) {
+  if (value.empty())
+    return;
+
+  const auto lastLine = lastLines.find(streamId);
+  auto previous = lastLine == lastLines.end() ? none : lastLine->second;
+
+  // Each newline ends a line, anything after the last one is left open.
+  // Newlines are never part of a multibyte sequence, so splitting on bytes is safe
+  std::size_t start = 0u;
+  while (start < value.size()) {
+    auto end = value.find('\n', start);
+    const auto open = end == std::string::npos;
+    if (open)
+      end = value.size();
+
+    lines.emplace_back(Line{streamId, time, text.size(), end - start, previous, open});
+    text.insert(text.end(), value.begin() + static_cast<std::ptrdiff_t>(start),
+                value.begin() + static_cast<std::ptrdiff_t>(end));
+
+    previous = lines.size() - 1u;
+    start = end + 1u;
+  }
+
+  lastLines[streamId] = previous;
+}
+
+void LogLineStore::truncate(std::size_t count) {
+  if (count >= lines.size())
+    return;
+
+  // Step each stream back to its last remaining line
+  for (auto i = lines.size(); i > count; i--) {
+    const auto &line = lines[i - 1u];
+    if (line.previous == none)
+      lastLines.erase(line.streamId);
+    else
+      lastLines[line.streamId] = line.previous;
+  }
+
+  text.resize(lines[count].offset);
+  lines.resize(count);
+}
+
+void LogLineStore::clear() {
+  text.clear();
+  lines.clear();
+  lastLines.clear();
+}
+
+std::size_t LogLineStore::size() const {
+  return lines.size();
+}
+
+const LogLineStore::Line &LogLineStore::at(std::size_t index) const {
+  return lines[index];
+}
+
+bool LogLineStore::continues(std::size_t index) const {
+  const auto previous = lines[index].previous;
+  return previous != none && lines[previous].open;
+}
+
+bool LogLineStore::continuesPrevious(std::size_t index) const {
+  return index > 0u && lines[index].previous == index - 1u && lines[index - 1u].open;
+}
+
+QString LogLineStore::lineText(std::size_t index, bool unified) const {
+  std::vector<std::size_t> chain{index};
+  while (unified ? continuesPrevious(chain.back()) : continues(chain.back()))
+    chain.emplace_back(lines[chain.back()].previous);
+
+  // Gather the bytes first, since a character may be split between appends
+  std::string bytes;
+  for (auto i = chain.rbegin(); i != chain.rend(); i++) {
+    const auto &line = lines[*i];
+    bytes.append(text.data() + line.offset, line.length);
+  }
+
+  return QString::fromStdString(bytes);
+}
+
+} // namespace netsimulyzer
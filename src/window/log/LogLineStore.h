@@ -0,0 +1,168 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+
+#include <QString>
+#include <cstddef>
+#include <limits>
+#include <model.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace netsimulyzer {
+
+/**
+ * Every line written to the scenario logs, in the order they were written.
+ *
+ * The text of all lines is kept in one UTF-8 buffer, which is only
+ * ever appended to, or cut back to an earlier length on a rewind.
+ * Text is only decoded for the lines being shown.
+ *
+ * An append without a trailing newline leaves its last line open,
+ * and the next append to the same stream continues that line.
+ * Since other streams may write in between, a continued line
+ * is stored as a chain of lines, each linked to the previous
+ * line of its stream
+ */
+class LogLineStore {
+public:
+  /**
+   * Marks a line as the first of its stream
+   */
+  static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+  struct Line {
+    unsigned int streamId;
+
+    /**
+     * The time of the event which wrote this line
+     */
+    parser::nanoseconds time;
+
+    /**
+     * The position of the text of this line in `text`, in bytes
+     */
+    std::size_t offset;
+    std::size_t length;
+
+    /**
+     * Index of the previous line of the same stream, or `none`
+     */
+    std::size_t previous;
+
+    /**
+     * Flag indicating the line was not ended with a newline,
+     * so the next line of the same stream continues it
+     */
+    bool open;
+  };
+
+private:
+  /**
+   * The UTF-8 text of every line, without newlines
+   */
+  std::vector<char> text;
+  std::vector<Line> lines;
+
+  /**
+   * Stream ID -> Index of the last line written by that stream
+   */
+  std::unordered_map<unsigned int, std::size_t> lastLines;
+
+public:
+  /**
+   * Add the lines of `value` to the store.
+   * Empty values add nothing
+   *
+   * @param streamId
+   * The ID of the stream writing `value`
+   *
+   * @param time
+   * The time `value` was written
+   *
+   * @param value
+   * The text to write, which may contain several lines
+   */
+  void append(unsigned int streamId, parser::nanoseconds time, const std::string &value);
+
+  /**
+   * Remove every line from index `count` onward
+   *
+   * @param count
+   * The number of lines to keep
+   */
+  void truncate(std::size_t count);
+
+  void clear();
+  [[nodiscard]] std::size_t size() const;
+  [[nodiscard]] const Line &at(std::size_t index) const;
+
+  /**
+   * @param index
+   * The index of the line to check
+   *
+   * @return
+   * True if the line at `index` continues the last open line of its stream
+   */
+  [[nodiscard]] bool continues(std::size_t index) const;
+
+  /**
+   * @param index
+   * The index of the line to check
+   *
+   * @return
+   * True if the line at `index` continues the line written directly before it,
+   * so the two may be shown as one in the unified log
+   */
+  [[nodiscard]] bool continuesPrevious(std::size_t index) const;
+
+  /**
+   * Get the full text of the line ending at `index`,
+   * including any lines it continues
+   *
+   * @param index
+   * The index of the last line in the chain
+   *
+   * @param unified
+   * Only follow lines written directly after each other,
+   * see `continuesPrevious()`
+   *
+   * @return
+   * The text of the line, without a newline
+   */
+  [[nodiscard]] QString lineText(std::size_t index, bool unified) const;
+};
+
+} // namespace netsimulyzer
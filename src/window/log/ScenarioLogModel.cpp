@@ -0,0 +1,213 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#include "ScenarioLogModel.h"
+#include "../../conversion.h"
+#include <QBrush>
+#include <QColor>
+#include <utility>
+
+namespace netsimulyzer {
+
+std::vector<std::size_t> &ScenarioLogModel::shownRows() {
+  if (shownStreamId == unifiedStreamId)
+    return unifiedRows;
+
+  return streams.at(shownStreamId).rows;
+}
+
+const std::vector<std::size_t> &ScenarioLogModel::shownRows() const {
+  if (shownStreamId == unifiedStreamId)
+    return unifiedRows;
+
+  return streams.at(shownStreamId).rows;
+}
+
+ScenarioLogModel::ScenarioLogModel(QObject *parent) : QAbstractListModel(parent) {
+}
+
+void ScenarioLogModel::addStream(const parser::LogStream &stream) {
+  Stream s;
+  s.name = QString::fromStdString(stream.name);
+  if (stream.color) {
+    const auto &color = *stream.color;
+    s.color = QBrush{QColor{color.red, color.green, color.blue, 255}};
+  }
+
+  streams.try_emplace(stream.id, std::move(s));
+}
+
+void ScenarioLogModel::append(unsigned int streamId, parser::nanoseconds time, const std::string &value) {
+  const auto first = store.size();
+  store.append(streamId, time, value);
+  if (store.size() == first)
+    return;
+
+  // Only the shown log needs to tell the view,
+  // so its new rows are collected & inserted at once
+  auto &shown = shownRows();
+  const auto shownSize = shown.size();
+  auto changed = false;
+  std::vector<std::size_t> added;
+
+  const auto extend = [&](std::vector<std::size_t> &rows, std::size_t line, bool continues) {
+    if (&rows != &shown) {
+      if (continues)
+        rows.back() = line;
+      else
+        rows.emplace_back(line);
+    } else if (!continues)
+      added.emplace_back(line);
+    else if (!added.empty())
+      added.back() = line;
+    else {
+      rows.back() = line;
+      changed = true;
+    }
+  };
+
+  for (auto i = first; i < store.size(); i++) {
+    extend(streams[store.at(i).streamId].rows, i, store.continues(i));
+    extend(unifiedRows, i, store.continuesPrevious(i));
+  }
+
+  if (changed) {
+    const auto row = index(static_cast<int>(shownSize) - 1);
+    emit dataChanged(row, row);
+  }
+
+  if (added.empty())
+    return;
+
+  beginInsertRows({}, static_cast<int>(shownSize), static_cast<int>(shownSize + added.size()) - 1);
+  shown.insert(shown.end(), added.begin(), added.end());
+  endInsertRows();
+}
+
+void ScenarioLogModel::truncate(std::size_t count) {
+  if (count >= store.size())
+    return;
+
+  // Rows are only removed from the end of the shown log,
+  // so count them & remove them at once
+  auto &shown = shownRows();
+  std::size_t removed = 0u;
+  auto changed = false;
+
+  const auto shorten = [&](std::vector<std::size_t> &rows, std::size_t line, bool continues) {
+    const auto previous = store.at(line).previous;
+    if (&rows != &shown) {
+      if (continues)
+        rows.back() = previous;
+      else
+        rows.pop_back();
+    } else if (continues) {
+      rows[rows.size() - 1u - removed] = previous;
+      changed = true;
+    } else
+      removed++;
+  };
+
+  for (auto i = store.size(); i > count; i--) {
+    const auto line = i - 1u;
+    shorten(streams[store.at(line).streamId].rows, line, store.continues(line));
+    shorten(unifiedRows, line, store.continuesPrevious(line));
+  }
+
+  if (removed > 0u) {
+    const auto shownSize = static_cast<int>(shown.size());
+    beginRemoveRows({}, shownSize - static_cast<int>(removed), shownSize - 1);
+    shown.resize(shown.size() - removed);
+    endRemoveRows();
+  }
+
+  if (changed && !shown.empty()) {
+    const auto row = index(static_cast<int>(shown.size()) - 1);
+    emit dataChanged(row, row);
+  }
+
+  store.truncate(count);
+}
+
+std::size_t ScenarioLogModel::lineCount() const {
+  return store.size();
+}
+
+void ScenarioLogModel::showStream(unsigned int id) {
+  if (id != unifiedStreamId && streams.find(id) == streams.end())
+    return;
+
+  beginResetModel();
+  shownStreamId = id;
+  endResetModel();
+}
+
+void ScenarioLogModel::clear() {
+  beginResetModel();
+  store.clear();
+  streams.clear();
+  unifiedRows.clear();
+  shownStreamId = unifiedStreamId;
+  endResetModel();
+}
+
+int ScenarioLogModel::rowCount(const QModelIndex &parent) const {
+  if (parent.isValid())
+    return 0;
+
+  return static_cast<int>(shownRows().size());
+}
+
+QVariant ScenarioLogModel::data(const QModelIndex &index, int role) const {
+  if (!index.isValid())
+    return {};
+
+  const auto line = shownRows()[static_cast<std::size_t>(index.row())];
+  const auto &stream = streams.at(store.at(line).streamId);
+  const auto unified = shownStreamId == unifiedStreamId;
+
+  switch (role) {
+  case Qt::DisplayRole:
+    if (unified)
+      return '[' + stream.name + "]: " + store.lineText(line, true);
+    return store.lineText(line, false);
+  case Qt::ForegroundRole:
+    return stream.color;
+  case Qt::ToolTipRole:
+    return toDisplayTime(store.at(line).time, SettingsManager::TimeUnit::Milliseconds);
+  default:
+    return {};
+  }
+}
+
+} // namespace netsimulyzer
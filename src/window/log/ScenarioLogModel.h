@@ -0,0 +1,147 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+
+#include "LogLineStore.h"
+#include <QAbstractListModel>
+#include <QModelIndex>
+#include <QObject>
+#include <QString>
+#include <QVariant>
+#include <cstddef>
+#include <model.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace netsimulyzer {
+
+/**
+ * Rows of one log at a time, either a single stream or the unified log,
+ * read from a `LogLineStore` only when a view asks for them.
+ *
+ * Every log is a list of indices into the store,
+ * each the last line of a row. Writing appends to these lists,
+ * and rewinding pops from them, so the text is never edited
+ */
+class ScenarioLogModel : public QAbstractListModel {
+  Q_OBJECT
+
+public:
+  /**
+   * ID of the unified log, which shows every stream
+   */
+  static const unsigned int unifiedStreamId = 0u;
+
+private:
+  struct Stream {
+    QString name;
+
+    /**
+     * The color of the stream's text, or invalid for the default color
+     */
+    QVariant color;
+    std::vector<std::size_t> rows;
+  };
+
+  LogLineStore store;
+  std::unordered_map<unsigned int, Stream> streams;
+  std::vector<std::size_t> unifiedRows;
+  unsigned int shownStreamId{unifiedStreamId};
+
+  /**
+   * @return
+   * The rows of the log currently shown
+   */
+  [[nodiscard]] std::vector<std::size_t> &shownRows();
+  [[nodiscard]] const std::vector<std::size_t> &shownRows() const;
+
+public:
+  explicit ScenarioLogModel(QObject *parent);
+
+  /**
+   * Add an empty log for `stream`
+   *
+   * @param stream
+   * The stream to add
+   */
+  void addStream(const parser::LogStream &stream);
+
+  /**
+   * Write `value` to the stream identified by `streamId`, and the unified log
+   *
+   * @param streamId
+   * The ID of the stream to write to. Must have been added by `addStream()`
+   *
+   * @param time
+   * The time of the write
+   *
+   * @param value
+   * The text to write
+   */
+  void append(unsigned int streamId, parser::nanoseconds time, const std::string &value);
+
+  /**
+   * Remove every line written after the first `count`
+   *
+   * @param count
+   * The number of lines to keep, from `lineCount()`
+   */
+  void truncate(std::size_t count);
+
+  /**
+   * @return
+   * The number of lines written, for `truncate()`
+   */
+  [[nodiscard]] std::size_t lineCount() const;
+
+  /**
+   * Show the log of the stream identified by `id`,
+   * or the unified log for `unifiedStreamId`
+   *
+   * @param id
+   * The ID of the stream to show
+   */
+  void showStream(unsigned int id);
+
+  /**
+   * Remove every stream & line
+   */
+  void clear();
+
+  [[nodiscard]] int rowCount(const QModelIndex &parent) const override;
+  [[nodiscard]] QVariant data(const QModelIndex &index, int role) const override;
+};
+
+} // namespace netsimulyzer
@@ -32,127 +32,62 @@
  */
 
 #include "ScenarioLogWidget.h"
-#include "../../conversion.h"
 #include "ui_ScenarioLogWidget.h"
-#include <QColor>
+#include <QAction>
+#include <QClipboard>
+#include <QGuiApplication>
+#include <QItemSelectionModel>
+#include <QKeySequence>
 #include <QString>
+#include <QStringList>
+#include <algorithm>
+#include <trace.h>
 #include <variant>
 
 namespace netsimulyzer {
 
-ScenarioLogWidget::LogStreamPair::LogStreamPair(parser::LogStream model) : model(std::move(model)) {
-  data->setDocumentLayout(new QPlainTextDocumentLayout(data.get()));
-  if (this->model.color) {
-    const auto &color = *this->model.color;
-    textFormat.setForeground(QColor{color.red, color.green, color.blue, 255});
-  }
-
-  name = QString::fromStdString(this->model.name);
-}
-
 void ScenarioLogWidget::handleEvent(const parser::StreamAppendEvent &e) {
-  const auto &iter = streams.find(e.streamId);
-  if (iter == streams.end())
+  if (streams.find(e.streamId) == streams.end())
     return;
 
   undo::StreamAppendEvent undo;
   undo.event = e;
-  undo.lastUnifiedWriter = lastUnifiedWriter;
+  undo.lineCount = model.lineCount();
 
-  auto &pair = iter->second;
-  auto value = QString::fromStdString(e.value);
-  pair.print(value);
-
-  undo.unifiedLogEraseCount = printToUnifiedLog(pair, value);
+  model.append(e.streamId, e.time, e.value);
 
   undoEvents.emplace_back(undo);
-
-  // Scroll the document to the bottom (where the cursor is now)
-  // after every append, keeping the newest info visible
-  // TODO: Should be a setting "autoscroll logs" maybe?
-  ui.plainTextLog->ensureCursorVisible();
 }
 
 void ScenarioLogWidget::handleEvent(const undo::StreamAppendEvent &e) {
-  const auto &iter = streams.find(e.event.streamId);
-  if (iter == streams.end())
+  if (streams.find(e.event.streamId) == streams.end())
     return;
 
-  auto &pair = iter->second;
-  // TODO: Maybe check this cast?
-  pair.erase(static_cast<int>(e.event.value.size()));
-
-  unifiedStreamCursor.movePosition(QTextCursor::MoveOperation::Left, QTextCursor::MoveMode::KeepAnchor,
-                                   e.unifiedLogEraseCount);
-  unifiedStreamCursor.removeSelectedText();
-  lastUnifiedWriter = e.lastUnifiedWriter;
-
+  model.truncate(e.lineCount);
   events.emplace_front(e.event);
 }
 
-int ScenarioLogWidget::printToUnifiedLog(LogStreamPair &pair, const QString &value) {
-  // File us down to single line prints
-  if (value.count('\n') > 1) {
-    auto lines = value.split('\n');
-    int accumulator = 0;
-    for (const auto &line : lines)
-      accumulator += printToUnifiedLog(pair, line + '\n');
-
-    return accumulator;
-  }
-
-  int characterTotal = 0;
-
-  const auto id = pair.getModel().id;
-  const auto &format = pair.getFormat();
-
-  if (id != lastUnifiedWriter && !unifiedStreamCursor.atBlockStart()) {
-    unifiedStreamCursor.insertText("\n", format);
-    characterTotal++;
-  }
-
-  if (unifiedStreamCursor.atBlockStart()) {
-    const QString prompt = '[' + pair.getName() + "]: ";
-    unifiedStreamCursor.insertText(prompt, format);
-    characterTotal += prompt.size();
-  }
-
-  unifiedStreamCursor.insertText(value);
-  characterTotal += value.size();
-
-  lastUnifiedWriter = id;
-
-  return characterTotal;
-}
-
 void ScenarioLogWidget::streamSelected(unsigned int id) {
-  if (id == unifiedStreamId) {
-    ui.plainTextLog->setDocument(&unifiedStreamDocument);
+  model.showStream(id);
 
-    // When changing the document, the cursor seems to get stuck
-    // at the top, so move it back to the end
-    ui.plainTextLog->moveCursor(QTextCursor::End);
-
-    // Scroll the document to the bottom (where the cursor is now)
-    ui.plainTextLog->ensureCursorVisible();
-    return;
-  }
-
-  const auto &iter = streams.find(id);
-  if (iter == streams.end())
-    return;
+  // Keep the newest lines visible
+  ui.listLog->scrollToBottom();
+}
 
-  ui.plainTextLog->setDocument(&iter->second.getData());
+void ScenarioLogWidget::copySelected() {
+  auto selected = ui.listLog->selectionModel()->selectedIndexes();
+  std::sort(selected.begin(), selected.end());
 
-  // When changing the document, the cursor seems to get stuck
-  // at the top, so move it back to the end
-  ui.plainTextLog->moveCursor(QTextCursor::End);
+  QStringList lines;
+  for (const auto &index : selected)
+    lines << index.data().toString();
 
-  // Scroll the document to the bottom (where the cursor is now)
-  ui.plainTextLog->ensureCursorVisible();
+  QGuiApplication::clipboard()->setText(lines.join('\n'));
 }
 
 void ScenarioLogWidget::timeAdvanced(parser::nanoseconds time) {
+  NETSIMULYZER_TRACE_SCOPE("ScenarioLogWidget::timeAdvanced");
+  const auto previousLineCount = model.lineCount();
   auto handle = [this, time](auto &&e) -> bool {
     if (time < e.time)
       return false;
@@ -165,6 +100,12 @@ void ScenarioLogWidget::timeAdvanced(parser::nanoseconds time) {
   while (!events.empty() && std::visit(handle, events.front())) {
     // Intentionally Blank
   }
+
+  // Scroll to the bottom after every write,
+  // keeping the newest info visible
+  // TODO: Should be a setting "autoscroll logs" maybe?
+  if (model.lineCount() != previousLineCount)
+    ui.listLog->scrollToBottom();
 }
 
 void ScenarioLogWidget::timeRewound(parser::nanoseconds time) {
@@ -186,7 +127,13 @@ void ScenarioLogWidget::timeRewound(parser::nanoseconds time) {
 
 ScenarioLogWidget::ScenarioLogWidget(QWidget *parent) : QWidget(parent) {
   ui.setupUi(this);
-  unifiedStreamDocument.setDocumentLayout(new QPlainTextDocumentLayout(&unifiedStreamDocument));
+  ui.listLog->setModel(&model);
+
+  auto copy = new QAction{"Copy", ui.listLog};
+  copy->setShortcut(QKeySequence::Copy);
+  copy->setShortcutContext(Qt::WidgetShortcut);
+  ui.listLog->addAction(copy);
+  QObject::connect(copy, &QAction::triggered, this, &ScenarioLogWidget::copySelected);
 
   reset();
 
@@ -196,7 +143,8 @@ ScenarioLogWidget::ScenarioLogWidget(QWidget *parent) : QWidget(parent) {
 }
 
 void ScenarioLogWidget::addStream(const parser::LogStream &stream) {
-  streams.try_emplace(stream.id, stream);
+  streams.insert(stream.id);
+  model.addStream(stream);
 
   if (stream.visible)
     ui.comboBoxLogName->addItem(QString::fromStdString(stream.name), stream.id);
@@ -214,11 +162,10 @@ void ScenarioLogWidget::timeChanged(parser::nanoseconds time, parser::nanosecond
 }
 
 void ScenarioLogWidget::reset() {
-  unifiedStreamDocument.clear();
-  ui.plainTextLog->setDocument(&unifiedStreamDocument);
+  model.clear();
   ui.comboBoxLogName->clear();
   streams.clear();
-  ui.comboBoxLogName->addItem("Unified Log", unifiedStreamId);
+  ui.comboBoxLogName->addItem("Unified Log", ScenarioLogModel::unifiedStreamId);
   events.clear();
   undoEvents.clear();
 }
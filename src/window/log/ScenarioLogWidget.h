@@ -33,19 +33,13 @@
 
 #pragma once
 #include "../../util/undo-events.h"
+#include "ScenarioLogModel.h"
 #include "ui_ScenarioLogWidget.h"
-#include <QColor>
 #include <QString>
-#include <QTextCharFormat>
-#include <QTextCursor>
-#include <QTextDocument>
 #include <QWidget>
 #include <deque>
-#include <memory>
 #include <model.h>
-#include <optional>
-#include <unordered_map>
-#include <utility>
+#include <unordered_set>
 #include <vector>
 
 namespace netsimulyzer {
@@ -53,65 +47,28 @@ namespace netsimulyzer {
 class ScenarioLogWidget : public QWidget {
   Q_OBJECT
   Ui::ScenarioLogWidget ui{};
-  const unsigned int unifiedStreamId = 0u;
-  QTextDocument unifiedStreamDocument{this};
-  QTextCursor unifiedStreamCursor{&unifiedStreamDocument};
 
-  class LogStreamPair {
-    parser::LogStream model;
-    std::unique_ptr<QTextDocument> data = std::make_unique<QTextDocument>();
-    std::unique_ptr<QTextCursor> cursor = std::make_unique<QTextCursor>(data.get());
-    QTextCharFormat textFormat;
-    QString name;
+  /**
+   * Every line written, shown one log at a time.
+   * Only the rows in view are read by `ui.listLog`
+   */
+  ScenarioLogModel model{this};
 
-  public:
-    explicit LogStreamPair(parser::LogStream model);
-
-    // No Copies
-    LogStreamPair(const LogStreamPair &other) = delete;
-    LogStreamPair &operator=(const LogStreamPair &other) = delete;
-
-    // Allow Moves
-    LogStreamPair(LogStreamPair &&other) noexcept = default;
-    LogStreamPair &operator=(LogStreamPair &&other) noexcept = default;
-
-    ~LogStreamPair() = default;
-
-    void print(const QString &value) const {
-      cursor->insertText(value, textFormat);
-    }
-
-    void erase(int characters) {
-      cursor->movePosition(QTextCursor::MoveOperation::Left, QTextCursor::MoveMode::KeepAnchor, characters);
-      cursor->removeSelectedText();
-    }
-
-    [[nodiscard]] QTextDocument &getData() {
-      return *data;
-    };
-
-    [[nodiscard]] const parser::LogStream &getModel() {
-      return model;
-    };
-
-    [[nodiscard]] const QString &getName() const {
-      return name;
-    }
-
-    [[nodiscard]] const QTextCharFormat &getFormat() const {
-      return textFormat;
-    }
-  };
-
-  unsigned int lastUnifiedWriter = 0u;
-  std::unordered_map<unsigned int, LogStreamPair> streams;
+  /**
+   * IDs of the streams added to `model`
+   */
+  std::unordered_set<unsigned int> streams;
   std::deque<parser::LogEvent> events;
   std::deque<undo::LogUndoEvent> undoEvents;
 
   void handleEvent(const parser::StreamAppendEvent &e);
   void handleEvent(const undo::StreamAppendEvent &e);
   void streamSelected(unsigned int id);
-  int printToUnifiedLog(LogStreamPair &pair, const QString &value);
+
+  /**
+   * Copy the text of the selected rows to the clipboard
+   */
+  void copySelected();
 
   void timeAdvanced(parser::nanoseconds time);
   void timeRewound(parser::nanoseconds time);
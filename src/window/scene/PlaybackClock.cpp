@@ -0,0 +1,90 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#include "PlaybackClock.h"
+#include <algorithm>
+#include <cmath>
+
+namespace netsimulyzer {
+
+PlaybackClock::PlaybackClock(parser::nanoseconds timeStep) : timeStep(timeStep) {
+}
+
+void PlaybackClock::start() {
+  last = clock::now();
+  remainder = 0.0;
+  busy = std::chrono::nanoseconds{0};
+  running = true;
+}
+
+void PlaybackClock::stop() {
+  running = false;
+}
+
+bool PlaybackClock::isRunning() const {
+  return running;
+}
+
+void PlaybackClock::setTimeStep(parser::nanoseconds value) {
+  timeStep = value;
+}
+
+void PlaybackClock::addBusyTime(std::chrono::nanoseconds value) {
+  if (running)
+    busy += value;
+}
+
+parser::nanoseconds PlaybackClock::advance() {
+  if (!running)
+    return 0LL;
+
+  const auto now = clock::now();
+  const auto interval = std::chrono::duration_cast<std::chrono::nanoseconds>(now - last);
+  last = now;
+
+  // Only the time spent outside of frames may be a stall,
+  // time spent catching up on events is always played back
+  const auto working = std::min(busy, interval);
+  const auto elapsed = working + std::min(interval - working, maxInterval);
+  busy = std::chrono::nanoseconds{0};
+
+  const auto exact = static_cast<double>(elapsed.count()) / static_cast<double>(referenceInterval.count()) *
+                         static_cast<double>(timeStep) +
+                     remainder;
+  const auto whole = std::trunc(exact);
+  remainder = exact - whole;
+
+  return static_cast<parser::nanoseconds>(whole);
+}
+
+} // namespace netsimulyzer
@@ -0,0 +1,131 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+
+#include <chrono>
+#include <model.h>
+
+namespace netsimulyzer {
+
+/**
+ * Converts wall clock time into simulation time,
+ * so playback runs at the same speed regardless
+ * of how often frames are drawn
+ */
+class PlaybackClock {
+public:
+  using clock = std::chrono::steady_clock;
+
+  /**
+   * The wall clock interval which advances the simulation by one time step.
+   * Matches the old fixed 60 FPS timer, so time steps play at the same speed they used to
+   */
+  static constexpr std::chrono::nanoseconds referenceInterval{1'000'000'000LL / 60LL};
+
+  /**
+   * The longest idle wall clock interval a single `advance()` will account for.
+   * Prevents a large jump after the application stalled
+   * (e.g. the window was being dragged, or the process was stopped in a debugger).
+   * Time reported with `addBusyTime()` is never clamped
+   */
+  static constexpr std::chrono::nanoseconds maxInterval{1'000'000'000LL};
+
+private:
+  clock::time_point last;
+  bool running = false;
+
+  /**
+   * Simulation time advanced per `referenceInterval` of wall clock time
+   */
+  parser::nanoseconds timeStep;
+
+  /**
+   * Partial nanoseconds not yet reported by `advance()`.
+   * Kept so small time steps do not drift
+   */
+  double remainder = 0.0;
+
+  /**
+   * Wall clock time spent drawing frames since the last `advance()`
+   */
+  std::chrono::nanoseconds busy{0};
+
+public:
+  explicit PlaybackClock(parser::nanoseconds timeStep);
+
+  /**
+   * Begin measuring wall clock time from now
+   */
+  void start();
+
+  /**
+   * Stop measuring wall clock time.
+   * `advance()` returns 0 until `start()` is called again
+   */
+  void stop();
+
+  [[nodiscard]] bool isRunning() const;
+
+  /**
+   * Sets the amount of simulation time to advance/rewind
+   * per `referenceInterval` of wall clock time.
+   * Takes effect for the time following the next `advance()`
+   *
+   * @param value
+   * The new time step. May be negative to rewind
+   */
+  void setTimeStep(parser::nanoseconds value);
+
+  /**
+   * Report wall clock time spent on playback work (e.g. handling events & drawing),
+   * so a slow frame is accounted for in full by the next `advance()`,
+   * rather than clamped like a stall
+   *
+   * @param value
+   * The time spent
+   */
+  void addBusyTime(std::chrono::nanoseconds value);
+
+  /**
+   * Calculate the amount of simulation time that passed since the
+   * last call to `advance()` or `start()`
+   *
+   * @return
+   * The simulation time passed, negative when rewinding.
+   * 0 if the clock is not running
+   */
+  parser::nanoseconds advance();
+};
+
+} // namespace netsimulyzer
@@ -43,6 +43,7 @@
 #include <QObject>
 #include <QOpenGLDebugMessage>
 #include <QOpenGLFunctions_3_3_Core>
+#include <QPainter>
 #include <QPixmap>
 #include <QSettings>
 #include <QTextStream>
@@ -57,6 +58,7 @@
 #include <iostream>
 #include <model.h>
 #include <qopengl.h>
+#include <trace.h>
 #include <vector>
 
 #ifndef NDEBUG
@@ -67,86 +69,39 @@ static void logGlDebugMessage(const QOpenGLDebugMessage &message) {
 
 namespace netsimulyzer {
 
-void SceneWidget::handleEvents() {
-  // Returns true after handling an event
-  // false otherwise
-  auto handleEvent = [this](auto &&arg) -> bool {
-    // Strip off qualifiers, etc
-    // so T holds just the type
-    // so we can more easily match it
-    using T = std::decay_t<decltype(arg)>;
-
-    // All events have a time
-    // Make sure we don't handle one in the future
-    if (arg.time > simulationTime)
-      return false;
-
-    if constexpr (std::is_same_v<T, parser::MoveEvent> || std::is_same_v<T, parser::NodeOrientationChangeEvent> ||
-                  std::is_same_v<T, parser::NodeColorChangeEvent> || std::is_same_v<T, parser::TransmitEvent> ||
-                  std::is_same_v<T, parser::TransmitEndEvent>) {
-      auto node = nodes.find(arg.nodeId);
-      if (node == nodes.end())
-        return false;
-      undoEvents.emplace_back(node->second.handle(arg));
-      return true;
-    } else if constexpr (std::is_same_v<T, parser::DecorationMoveEvent> ||
-                         std::is_same_v<T, parser::DecorationOrientationChangeEvent>) {
-      auto decoration = decorations.find(arg.decorationId);
-      if (decoration == decorations.end())
-        return false;
-      undoEvents.emplace_back(decoration->second.handle(arg));
-      return true;
-    }
-  };
+void SceneWidget::requestRender() {
+  // Already scheduled
+  if (timer.isActive())
+    return;
 
-  while (!events.empty() && std::visit(handleEvent, events.front())) {
-    events.pop_front();
+  auto delay = 0LL;
+  if (frameRateLimit > 0 && frameTimer.isValid()) {
+    const auto frameInterval = 1000LL / frameRateLimit;
+    delay = std::max(0LL, frameInterval - frameTimer.elapsed());
   }
-}
-
-void SceneWidget::handleUndoEvents() {
-
-  auto handleUndoEvent = [this](auto &&arg) -> bool {
-    // Strip off qualifiers, etc
-    // so T holds just the type
-    // so we can more easily match it
-    using T = std::decay_t<decltype(arg)>;
-
-    // All events have a time
-    // Make sure we don't handle one
-    // Before it was originally applied
-    if (simulationTime > arg.event.time)
-      return false;
 
-    if constexpr (std::is_same_v<T, undo::MoveEvent> || std::is_same_v<T, undo::NodeOrientationChangeEvent> ||
-                  std::is_same_v<T, undo::TransmitEvent> || std::is_same_v<T, undo::TransmitEndEvent> ||
-                  std::is_same_v<T, undo::NodeColorChangeEvent>) {
-      auto node = nodes.find(arg.event.nodeId);
-      if (node == nodes.end())
-        return false;
-      node->second.handle(arg);
-
-      events.emplace_front(arg.event);
-      return true;
-    }
-
-    if constexpr (std::is_same_v<T, undo::DecorationMoveEvent> ||
-                  std::is_same_v<T, undo::DecorationOrientationChangeEvent>) {
-      auto decoration = decorations.find(arg.event.decorationId);
-      if (decoration == decorations.end())
-        return false;
-      decoration->second.handle(arg);
-
-      events.emplace_front(arg.event);
-      return true;
-    }
+  timer.start(static_cast<int>(delay));
+}
 
-    return false;
-  };
+void SceneWidget::paintPassTimings() {
+  const auto &passTimer = scene.getPassTimer();
 
-  while (!undoEvents.empty() && std::visit(handleUndoEvent, undoEvents.back())) {
-    undoEvents.pop_back();
+  QString text;
+  QTextStream stream{&text};
+  stream.setRealNumberNotation(QTextStream::FixedNotation);
+  stream.setRealNumberPrecision(3);
+  for (auto pass = 0u; pass < PassTimer::passCount; pass++) {
+    const auto p = static_cast<PassTimer::Pass>(pass);
+    stream << PassTimer::name(p) << ": " << passTimer.average(p) << " ms\n";
   }
+  stream << "Total: " << passTimer.total() << " ms";
+  stream.flush();
+
+  QPainter painter{this};
+  const auto bounds = painter.boundingRect(QRect{10, 10, width(), height()}, Qt::AlignLeft | Qt::AlignTop, text);
+  painter.fillRect(bounds.adjusted(-5, -5, 5, 5), QColor{0, 0, 0, 160});
+  painter.setPen(Qt::white);
+  painter.drawText(bounds, Qt::AlignLeft | Qt::AlignTop, text);
 }
 
 void SceneWidget::initializeGL() {
@@ -169,138 +124,56 @@ void SceneWidget::initializeGL() {
     std::clog << "Failed to initialize OpenGL debug log\n";
 #endif
 
-  if (!textures.init()) {
-    std::cerr << "Failed Initializing Texture Cache\n";
-    std::abort();
-  }
-
-  models.init("models/fallback.obj");
-  renderer.init();
-
-  transmissionSphere = std::make_unique<Model>(models.load("models/transmission_sphere.obj"));
-
-  TextureCache::CubeMap cubeMap;
-  cubeMap.right = QImage{":/texture/resources/textures/skybox/right.png"};
-  cubeMap.left = QImage{":/texture/resources/textures/skybox/left.png"};
-  cubeMap.top = QImage{":/texture/resources/textures/skybox/top.png"};
-  cubeMap.bottom = QImage{":/texture/resources/textures/skybox/bottom.png"};
-  cubeMap.back = QImage{":/texture/resources/textures/skybox/back.png"};
-  cubeMap.front = QImage{":/texture/resources/textures/skybox/front.png"};
-  skyBox = std::make_unique<SkyBox>(textures.load(cubeMap));
-
-  floor = std::make_unique<Floor>(renderer.allocateFloor(100.0f));
-  floor->setPosition({0.0f, -0.5f, 0.0f});
-
-  coordinateGrid = std::make_unique<CoordinateGrid>(
-      renderer.allocateCoordinateGrid(100.0f, settings.get<int>(SettingsManager::Key::RenderGridStep).value()));
-  coordinateGrid->setHeight(-0.1f);
+  scene.initialize();
+  scene.getPassTimer().setEnabled(renderPassTimings);
 
   auto s = size();
   glViewport(0, 0, s.width(), s.height());
 
-  mainLight.ambientIntensity = 0.9f;
-  mainLight.color = {1.0f, 1.0f, 1.0f};
-  mainLight.direction = {-2.0f, -1.0f, -2.0f};
-  mainLight.diffuseIntensity = 0.5f;
-  renderer.render(mainLight);
-
-  glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
-  glEnable(GL_DEPTH_TEST);
-
   updatePerspective();
 
-  // Cheap hack to get Qt to repaint at a reasonable rate
-  // Seems to only work with the old connect syntax
-  QObject::connect(&timer, SIGNAL(timeout()), this, SLOT(update()));
-  timer.start(1000 / 60); // roughly 60 times per second
-
   frameTimer.start();
 }
 
 void SceneWidget::paintGL() {
+  NETSIMULYZER_TRACE_SCOPE("SceneWidget::paintGL");
+  const auto frameStart = PlaybackClock::clock::now();
+
+  // Always move to the wall clock's time, and apply every event up to it.
+  // A busy interval makes for a long frame, dropping frames rather than slowing playback,
+  // and the time spent is reported to the clock, so it is played back in full
   if (playMode == PlayMode::Play) {
-    if (timeStep > 0LL)
-      handleEvents();
-    else
-      handleUndoEvents();
+    const auto increment = playbackClock.advance();
+    if (increment != 0LL) {
+      scene.setTime(scene.getTime() + increment);
+      if (increment > 0LL)
+        scene.handleEvents();
+      else
+        scene.handleUndoEvents();
+
+      emit timeChanged(scene.getTime(), increment);
+    }
   }
 
-  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); // NOLINT(hicpp-signed-bitwise)
   camera.move(static_cast<float>(frameTimer.elapsed()));
-  renderer.use(camera);
-  if (renderSkybox)
-    renderer.render(*skyBox);
-
-  for (auto &[key, node] : nodes) {
-    if (!node.visible())
-      continue;
-    renderer.render(node.getModel());
-    if (renderMotionTrails)
-      renderer.renderTrail(node.getTrailBuffer(), node.getTrailColor());
-  }
-
-  for (auto &[key, decoration] : decorations) {
-    renderer.render(decoration.getModel());
-  }
-  renderer.render(*floor);
-
-  renderer.render(areas);
-
-  if (buildingRenderMode == SettingsManager::BuildingRenderMode::Opaque)
-    renderer.render(buildings);
-  // else in the transparent section
-
-  if (renderBuildingOutlines) {
-    // Black outlines for opaque buildings
-    // White for transparent
-    if (buildingRenderMode == SettingsManager::BuildingRenderMode::Opaque)
-      renderer.renderOutlines(buildings, glm::vec3{0.0f, 0.0f, 0.0f});
-    else
-      renderer.renderOutlines(buildings, glm::vec3{1.0f, 1.0f, 1.0f});
-  }
+  scene.render(camera);
+  if (renderPassTimings)
+    paintPassTimings();
+  frameTimer.restart();
 
-  renderer.render(wiredLinks);
-
-  // Keep this next to `startTransparent()`
-  // has it's own transparency implementation
-  if (renderGrid)
-    renderer.render(*coordinateGrid);
-  // Keep this after all opaque items
-  renderer.startTransparent();
-
-  // Other condition in opaque section
-  if (buildingRenderMode == SettingsManager::BuildingRenderMode::Transparent)
-    renderer.render(buildings);
-
-  for (const auto &[_, node] : nodes) {
-    const auto &nodeModel = node.getModel();
-    renderer.renderTransparent(nodeModel);
-
-    const auto &transmit = node.getTransmitInfo();
-    if (transmit.isTransmitting && transmit.startTime <= simulationTime &&
-        transmit.startTime + transmit.duration >= simulationTime) {
-      const auto delta = static_cast<double>(simulationTime - transmit.startTime) /
-                         static_cast<double>(transmit.duration) * transmit.targetSize;
-      transmissionSphere->setPosition(nodeModel.getPosition());
-      transmissionSphere->setTargetHeightScale(static_cast<float>(delta));
-      transmissionSphere->setBaseColor(transmit.color);
-      renderer.render(*transmissionSphere, Renderer::LightingMode::LightingDisabled);
-    }
-  }
+  const auto frameTime = PlaybackClock::clock::now() - frameStart;
+  playbackClock.addBusyTime(std::chrono::duration_cast<std::chrono::nanoseconds>(frameTime));
 
-  for (auto &[key, decoration] : decorations) {
-    renderer.renderTransparent(decoration.getModel());
-  }
-  renderer.endTransparent();
-  frameTimer.restart();
+  // Keep drawing while the scene changes on its own
+  if (playMode == PlayMode::Play || camera.isMoving())
+    requestRender();
 
   if (playMode == PlayMode::Paused)
     return;
 
-  simulationTime += timeStep;
-  emit timeChanged(simulationTime, timeStep);
-
-  const auto pastEnd = timeStep > 0LL && simulationTime >= config.endTime;
+  const auto simulationTime = scene.getTime();
+  const auto endTime = scene.getConfiguration().endTime;
+  const auto pastEnd = timeStep > 0LL && simulationTime >= endTime;
   const auto pastBeginning = timeStep < 0LL && simulationTime < 0LL;
   if ((pastEnd || pastBeginning) && playMode == PlayMode::Play) {
     pause();
@@ -309,7 +182,7 @@ void SceneWidget::paintGL() {
     // Useful if the increment does not match up with
     // the end time
     if (pastEnd)
-      setTime(config.endTime);
+      setTime(endTime);
     else
       setTime(0LL);
   }
@@ -322,7 +195,15 @@ void SceneWidget::resizeGL(int w, int h) {
 
 void SceneWidget::keyPressEvent(QKeyEvent *event) {
   QWidget::keyPressEvent(event);
+  const auto wasMoving = camera.isMoving();
   camera.handle_keypress(event->key());
+
+  if (!wasMoving && camera.isMoving()) {
+    // The last frame may have been a long time ago,
+    // don't let the camera jump by that much
+    frameTimer.restart();
+    requestRender();
+  }
 }
 
 void SceneWidget::keyReleaseEvent(QKeyEvent *event) {
@@ -384,6 +265,7 @@ void SceneWidget::mouseMoveEvent(QMouseEvent *event) {
   auto dy = lastCursorPosition.y() - event->y();
 
   camera.mouse_move(dx, dy);
+  requestRender();
 
   lastCursorPosition = widgetCenter;
   QCursor::setPos(mapToGlobal(widgetCenter));
@@ -407,6 +289,11 @@ SceneWidget::SceneWidget(QWidget *parent, const Qt::WindowFlags &f) : QOpenGLWid
   // Make sure we get keyboard events
   setFocusPolicy(Qt::StrongFocus);
 
+  // Frames are only drawn when requested, see `requestRender()`
+  // Seems to only work with the old connect syntax
+  timer.setSingleShot(true);
+  QObject::connect(&timer, SIGNAL(timeout()), this, SLOT(update()));
+
   auto resourceDirSetting = settings.get<QString>(SettingsManager::Key::ResourcePath);
 
   // Shouldn't happen, but just in case
@@ -431,89 +318,37 @@ SceneWidget::~SceneWidget() {
 }
 
 void SceneWidget::setConfiguration(parser::GlobalConfiguration configuration) {
-  config = configuration;
-
-  // Resize ground plane to the farthest away item/event
-  auto newSize = std::max({std::abs(config.minLocation.x), std::abs(config.maxLocation.x),
-                           std::abs(config.minLocation.y), std::abs(config.maxLocation.y)});
-
-  // Don't resize beneath the default
-  if (newSize > 100.0f) {
-    renderer.resize(*floor, newSize + 50.0f); // Give the new size a bit of extra overrun
-    renderer.resize(*coordinateGrid, newSize + 50.0f, settings.get<int>(SettingsManager::Key::RenderGridStep).value());
-  }
+  makeCurrent();
+  scene.setConfiguration(configuration);
+  doneCurrent();
 
   // time step handled by the MainWindow
+  requestRender();
 }
 
 void SceneWidget::reset() {
-  areas.clear();
-  buildings.clear();
-  nodes.clear();
-  decorations.clear();
-  wiredLinks.clear();
-  events.clear();
-  undoEvents.clear();
-  simulationTime = 0.0;
+  // The scene owns OpenGL buffers,
+  // so they must be freed with our context
+  makeCurrent();
+  scene.reset();
+  doneCurrent();
+
+  requestRender();
 }
 
 void SceneWidget::add(const std::vector<parser::Area> &areaModels, const std::vector<parser::Building> &buildingModels,
                       const std::vector<parser::Decoration> &decorationModels,
                       const std::vector<parser::WiredLink> &links, const std::vector<parser::Node> &nodeModels) {
-
   // We need a current context for the initial construction of most models
   makeCurrent();
-
-  areas.reserve(areaModels.size());
-  for (const auto &area : areaModels) {
-    areas.emplace_back(renderer.allocate(area), area);
-  }
-
-  buildings.reserve(buildingModels.size());
-  for (const auto &building : buildingModels) {
-    buildings.emplace_back(renderer.allocate(building), building);
-  }
-
-  decorations.reserve(decorationModels.size());
-  for (const auto &decoration : decorationModels) {
-    decorations.try_emplace(decoration.id, Model{models.load(decoration.model)}, decoration);
-  }
-
-  nodes.reserve(nodeModels.size());
-  const auto functions = context()->versionFunctions<QOpenGLFunctions_3_3_Core>();
-  const auto trailLength = settings.get<int>(SettingsManager::Key::RenderMotionTrailLength).value();
-  for (const auto &node : nodeModels) {
-    nodes.try_emplace(node.id, Model{models.load(node.model)}, node,
-                      renderer.allocateTrailBuffer(functions, trailLength));
-  }
-
-  wiredLinks.reserve(links.size());
-  for (const auto &link : links) {
-    auto &newLink = wiredLinks.emplace_back(renderer.allocate(link), link);
-
-    // Flag to ignore links with non-configured nodes
-    // should be picked up by the ns-3 module, but just in case
-    bool ignoreLink = false;
-    for (const auto nodeId : link.nodes) {
-      const auto &node = nodes.find(nodeId);
-
-      if (node == nodes.end()) {
-        std::cerr << "A wired link references an unknown Node with ID: " << nodeId << " ignoring link\n";
-        ignoreLink = true;
-        continue;
-      }
-
-      node->second.addWiredLink(&newLink);
-    }
-
-    if (ignoreLink)
-      wiredLinks.erase(wiredLinks.end() - 1);
-  }
-
+  scene.add(areaModels, buildingModels, decorationModels, links, nodeModels);
   doneCurrent();
+
+  requestRender();
 }
 
 void SceneWidget::focusNode(uint32_t nodeId) {
+  const auto &nodes = scene.getNodes();
   auto iter = nodes.find(nodeId);
   if (iter == nodes.end()) {
     std::cerr << "Error: Node with ID: " << nodeId << " not found\n";
@@ -536,15 +371,17 @@ void SceneWidget::focusNode(uint32_t nodeId) {
 
   camera.setPosition(position);
   camera.resetRotation();
+  requestRender();
 }
 
 void SceneWidget::enqueueEvents(const std::vector<parser::SceneEvent> &e) {
-  events.insert(events.end(), e.begin(), e.end());
+  scene.enqueueEvents(e);
 }
 
 void SceneWidget::resetCamera() {
   camera.setPosition({0.0f, 0.0f, 0.0f});
   camera.resetRotation();
+  requestRender();
 }
 
 Camera &SceneWidget::getCamera() {
@@ -552,43 +389,45 @@ Camera &SceneWidget::getCamera() {
 }
 
 void SceneWidget::updatePerspective() {
-  renderer.setPerspective(glm::perspective(glm::radians(camera.getFieldOfView()),
-                                           static_cast<float>(width()) / static_cast<float>(height()), 0.1f, 1000.0f));
+  scene.setPerspective(camera.getFieldOfView(), width(), height());
+  requestRender();
 }
 
 void SceneWidget::setResourcePath(const QString &value) {
-  textures.setResourceDirectory(QDir{value});
-  models.setBasePath(value.toStdString());
+  scene.setResourcePath(value);
 }
 
 void SceneWidget::play() {
   playMode = PlayMode::Play;
+  playbackClock.start();
 
   emit playing();
+  requestRender();
 }
 
 void SceneWidget::pause() {
   playMode = PlayMode::Paused;
+  playbackClock.stop();
 
   emit paused();
 }
 
 void SceneWidget::setTime(parser::nanoseconds value) {
-  const auto oldTime = simulationTime;
-
-  simulationTime = value;
-  const auto diff = simulationTime - oldTime;
+  const auto diff = value - scene.getTime();
+  scene.setTime(value);
 
   if (diff > 0LL)
-    handleEvents();
+    scene.handleEvents();
   else
-    handleUndoEvents();
+    scene.handleUndoEvents();
 
-  emit timeChanged(simulationTime, diff);
+  emit timeChanged(value, diff);
+  requestRender();
 }
 
 void SceneWidget::setTimeStep(parser::nanoseconds value) {
   timeStep = value;
+  playbackClock.setTimeStep(value);
 }
 
 QSize SceneWidget::sizeHint() const {
@@ -596,29 +435,53 @@ QSize SceneWidget::sizeHint() const {
 }
 
 void SceneWidget::setSkyboxRenderState(bool enable) {
-  renderSkybox = enable;
+  scene.setSkyboxRenderState(enable);
+  requestRender();
 }
 
 void SceneWidget::setBuildingRenderMode(SettingsManager::BuildingRenderMode mode) {
-  buildingRenderMode = mode;
+  scene.setBuildingRenderMode(mode);
+  requestRender();
 }
 
 void SceneWidget::setBuildingRenderOutlines(bool enable) {
-  renderBuildingOutlines = enable;
+  scene.setBuildingRenderOutlines(enable);
+  requestRender();
 }
 
 void SceneWidget::setRenderGrid(bool enable) {
-  renderGrid = enable;
+  scene.setRenderGrid(enable);
+  requestRender();
 }
 void SceneWidget::changeGridStepSize(int stepSize) {
   makeCurrent();
-  // Keep the same square size, but change the grid step
-  renderer.resize(*coordinateGrid, coordinateGrid->getRenderInfo().squareSize, stepSize);
+  scene.changeGridStepSize(stepSize);
   doneCurrent();
+  requestRender();
 }
 
 void SceneWidget::setRenderTrails(bool enable) {
-  renderMotionTrails = enable;
+  scene.setRenderTrails(enable);
+  requestRender();
+}
+
+void SceneWidget::setFrameRateLimit(int limit) {
+  frameRateLimit = limit;
+}
+
+void SceneWidget::setRenderPassTimings(bool enable) {
+  renderPassTimings = enable;
+
+  // Not yet initialized, picked up in `initializeGL()`
+  if (!isValid())
+    return;
+
+  scene.getPassTimer().setEnabled(enable);
+  requestRender();
+}
+
+const PassTimer &SceneWidget::getPassTimer() {
+  return scene.getPassTimer();
 }
 
 } // namespace netsimulyzer
@@ -33,24 +33,10 @@
 
 #pragma once
 
-#include "../../group/area/Area.h"
-#include "../../group/building/Building.h"
-#include "../../group/decoration/Decoration.h"
-#include "../../group/node/Node.h"
-#include "../../render/Light.h"
 #include "../../render/camera/Camera.h"
-#include "../../render/helper/Floor.h"
-#include "../../render/mesh/Mesh.h"
-#include "../../render/model/Model.h"
-#include "../../render/model/ModelCache.h"
-#include "../../render/renderer/Renderer.h"
-#include "../../render/shader/Shader.h"
-#include "../../render/texture/TextureCache.h"
+#include "../../scene/Scene.h"
 #include "../../settings/SettingsManager.h"
-#include "../../util/undo-events.h"
-#include "src/group/link/WiredLink.h"
-#include "src/render/helper/CoordinateGrid.h"
-#include "src/render/helper/SkyBox.h"
+#include "PlaybackClock.h"
 #include <QApplication>
 #include <QElapsedTimer>
 #include <QFile>
@@ -83,51 +69,61 @@ class SceneWidget : public QOpenGLWidget, protected QOpenGLFunctions_3_3_Core {
   QPoint lastCursorPosition{width() / 2, height() / 2};
   bool mousePressed = false;
   bool isInitialMove = true;
-  TextureCache textures;
-  ModelCache models{textures};
-  Renderer renderer{models, textures};
+  /**
+   * Single shot timer for the next requested frame,
+   * see `requestRender()`
+   */
   QTimer timer{this};
   QElapsedTimer frameTimer;
-  bool renderSkybox = settings.get<bool>(SettingsManager::Key::RenderSkybox).value();
-  bool renderGrid = settings.get<bool>(SettingsManager::Key::RenderGrid).value();
-  bool renderBuildingOutlines = settings.get<bool>(SettingsManager::Key::RenderBuildingOutlines).value();
-  bool renderMotionTrails = settings.get<bool>(SettingsManager::Key::RenderMotionTrails).value();
 
-  DirectionalLight mainLight;
-  std::unique_ptr<SkyBox> skyBox;
-  std::unique_ptr<Floor> floor;
-  std::unique_ptr<CoordinateGrid> coordinateGrid;
-  SettingsManager::BuildingRenderMode buildingRenderMode =
-      settings.get<SettingsManager::BuildingRenderMode>(SettingsManager::Key::RenderBuildingMode).value();
-  std::unique_ptr<Model> transmissionSphere;
+  /**
+   * Maximum number of frames to render per second.
+   * 0 for no limit
+   */
+  int frameRateLimit = settings.get<int>(SettingsManager::Key::RenderFrameRateLimit).value();
+
+  /**
+   * Show the GPU time for each render pass over the scene
+   */
+  bool renderPassTimings = settings.get<bool>(SettingsManager::Key::RenderPassTimings).value();
 
-  parser::GlobalConfiguration config;
+  /**
+   * The models, events, etc. being displayed
+   */
+  Scene scene;
 
   /**
-   * Amount of time to advance/rewind `simulationTime`
-   * per frame.
+   * Amount of time to advance/rewind the scene's time
+   * per `PlaybackClock::referenceInterval` of wall clock time.
    */
   parser::nanoseconds timeStep =
       settings.get<parser::nanoseconds>(SettingsManager::Key::PlaybackTimeStepPreference).value();
 
-  parser::nanoseconds simulationTime;
-
-  std::vector<Area> areas;
-  std::vector<Building> buildings;
-  std::unordered_map<unsigned int, Node> nodes;
-  std::unordered_map<unsigned int, Decoration> decorations;
-  std::vector<WiredLink> wiredLinks;
+  /**
+   * Advances the scene's time by the wall clock time between frames,
+   * so slow frames do not slow down playback
+   */
+  PlaybackClock playbackClock{timeStep};
 
   PlayMode playMode = PlayMode::Paused;
-  std::deque<parser::SceneEvent> events;
-  std::deque<undo::SceneUndoEvent> undoEvents;
+
 
 #ifndef NDEBUG
   QOpenGLDebugLogger glLogger{this};
 #endif
 
-  void handleEvents();
-  void handleUndoEvents();
+  /**
+   * Schedule a repaint, no sooner than `frameRateLimit` allows.
+   * The scene is only repainted when something changes,
+   * so anything that changes what is displayed should call this.
+   * Multiple requests before the next frame are merged.
+   */
+  void requestRender();
+
+  /**
+   * Draw the averages from the scene's `PassTimer` over the scene
+   */
+  void paintPassTimings();
 
 protected:
   void initializeGL() override;
@@ -238,6 +234,33 @@ public:
    */
   void setRenderTrails(bool enable);
 
+  /**
+   * Change the maximum number of frames rendered per second
+   *
+   * @param limit
+   * The maximum frames per second, 0 for no limit
+   */
+  void setFrameRateLimit(int limit);
+
+  /**
+   * Enable or disable timing each render pass,
+   * and showing those times over the scene
+   *
+   * @param enable
+   * True to time & show each pass, false to stop
+   */
+  void setRenderPassTimings(bool enable);
+
+  /**
+   * Gets the GPU time spent on each pass of the last several frames.
+   * Only updated while enabled with `setRenderPassTimings()`.
+   * The widget must be initialized (i.e. shown) first
+   *
+   * @return
+   * The scene's pass timings
+   */
+  [[nodiscard]] const PassTimer &getPassTimer();
+
 signals:
   void timeChanged(parser::nanoseconds simulationTime, parser::nanoseconds increment);
   void paused();
@@ -40,6 +40,11 @@ void SettingsDialog::loadSettings() {
       settings.get<SettingsManager::ChartDropdownSortOrder>(Key::ChartDropdownSortOrder).value();
   ui.comboSortOrder->setCurrentIndex(ui.comboSortOrder->findData(static_cast<int>(chartDropdownSortOrder)));
 
+  const auto chartDecimation = settings.get<SettingsManager::ChartDecimation>(Key::ChartDecimation).value();
+  ui.comboDecimation->setCurrentIndex(ui.comboDecimation->findData(static_cast<int>(chartDecimation)));
+  ui.checkBoxOpenGLChart->setChecked(settings.get<bool>(Key::ChartOpenGLView).value());
+  ui.spinStatisticsWindow->setValue(settings.get<int>(Key::ChartStatisticsWindow).value());
+
   ui.checkBoxBuildingOutlines->setChecked(settings.get<bool>(Key::RenderBuildingOutlines).value());
 
   ui.comboGridSize->setCurrentIndex(ui.comboGridSize->findData(settings.get<int>(Key::RenderGridStep).value()));
@@ -63,6 +68,8 @@ void SettingsDialog::loadSettings() {
 
   ui.checkBoxShowTrails->setChecked(settings.get<bool>(Key::RenderMotionTrails).value());
   ui.sliderTrailLength->setValue(settings.get<int>(Key::RenderMotionTrailLength).value());
+  ui.spinFrameRateLimit->setValue(settings.get<int>(Key::RenderFrameRateLimit).value());
+  ui.checkBoxPassTimings->setChecked(settings.get<bool>(Key::RenderPassTimings).value());
 
   ui.keyPlay->setKeySequence(*settings.get<int>(Key::SceneKeyPlay));
 
@@ -86,6 +93,10 @@ SettingsDialog::SettingsDialog(QWidget *parent) : QDialog(parent) {
   ui.comboSortOrder->addItem("Id", static_cast<int>(SortOrder::Id));
   ui.comboSortOrder->addItem("None", static_cast<int>(SortOrder::None));
 
+  using Decimation = SettingsManager::ChartDecimation;
+  ui.comboDecimation->addItem("Min/Max", static_cast<int>(Decimation::MinMax));
+  ui.comboDecimation->addItem("Largest Triangle", static_cast<int>(Decimation::LargestTriangleThreeBuckets));
+
   ui.comboGridSize->addItem("1", 1);
   ui.comboGridSize->addItem("5", 5);
   ui.comboGridSize->addItem("10", 10);
@@ -128,6 +139,10 @@ SettingsDialog::SettingsDialog(QWidget *parent) : QDialog(parent) {
   QObject::connect(ui.buttonResetDown, &QPushButton::clicked, ui.keyDown, &SingleKeySequenceEdit::setDefault);
 
   QObject::connect(ui.buttonResetSortOrder, &QPushButton::clicked, this, &SettingsDialog::defaultChartSortOrder);
+  QObject::connect(ui.buttonResetDecimation, &QPushButton::clicked, this, &SettingsDialog::defaultChartDecimation);
+  QObject::connect(ui.buttonResetOpenGLChart, &QPushButton::clicked, this, &SettingsDialog::defaultChartOpenGLView);
+  QObject::connect(ui.buttonResetStatisticsWindow, &QPushButton::clicked, this,
+                   &SettingsDialog::defaultChartStatisticsWindow);
 
   QObject::connect(ui.buttonResetSkybox, &QPushButton::clicked, this, &SettingsDialog::defaultEnableSkybox);
   QObject::connect(ui.buttonResetSamples, &QPushButton::clicked, this, &SettingsDialog::defaultSamples);
@@ -138,6 +153,8 @@ SettingsDialog::SettingsDialog(QWidget *parent) : QDialog(parent) {
   QObject::connect(ui.buttonResetGridSize, &QPushButton::clicked, this, &SettingsDialog::defaultGridStep);
   QObject::connect(ui.buttonResetTrails, &QPushButton::clicked, this, &SettingsDialog::defaultShowTrails);
   QObject::connect(ui.buttonResetTrailLength, &QPushButton::clicked, this, &SettingsDialog::defaultTrailsLength);
+  QObject::connect(ui.buttonResetFrameRateLimit, &QPushButton::clicked, this, &SettingsDialog::defaultFrameRateLimit);
+  QObject::connect(ui.buttonResetPassTimings, &QPushButton::clicked, this, &SettingsDialog::defaultPassTimings);
 
   QObject::connect(ui.buttonResetPlay, &QPushButton::clicked, ui.keyPlay, &SingleKeySequenceEdit::setDefault);
   QObject::connect(ui.buttonResetTimeStep, &QPushButton::clicked, this, &SettingsDialog::defaultTimeStep);
@@ -185,6 +202,9 @@ void SettingsDialog::dialogueButtonClicked(QAbstractButton *button) {
     ui.buttonResetDown->click();
 
     ui.buttonResetSortOrder->click();
+    ui.buttonResetDecimation->click();
+    ui.buttonResetOpenGLChart->click();
+    ui.buttonResetStatisticsWindow->click();
 
     ui.buttonResetSkybox->click();
     ui.buttonResetSamples->click();
@@ -194,6 +214,8 @@ void SettingsDialog::dialogueButtonClicked(QAbstractButton *button) {
     ui.buttonResetGridSize->click();
     ui.buttonResetTrails->click();
     ui.buttonResetTrailLength->click();
+    ui.buttonResetFrameRateLimit->click();
+    ui.buttonResetPassTimings->click();
 
     ui.buttonResetPlay->click();
     ui.buttonResetTimeStep->click();
@@ -274,6 +296,24 @@ void SettingsDialog::dialogueButtonClicked(QAbstractButton *button) {
       emit chartSortOrderChanged(static_cast<int>(chartSortOrder));
     }
 
+    const auto chartDecimation = SettingsManager::ChartDecimationFromInt(ui.comboDecimation->currentData().toInt());
+    if (chartDecimation != settings.get<SettingsManager::ChartDecimation>(Key::ChartDecimation).value()) {
+      settings.set(Key::ChartDecimation, chartDecimation);
+      emit chartDecimationChanged(static_cast<int>(chartDecimation));
+    }
+
+    const auto chartOpenGLView = ui.checkBoxOpenGLChart->isChecked();
+    if (chartOpenGLView != settings.get<bool>(Key::ChartOpenGLView)) {
+      settings.set(Key::ChartOpenGLView, chartOpenGLView);
+      emit chartOpenGLViewChanged(chartOpenGLView);
+    }
+
+    const auto chartStatisticsWindow = ui.spinStatisticsWindow->value();
+    if (chartStatisticsWindow != settings.get<int>(Key::ChartStatisticsWindow)) {
+      settings.set(Key::ChartStatisticsWindow, chartStatisticsWindow);
+      emit chartStatisticsWindowChanged(chartStatisticsWindow);
+    }
+
     // Graphics
 
     const auto samples = ui.comboSamples->currentData().toInt();
@@ -324,6 +364,18 @@ void SettingsDialog::dialogueButtonClicked(QAbstractButton *button) {
       requiresRestart = true;
     }
 
+    const auto frameRateLimit = ui.spinFrameRateLimit->value();
+    if (frameRateLimit != settings.get<int>(Key::RenderFrameRateLimit).value()) {
+      settings.set(Key::RenderFrameRateLimit, frameRateLimit);
+      emit frameRateLimitChanged(frameRateLimit);
+    }
+
+    const auto showPassTimings = ui.checkBoxPassTimings->isChecked();
+    if (showPassTimings != settings.get<bool>(Key::RenderPassTimings)) {
+      settings.set(Key::RenderPassTimings, showPassTimings);
+      emit renderPassTimingsChanged(showPassTimings);
+    }
+
     // Playback
 
     const auto playKey = ui.keyPlay->keySequence()[0];
@@ -399,6 +451,20 @@ void SettingsDialog::defaultChartSortOrder() {
   ui.comboSortOrder->setCurrentIndex(ui.comboSortOrder->findData(defaultValue));
 }
 
+void SettingsDialog::defaultChartDecimation() {
+  const auto defaultValue =
+      static_cast<int>(settings.getDefault<SettingsManager::ChartDecimation>(SettingsManager::Key::ChartDecimation));
+  ui.comboDecimation->setCurrentIndex(ui.comboDecimation->findData(defaultValue));
+}
+
+void SettingsDialog::defaultChartOpenGLView() {
+  ui.checkBoxOpenGLChart->setChecked(settings.getDefault<bool>(SettingsManager::Key::ChartOpenGLView));
+}
+
+void SettingsDialog::defaultChartStatisticsWindow() {
+  ui.spinStatisticsWindow->setValue(settings.getDefault<int>(SettingsManager::Key::ChartStatisticsWindow));
+}
+
 void SettingsDialog::defaultSamples() {
   ui.comboSamples->setCurrentIndex(
       ui.comboSamples->findData(settings.getDefault<int>(SettingsManager::Key::NumberSamples)));
@@ -437,6 +503,14 @@ void SettingsDialog::defaultTrailsLength() {
   ui.sliderTrailLength->setValue(settings.getDefault<int>(SettingsManager::Key::RenderMotionTrailLength));
 }
 
+void SettingsDialog::defaultFrameRateLimit() {
+  ui.spinFrameRateLimit->setValue(settings.getDefault<int>(SettingsManager::Key::RenderFrameRateLimit));
+}
+
+void SettingsDialog::defaultPassTimings() {
+  ui.checkBoxPassTimings->setChecked(settings.getDefault<bool>(SettingsManager::Key::RenderPassTimings));
+}
+
 void SettingsDialog::defaultGridStep() {
   const auto step = settings.getDefault<int>(SettingsManager::Key::RenderGridStep);
   ui.comboGridSize->setCurrentIndex(ui.comboGridSize->findData(step));
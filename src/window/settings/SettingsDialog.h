@@ -111,6 +111,21 @@ class SettingsDialog : public QDialog {
    */
   void defaultChartSortOrder();
 
+  /**
+   * Set the Chart Decimation input to the default value
+   */
+  void defaultChartDecimation();
+
+  /**
+   * Set the OpenGL Chart View checkbox to the default value
+   */
+  void defaultChartOpenGLView();
+
+  /**
+   * Set the Statistics Window input to the default value
+   */
+  void defaultChartStatisticsWindow();
+
   /**
    * Set the Samples input to the default value
    */
@@ -156,6 +171,17 @@ class SettingsDialog : public QDialog {
    */
   void defaultTrailsLength();
 
+  /**
+   * Sets the Frame Rate Limit
+   * spinner to the default value
+   */
+  void defaultFrameRateLimit();
+
+  /**
+   * Set the Pass Timings checkbox to the default value
+   */
+  void defaultPassTimings();
+
   /**
    * Sets the grid step size spinner to its default value
    */
@@ -293,6 +319,35 @@ signals:
    */
   void chartSortOrderChanged(int value);
 
+  /**
+   * Signal emitted when the user changes the Chart decimation method.
+   *
+   * @param value
+   * A value from `SettingsManager::ChartDecimation` converted to
+   * an `int` for messaging.
+   *
+   * @see SettingsManager::ChartDecimationFromInt
+   */
+  void chartDecimationChanged(int value);
+
+  /**
+   * Signal emitted when the user switches charts
+   * between the QtCharts and OpenGL views
+   *
+   * @param enable
+   * True if charts should be drawn with the OpenGL view
+   */
+  void chartOpenGLViewChanged(bool enable);
+
+  /**
+   * Signal emitted when the user changes the length
+   * of the window chart statistics are taken over
+   *
+   * @param milliseconds
+   * The new window length, 0 for every point in the series
+   */
+  void chartStatisticsWindowChanged(int milliseconds);
+
   /**
    * Signal emitted when the user changes the
    * Skybox render state
@@ -347,6 +402,24 @@ signals:
    */
   void renderTrailsChanged(bool enable);
 
+  /**
+   * Signal emitted when the user changes the
+   * maximum number of frames rendered per second
+   *
+   * @param limit
+   * The maximum frames per second, 0 for no limit
+   */
+  void frameRateLimitChanged(int limit);
+
+  /**
+   * Signal emitted when the user changes if the
+   * GPU time for each render pass should be shown
+   *
+   * @param enable
+   * True to show the timings, false to hide them
+   */
+  void renderPassTimingsChanged(bool enable);
+
   /**
    * Signal emitted when the user saves a new Play/Pause Key
    *
@@ -0,0 +1,189 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#include "trace.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Event {
+  const char *name;
+  std::int64_t timestamp;
+  std::int64_t duration;
+};
+
+/**
+ * Events from a single thread.
+ * Only written by the owning thread
+ */
+struct ThreadBuffer {
+  std::vector<Event> events = std::vector<Event>(trace::threadCapacity);
+
+  /**
+   * Total number of events ever recorded,
+   * the next event goes to `head % threadCapacity`
+   */
+  std::atomic<std::uint64_t> head{0u};
+
+  /**
+   * Set while the owning thread may be writing to `events`
+   */
+  std::atomic<bool> writing{false};
+  std::uint64_t threadId;
+
+  explicit ThreadBuffer(std::uint64_t threadId) : threadId(threadId) {
+  }
+};
+
+// Only locked when a thread records its first event, or for `writeChromeTrace()`
+std::mutex registryMutex;
+
+// Shared so the events of threads which have exited are kept
+std::vector<std::shared_ptr<ThreadBuffer>> registry;
+
+/**
+ * Events before this time were recorded before the last `setEnabled(true)`
+ */
+std::atomic<std::int64_t> recordingStart{0};
+
+ThreadBuffer &localBuffer() {
+  thread_local std::shared_ptr<ThreadBuffer> buffer = [] {
+    std::lock_guard lock{registryMutex};
+    auto created = std::make_shared<ThreadBuffer>(registry.size() + 1u);
+    registry.emplace_back(created);
+    return created;
+  }();
+
+  return *buffer;
+}
+
+void writeEscaped(std::ostream &out, const char *value) {
+  for (; *value != '\0'; value++) {
+    if (*value == '"' || *value == '\\')
+      out << '\\';
+    out << *value;
+  }
+}
+
+} // namespace
+
+namespace trace {
+
+namespace detail {
+
+std::atomic<bool> enabled{false};
+
+std::int64_t now() {
+  static const auto epoch = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+void record(const char *name, std::int64_t timestamp, std::int64_t duration) {
+  auto &buffer = localBuffer();
+
+  // Pairs with `writeChromeTrace()`, which clears `enabled` then waits for `writing` to clear.
+  // Either it sees this write in progress, or we see recording has stopped
+  buffer.writing.store(true);
+  if (!enabled.load()) {
+    buffer.writing.store(false, std::memory_order_release);
+    return;
+  }
+
+  const auto head = buffer.head.load(std::memory_order_relaxed);
+  buffer.events[head % threadCapacity] = {name, timestamp, duration};
+  buffer.head.store(head + 1u, std::memory_order_release);
+  buffer.writing.store(false, std::memory_order_release);
+}
+
+} // namespace detail
+
+void setEnabled(bool enable) {
+  if (enable)
+    recordingStart = detail::now();
+
+  detail::enabled = enable;
+}
+
+bool writeChromeTrace(const std::string &path) {
+  setEnabled(false);
+
+  std::ofstream out{path, std::ios::trunc};
+  if (!out) {
+    std::cerr << "Failed to open trace file: " << path << '\n';
+    return false;
+  }
+
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  out << std::fixed << std::setprecision(3);
+  bool first = true;
+
+  std::lock_guard lock{registryMutex};
+  for (const auto &buffer : registry) {
+    // A thread which checked `enabled` just before we disabled it may still be writing.
+    // Any thread starting a write after this sees recording has stopped
+    while (buffer->writing.load())
+      std::this_thread::yield();
+
+    const auto head = buffer->head.load(std::memory_order_acquire);
+    const auto count = std::min<std::uint64_t>(head, threadCapacity);
+
+    for (auto i = head - count; i < head; i++) {
+      const auto &event = buffer->events[i % threadCapacity];
+      if (event.timestamp < recordingStart)
+        continue;
+
+      if (!first)
+        out << ',';
+      first = false;
+
+      out << "{\"name\":\"";
+      writeEscaped(out, event.name);
+      out << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+          << ",\"ts\":" << static_cast<double>(event.timestamp) / 1000.0
+          << ",\"dur\":" << static_cast<double>(event.duration) / 1000.0 << '}';
+    }
+  }
+
+  out << "]}\n";
+  return static_cast<bool>(out);
+}
+
+} // namespace trace
@@ -0,0 +1,135 @@
+/*
+ * NIST-developed software is provided by NIST as a public service. You may use,
+ * copy and distribute copies of the software in any medium, provided that you
+ * keep intact this entire notice. You may improve,modify and create derivative
+ * works of the software or any portion of the software, and you may copy and
+ * distribute such modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and nature of
+ * any such change. Please explicitly acknowledge the National Institute of
+ * Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT
+ * AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR WARRANTS THAT THE
+ * OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE, OR THAT
+ * ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT WARRANT OR MAKE ANY
+ * REPRESENTATIONS REGARDING THE USE OF THE SOFTWARE OR THE RESULTS THEREOF,
+ * INCLUDING BUT NOT LIMITED TO THE CORRECTNESS, ACCURACY, RELIABILITY,
+ * OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ *
+ * Author: Evan Black <evan.black@nist.gov>
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/**
+ * Lightweight CPU tracing.
+ *
+ * Each thread records into its own fixed size ring of events,
+ * so recording takes no locks. Once a ring is full, the oldest events are overwritten.
+ * The recorded events may be written in the Chrome trace event format,
+ * viewable in `chrome://tracing` or https://ui.perfetto.dev
+ *
+ * While disabled, recording is a single relaxed atomic load
+ */
+namespace trace {
+
+/**
+ * Maximum number of events kept per thread
+ */
+constexpr std::size_t threadCapacity = 65536u;
+
+namespace detail {
+
+extern std::atomic<bool> enabled;
+
+/**
+ * Nanoseconds since tracing was first used
+ */
+std::int64_t now();
+
+void record(const char *name, std::int64_t timestamp, std::int64_t duration);
+
+} // namespace detail
+
+/**
+ * Check if events are being recorded
+ */
+inline bool isEnabled() {
+  return detail::enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * Start or stop recording events.
+ * Enabling clears any previously recorded events
+ *
+ * @param enable
+ * True to begin recording, false to stop
+ */
+void setEnabled(bool enable);
+
+/**
+ * Records the time between its construction & destruction
+ */
+class Scope {
+  const char *name;
+  std::int64_t start = -1;
+
+public:
+  /**
+   * @param name
+   * The name of the span, must be a string literal (or otherwise live forever)
+   */
+  explicit Scope(const char *name) : name(name) {
+    if (isEnabled())
+      start = detail::now();
+  }
+
+  ~Scope() {
+    // Also skip spans that were started before recording was enabled
+    if (start >= 0 && isEnabled())
+      detail::record(name, start, detail::now() - start);
+  }
+
+  Scope(const Scope &) = delete;
+  Scope &operator=(const Scope &) = delete;
+};
+
+/**
+ * Write every recorded event as Chrome trace event JSON.
+ * Stops recording first, and waits for any event being recorded to finish
+ *
+ * @param path
+ * The file to write, overwritten if it exists
+ *
+ * @return
+ * False if the file could not be written
+ */
+bool writeChromeTrace(const std::string &path);
+
+} // namespace trace
+
+#define NETSIMULYZER_TRACE_CONCAT_IMPL(a, b) a##b
+#define NETSIMULYZER_TRACE_CONCAT(a, b) NETSIMULYZER_TRACE_CONCAT_IMPL(a, b)
+
+/**
+ * Record the time spent in the enclosing scope
+ *
+ * @param name
+ * The name of the span, must be a string literal
+ */
+#define NETSIMULYZER_TRACE_SCOPE(name) ::trace::Scope NETSIMULYZER_TRACE_CONCAT(traceScope, __LINE__) { name }